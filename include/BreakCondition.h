@@ -0,0 +1,107 @@
+#ifndef BREAK_CONDITION_H
+#define BREAK_CONDITION_H
+
+#include "DebuggerTypes.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * BreakCondition - Breakpoint condition compiled once to stack bytecode
+ *
+ * Expressions are parsed when set and turned into a flat instruction list;
+ * evaluation is a single switch loop over a fixed-size local stack, with no
+ * allocation and no string handling, so conditions on hot loops stay cheap.
+ *
+ * Expression syntax:
+ * - Numbers: decimal, 0x1F or $1F; bare hex like FF40 also works unless
+ *   it spells a register name (use $CF, not CF, for the number)
+ * - Registers: A F B C D E H L AF BC DE HL SP PC, flags ZF NF HF CF,
+ *   CYCLE, IME (names are case-insensitive)
+ * - Memory: [expr] reads the byte at expr
+ * - Operators, loosest to tightest binding:
+ *     ||   &&   == != < <= > >=   & | ^   + -   unary ! - ~
+ *   Bitwise operators bind tighter than comparisons, so
+ *   "[FF40] & 0x80 == 0" means "([FF40] & 0x80) == 0".
+ *
+ * Usage:
+ *   BreakCondition condition;
+ *   std::string error;
+ *   if (condition.Compile("A == 0x3C && [HL] > 5", error)) {
+ *       bool stop = condition.Evaluate(cpuState, memory);
+ *   }
+ */
+class BreakCondition {
+public:
+    /// Deepest operand stack an expression may need
+    static constexpr int MAX_STACK = 32;
+
+    BreakCondition() = default;
+
+    /**
+     * Parse and compile an expression
+     * On failure the previous condition is kept and error describes why.
+     * @return true if the expression compiled
+     */
+    bool Compile(const std::string& source, std::string& error);
+
+    /**
+     * Evaluate against CPU state and a 64KB memory view
+     * @param memory Flat 64KB memory, or nullptr (memory reads give 0)
+     * @return true if the expression is non-zero (an empty condition is true)
+     */
+    bool Evaluate(const CPUState& cpu, const uint8_t* memory) const;
+
+    /**
+     * Get the expression text this condition was compiled from
+     */
+    const std::string& GetSource() const { return source_; }
+
+    /**
+     * Check whether no expression is set
+     */
+    bool IsEmpty() const { return code_.empty(); }
+
+    /**
+     * Get the number of bytecode instructions
+     */
+    size_t GetCodeSize() const { return code_.size(); }
+
+private:
+    friend class BreakConditionParser;
+
+    enum class Op : uint8_t {
+        PushConst,      // push operand
+        PushRegister,   // push register number operand
+        LoadByte,       // pop address, push memory byte
+        Negate, LogicalNot, BitNot,
+        Add, Sub, BitAnd, BitOr, BitXor,
+        Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual,
+        ToBool,         // top = (top != 0)
+        JumpIfFalse,    // top == 0: jump to operand, keep 0; else pop
+        JumpIfTrue      // top != 0: jump to operand, keep it; else pop
+    };
+
+    /// Register numbers for Op::PushRegister
+    enum Register : uint8_t {
+        REG_A, REG_F, REG_B, REG_C, REG_D, REG_E, REG_H, REG_L,
+        REG_AF, REG_BC, REG_DE, REG_HL, REG_SP, REG_PC,
+        REG_ZF, REG_NF, REG_HF, REG_CF, REG_CYCLE, REG_IME
+    };
+
+    struct Instruction {
+        Op op;
+        int64_t operand;
+    };
+
+    static int64_t ReadRegister(const CPUState& cpu, int64_t reg);
+
+    std::vector<Instruction> code_;
+    std::string source_;
+};
+
+} // namespace GBDebug
+
+#endif // BREAK_CONDITION_H
@@ -0,0 +1,183 @@
+#ifndef BREAKPOINT_MANAGER_H
+#define BREAKPOINT_MANAGER_H
+
+#include "BreakCondition.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * Breakpoint - A single PC breakpoint entry
+ *
+ * Addresses in the switchable ROM area ($4000-$7FFF) can be restricted to
+ * one ROM bank; everywhere else the bank is ignored. An optional compiled
+ * condition must also hold for the breakpoint to fire. The condition is
+ * shared and immutable, so copying entries never copies bytecode.
+ */
+struct Breakpoint {
+    static constexpr int ANY_BANK = -1;
+    static constexpr int MAX_BANK = 511;    // Highest MBC5 ROM bank
+
+    uint16_t address;
+    int bank;            // ROM bank for $4000-$7FFF, or ANY_BANK
+    bool enabled;
+    uint32_t hitCount;
+    std::shared_ptr<const BreakCondition> condition;   // nullptr = unconditional
+
+    Breakpoint() : address(0), bank(ANY_BANK), enabled(true), hitCount(0) {}
+    Breakpoint(uint16_t address_, int bank_)
+        : address(address_), bank(bank_), enabled(true), hitCount(0) {}
+};
+
+/**
+ * BreakpointManager - PC breakpoint storage with a constant-time hot path
+ *
+ * Every enabled breakpoint sets its address in a 65536-bit "maybe" bitmap.
+ * The per-instruction check is one load and one bit test of that bitmap;
+ * only addresses with a bit set go on to the exact check, which consults
+ * the any-bank bitmap and the per-ROM-bank bitmaps.
+ *
+ * The bitmap words are atomics so the emulator thread may check while the
+ * UI thread edits; edits and the exact check are serialized by a mutex.
+ * Conditions are evaluated in the exact check only, so a conditional
+ * breakpoint costs nothing at addresses other than its own.
+ *
+ * Usage:
+ *   BreakpointManager breakpoints;
+ *   breakpoints.Add(0x0150);
+ *   breakpoints.Add(0x4100, 3);           // only in ROM bank 3
+ *   breakpoints.SetCondition(0, "A == 0x3C", error);
+ *   if (breakpoints.MayBreak(pc) && breakpoints.Check(pc, bank, &cpu, memory)) { stop }
+ */
+class BreakpointManager {
+public:
+    BreakpointManager();
+
+    static constexpr size_t HOT_WORDS = 65536 / 64;
+
+    /**
+     * Hot path: could there be a breakpoint at this address?
+     * A false result is final; true needs confirmation with Check().
+     */
+    bool MayBreak(uint16_t pc) const {
+        return ((hotBits_[pc >> 6].load(std::memory_order_relaxed) >> (pc & 63)) & 1) != 0;
+    }
+
+    /**
+     * Exact check for an address MayBreak() flagged; counts the hit
+     * @param pc Address about to execute
+     * @param bank ROM bank currently mapped at $4000-$7FFF
+     * @param cpu CPU state for conditions (nullptr = conditional entries never fire)
+     * @param memory 64KB memory view for conditions, may be nullptr
+     * @return true if an enabled breakpoint matches and its condition holds
+     */
+    bool Check(uint16_t pc, int bank, const CPUState* cpu = nullptr, const uint8_t* memory = nullptr);
+
+    /**
+     * Add a breakpoint (no-op if an identical one exists)
+     * @param bank ROM bank 0-MAX_BANK, or ANY_BANK
+     * @return true if a new entry was added, false if it exists or the bank is invalid
+     */
+    bool Add(uint16_t address, int bank = Breakpoint::ANY_BANK);
+
+    /**
+     * Remove a breakpoint
+     * @return true if an entry was removed
+     */
+    bool Remove(uint16_t address, int bank = Breakpoint::ANY_BANK);
+
+    /**
+     * Find the list index of a breakpoint
+     * @return Index, or -1 if there is no such breakpoint
+     */
+    int Find(uint16_t address, int bank = Breakpoint::ANY_BANK) const;
+
+    /**
+     * Compile and attach a condition to the entry at a list index
+     * An empty expression removes the condition.
+     * @param error Receives the parse error on failure
+     * @return true if the condition compiled (or was cleared)
+     */
+    bool SetCondition(size_t index, const std::string& expression, std::string& error);
+
+    /**
+     * Enable or disable the entry at a list index
+     */
+    void SetEnabled(size_t index, bool enabled);
+
+    /**
+     * Remove the entry at a list index
+     */
+    void RemoveAt(size_t index);
+
+    /**
+     * Remove all breakpoints
+     */
+    void Clear();
+
+    /**
+     * Copy the current entries into out (reuses out's capacity)
+     */
+    void CopyBreakpoints(std::vector<Breakpoint>& out) const;
+
+    /**
+     * Get the address of the most recent hit
+     * @return false if nothing has been hit yet
+     */
+    bool GetLastHit(uint16_t& address, int& bank) const;
+
+    /**
+     * Get the word array MayBreak() reads, for callers that inline the test
+     */
+    const std::atomic<uint64_t>* GetHotBits() const { return hotBits_.data(); }
+
+private:
+    static constexpr uint16_t BANKED_START = 0x4000;
+    static constexpr uint16_t BANKED_END = 0x7FFF;
+    static constexpr size_t BANK_SIZE = 0x4000;
+
+    static bool IsBanked(uint16_t address) {
+        return address >= BANKED_START && address <= BANKED_END;
+    }
+
+    static bool IsValidBank(int bank) {
+        return bank >= Breakpoint::ANY_BANK && bank <= Breakpoint::MAX_BANK;
+    }
+
+    /**
+     * Normalize the bank for an address: outside the banked area it is ignored
+     */
+    static int EffectiveBank(uint16_t address, int bank) {
+        return IsBanked(address) ? bank : Breakpoint::ANY_BANK;
+    }
+
+    /**
+     * Recompute all bitmaps from entries_ (mutex must be held)
+     */
+    void RebuildBitmaps();
+
+    std::array<std::atomic<uint64_t>, HOT_WORDS> hotBits_;
+    std::bitset<65536> anyBankBits_;
+    std::vector<std::bitset<BANK_SIZE>> bankBits_;   // Indexed by ROM bank
+
+    std::vector<Breakpoint> entries_;
+    bool hasLastHit_;
+    uint16_t lastHitAddress_;
+    int lastHitBank_;
+    mutable std::mutex mutex_;
+
+    BreakpointManager(const BreakpointManager&) = delete;
+    BreakpointManager& operator=(const BreakpointManager&) = delete;
+};
+
+} // namespace GBDebug
+
+#endif // BREAKPOINT_MANAGER_H
@@ -66,6 +66,12 @@ public:
      */
     void EndFrame();
     
+    /**
+     * Enable or disable waiting for vsync in EndFrame()
+     * May be called before or after Initialize()
+     */
+    void SetVSync(bool enabled);
+    
     /**
      * Check if window close was requested
      */
@@ -86,6 +92,7 @@ private:
     SDL_GLContext gl_context_;
     bool initialized_;
     bool should_close_;
+    bool vsync_;
     
     // Disable copy
     DebuggerBackend(const DebuggerBackend&) = delete;
@@ -2,6 +2,7 @@
 #define DEBUGGER_TYPES_H
 
 #include <cstdint>
+#include <cstddef>
 #include <array>
 
 namespace GBDebug {
@@ -65,6 +66,39 @@ struct MemoryState {
     }
 };
 
+/**
+ * WriteRecord - A single memory write captured by the emulator
+ * 
+ * Emulators can log writes as they execute and hand the whole batch to
+ * GBDebugger::ApplyWriteLog() instead of re-sending all 64KB each frame.
+ */
+struct WriteRecord {
+    uint16_t address;
+    uint8_t value;
+};
+
+/**
+ * ScanlineRegisters - LCD registers as they were while one scanline was drawn
+ * 
+ * Emulators that change scroll, window or palette registers mid-frame
+ * (raster effects) record these per line with
+ * GBDebugger::RecordScanlineRegisters(). Fields are in address order.
+ */
+struct ScanlineRegisters {
+    uint8_t lcdc;    // $FF40
+    uint8_t stat;    // $FF41
+    uint8_t scy;     // $FF42
+    uint8_t scx;     // $FF43
+    uint8_t bgp;     // $FF47
+    uint8_t obp0;    // $FF48
+    uint8_t obp1;    // $FF49
+    uint8_t wy;      // $FF4A
+    uint8_t wx;      // $FF4B
+    
+    ScanlineRegisters()
+        : lcdc(0), stat(0), scy(0), scx(0), bgp(0), obp0(0), obp1(0), wy(0), wx(0) {}
+};
+
 /**
  * Color - RGBA color for UI rendering
  * 
@@ -127,7 +161,7 @@ struct IORegister {
  * GameBoy I/O register ranges (based on Pan Docs)
  * https://gbdev.io/pandocs/Memory_Map.html#io-ranges
  */
-static const IORegister IO_REGISTERS[] = {
+static constexpr IORegister IO_REGISTERS[] = {
     {"P1/JOYP",     0xFF00, 0xFF00, "Joypad input"},
     {"SB",          0xFF01, 0xFF01, "Serial transfer data"},
     {"SC",          0xFF02, 0xFF02, "Serial transfer control"},
@@ -190,7 +224,77 @@ static const IORegister IO_REGISTERS[] = {
     {"PCM34",       0xFF77, 0xFF77, "CGB: Audio digital out 3&4"},
 };
 
-static const size_t IO_REGISTERS_COUNT = sizeof(IO_REGISTERS) / sizeof(IO_REGISTERS[0]);
+static constexpr size_t IO_REGISTERS_COUNT = sizeof(IO_REGISTERS) / sizeof(IO_REGISTERS[0]);
+
+/**
+ * Compile-time linear search used to build IO_REGISTER_LOOKUP
+ * @return Index into IO_REGISTERS, or -1 if the address is unmapped
+ */
+constexpr int FindIORegisterIndex(uint16_t address, size_t i = 0) {
+    return i >= IO_REGISTERS_COUNT ? -1
+         : (address >= IO_REGISTERS[i].start && address <= IO_REGISTERS[i].end) ? static_cast<int>(i)
+         : FindIORegisterIndex(address, i + 1);
+}
+
+/**
+ * Compile-time count of registers starting below an address
+ * (IO_REGISTERS is sorted by address, so this is an index boundary)
+ */
+constexpr size_t CountIORegistersBefore(uint16_t address, size_t i = 0) {
+    return (i < IO_REGISTERS_COUNT && IO_REGISTERS[i].start < address)
+         ? CountIORegistersBefore(address, i + 1) : i;
+}
+
+/**
+ * IORegisterLookup - $FF00-$FF7F address to IO_REGISTERS index table
+ * 
+ * One entry per I/O address; -1 marks unmapped addresses. Built at compile
+ * time from IO_REGISTERS so lookups are a single array read.
+ */
+struct IORegisterLookup {
+    int8_t index[128];
+};
+
+namespace detail {
+
+// Minimal C++11 stand-in for std::index_sequence
+template <size_t... I> struct IndexList {};
+template <size_t N, size_t... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template <size_t... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+template <size_t... I>
+constexpr IORegisterLookup BuildIORegisterLookup(IndexList<I...>) {
+    return IORegisterLookup{{ static_cast<int8_t>(FindIORegisterIndex(static_cast<uint16_t>(0xFF00 + I)))... }};
+}
+
+} // namespace detail
+
+static constexpr IORegisterLookup IO_REGISTER_LOOKUP =
+    detail::BuildIORegisterLookup(detail::MakeIndexList<128>::type());
+
+/**
+ * IORegisterRange - Contiguous slice of IO_REGISTERS [first, end)
+ * 
+ * Used to iterate one category of registers without rescanning the table.
+ */
+struct IORegisterRange {
+    size_t first;
+    size_t end;
+};
+
+/**
+ * Build the range of registers whose start address lies in [low, high]
+ */
+constexpr IORegisterRange MakeIORegisterRange(uint16_t low, uint16_t high) {
+    return IORegisterRange{CountIORegistersBefore(low), CountIORegistersBefore(static_cast<uint16_t>(high + 1))};
+}
+
+// Pre-bucketed register categories
+static constexpr IORegisterRange IO_RANGE_GENERAL = MakeIORegisterRange(0xFF00, 0xFF0F);  // Joypad, serial, timer, IF
+static constexpr IORegisterRange IO_RANGE_TIMER   = MakeIORegisterRange(0xFF04, 0xFF07);  // DIV, TIMA, TMA, TAC
+static constexpr IORegisterRange IO_RANGE_SOUND   = MakeIORegisterRange(0xFF10, 0xFF3F);  // NRxx and wave RAM
+static constexpr IORegisterRange IO_RANGE_PPU     = MakeIORegisterRange(0xFF40, 0xFF4B);  // LCDC through WX
+static constexpr IORegisterRange IO_RANGE_CGB     = MakeIORegisterRange(0xFF4C, 0xFF7F);  // CGB and misc registers
 
 /**
  * Helper function to find I/O register info for a given address
@@ -198,12 +302,11 @@ static const size_t IO_REGISTERS_COUNT = sizeof(IO_REGISTERS) / sizeof(IO_REGIST
  * @return Pointer to IORegister if found, nullptr otherwise
  */
 inline const IORegister* FindIORegister(uint16_t address) {
-    for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
-        if (address >= IO_REGISTERS[i].start && address <= IO_REGISTERS[i].end) {
-            return &IO_REGISTERS[i];
-        }
+    if (address < 0xFF00 || address > 0xFF7F) {
+        return nullptr;
     }
-    return nullptr;
+    int index = IO_REGISTER_LOOKUP.index[address - 0xFF00];
+    return index < 0 ? nullptr : &IO_REGISTERS[index];
 }
 
 } // namespace GBDebug
@@ -0,0 +1,159 @@
+#ifndef DISASSEMBLER_H
+#define DISASSEMBLER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bitset>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * How an opcode's immediate bytes are shown
+ */
+enum class OperandType : uint8_t {
+    None,       // No immediate (or a CB-prefixed op)
+    Imm8,       // d8: $%02X
+    Imm16,      // d16/a16: $%04X
+    Relative8,  // r8 branch offset, shown as the target address
+    HighPage8,  // a8 offset into $FF00, shown as $FFxx
+    Signed8,    // r8 stack offset, shown signed
+    Invalid     // Unused opcode, shown as a data byte
+};
+
+/**
+ * OpcodeInfo - One entry of the SM83 opcode tables
+ */
+struct OpcodeInfo {
+    const char* format;    // printf format taking the operand, if any
+    uint8_t length;        // Total bytes, including any CB prefix
+    OperandType operand;
+};
+
+/**
+ * DisassembledInstruction - A decoded instruction ready for display
+ */
+struct DisassembledInstruction {
+    static constexpr size_t MAX_TEXT = 24;
+
+    uint16_t address;
+    uint8_t length;
+    uint8_t bytes[3];
+    char text[MAX_TEXT];
+};
+
+/**
+ * Disassembler - Table-driven SM83 decoder with a per-bank decode cache
+ *
+ * Decoding is a lookup into constexpr 256-entry tables for base and
+ * CB-prefixed opcodes plus one snprintf. Decoded text is cached per
+ * (ROM bank, address); a cached entry stores its instruction bytes and is
+ * re-decoded only when those bytes no longer match memory, so RAM code is
+ * handled without any write tracking.
+ *
+ * GetLines() gives the instruction start addresses for the 16KB region
+ * around an address (a linear sweep). The sweep is cached too and redone
+ * only when the region's bytes change, or to resynchronize on an address
+ * (such as PC) that the sweep stepped over.
+ *
+ * Usage:
+ *   Disassembler disassembler;
+ *   const std::vector<uint16_t>& lines = disassembler.GetLines(memory, pc, romBank);
+ *   const DisassembledInstruction& insn = disassembler.Get(memory, lines[row], romBank);
+ *   ImGui::TextUnformatted(insn.text);
+ */
+class Disassembler {
+public:
+    static constexpr size_t REGION_SIZE = 0x4000;
+
+    Disassembler();
+
+    /**
+     * Get the table entry for a base opcode
+     */
+    static const OpcodeInfo& GetOpcodeInfo(uint8_t opcode);
+
+    /**
+     * Get the table entry for a CB-prefixed opcode
+     */
+    static const OpcodeInfo& GetCBOpcodeInfo(uint8_t opcode);
+
+    /**
+     * Get the length in bytes of the instruction starting with opcode
+     */
+    static uint8_t GetLength(uint8_t opcode) { return GetOpcodeInfo(opcode).length; }
+
+    /**
+     * Decode one instruction without caching
+     * @param memory Flat 64KB memory (reads wrap at $FFFF)
+     */
+    static void Decode(const uint8_t* memory, uint16_t address, DisassembledInstruction& out);
+
+    /**
+     * Get a decoded instruction, from the cache when its bytes are unchanged
+     * @param memory Flat 64KB memory
+     * @param bank ROM bank mapped at $4000-$7FFF (ignored elsewhere)
+     */
+    const DisassembledInstruction& Get(const uint8_t* memory, uint16_t address, int bank);
+
+    /**
+     * Get the instruction start addresses of the 16KB region containing
+     * address, guaranteed to include address itself
+     */
+    const std::vector<uint16_t>& GetLines(const uint8_t* memory, uint16_t address, int bank);
+
+    /**
+     * Drop all cached decodes and sweeps
+     */
+    void Clear();
+
+    /**
+     * Number of instructions decoded so far (cache misses)
+     */
+    uint64_t GetDecodeCount() const { return decodeCount_; }
+
+    /**
+     * Number of region sweeps performed so far
+     */
+    uint64_t GetSweepCount() const { return sweepCount_; }
+
+private:
+    static constexpr uint16_t BANKED_START = 0x4000;
+    static constexpr uint16_t BANKED_END = 0x7FFF;
+    static constexpr size_t MAX_ANCHORS = 64;
+    static constexpr size_t MAX_REGIONS = 16;
+
+    struct CachePage {
+        std::array<DisassembledInstruction, 256> entries;
+        std::bitset<256> valid;
+    };
+
+    struct RegionLines {
+        std::vector<uint8_t> bytes;       // Region contents at the last sweep
+        std::vector<uint16_t> anchors;    // Sorted forced instruction starts
+        std::vector<uint16_t> lines;      // Instruction start addresses
+    };
+
+    static bool IsBanked(uint16_t address) {
+        return address >= BANKED_START && address <= BANKED_END;
+    }
+
+    /**
+     * Sweep a region, starting a new instruction at every anchor
+     */
+    void Sweep(const uint8_t* memory, uint32_t start, RegionLines& region);
+
+    // Pages 0-255 cover the address space for bank 0 / unbanked areas;
+    // banked pages follow at 256 + bank * 64
+    std::vector<std::unique_ptr<CachePage>> pages_;
+    std::unordered_map<int, RegionLines> regions_;
+    uint64_t decodeCount_;
+    uint64_t sweepCount_;
+};
+
+} // namespace GBDebug
+
+#endif // DISASSEMBLER_H
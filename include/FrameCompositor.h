@@ -0,0 +1,154 @@
+#ifndef FRAME_COMPOSITOR_H
+#define FRAME_COMPOSITOR_H
+
+#include "DebuggerTypes.h"
+#include "ScanlineTimeline.h"
+#include "panels/VRAMViewerPanel.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bitset>
+
+namespace GBDebug {
+
+/**
+ * FrameCompositor - Rebuilds the 160x144 LCD image from VRAM, OAM and registers
+ *
+ * A CPU-side reference renderer that works one line at a time, like the
+ * PPU:
+ * - Background and window: each line fetches one tile row per 8 pixels
+ *   and decodes it with TileDecoder::DecodeTileRow().
+ * - Window: uses its own line counter. It starts on the line where LY
+ *   matches WY.
+ * - Sprites: the first 10 OAM entries covering the line are selected.
+ *   On DMG a lower X wins over a higher X, then a lower OAM index. On CGB
+ *   only the OAM index counts (SpriteOccupancy::SelectLine()). The
+ *   BG-over-OBJ rules for both modes are applied. On CGB, LCDC bit 0 acts
+ *   as the master priority switch.
+ *
+ * Registers come from a ScanlineTimeline frame when one is given, so
+ * mid-frame raster effects are reproduced. Otherwise every line uses the
+ * registers in memory. OAM and VRAM are taken as they are at the end of
+ * the frame.
+ *
+ * Pixels are produced in the LCD's native format rather than RGB: the
+ * DMG shade 0-3 after BGP/OBP0/OBP1, or the CGB RGB555 color after the
+ * palettes. A host's framebuffer in the same format can be compared
+ * exactly, whatever colors the host shows on screen.
+ *
+ * Usage:
+ *   FrameCompositor compositor;
+ *   compositor.Compose(memory, vramBank1, bgPalettes, spritePalettes, mode, &scanlines);
+ *   size_t wrong = compositor.Compare(emulatorFramebuffer);
+ */
+class FrameCompositor {
+public:
+    static constexpr int WIDTH = 160;
+    static constexpr int HEIGHT = 144;
+    static constexpr size_t PIXEL_COUNT = WIDTH * HEIGHT;
+    static constexpr int MAX_SPRITES_PER_LINE = 10;
+
+    typedef std::array<uint16_t, PIXEL_COUNT> Frame;
+
+    FrameCompositor();
+
+    /**
+     * Render one frame
+     *
+     * @param memory Flat 64KB memory (VRAM bank 0, OAM and the LCD registers)
+     * @param vramBank1 8KB VRAM bank 1 (CGB only, may be nullptr)
+     * @param bgPalettes 8 CGB background palettes (CGB only)
+     * @param spritePalettes 8 CGB sprite palettes (CGB only)
+     * @param mode DMG or CGB rendering rules
+     * @param scanlines Per-line registers, or nullptr to use memory's
+     */
+    void Compose(const uint8_t* memory, const uint8_t* vramBank1,
+                 const CGBPalette* bgPalettes, const CGBPalette* spritePalettes,
+                 EmulationMode mode, const ScanlineTimeline* scanlines = nullptr);
+
+    /**
+     * Rendered pixels, row-major: DMG shades (0-3) or CGB RGB555 colors
+     */
+    const Frame& GetFrame() const { return frame_; }
+
+    uint16_t GetPixel(int x, int y) const { return frame_[y * WIDTH + x]; }
+
+    /**
+     * Check whether the last frame used CGB rules and colors
+     */
+    bool IsCGB() const { return cgb_; }
+
+    /**
+     * Compare the last frame with a framebuffer in the same native format
+     *
+     * DMG values are compared in their low 2 bits, CGB values in their
+     * low 15 bits.
+     *
+     * @param reference PIXEL_COUNT pixels, row-major
+     * @return Number of pixels that differ
+     */
+    size_t Compare(const uint16_t* reference);
+
+    /**
+     * Pixels that differed in the last Compare()
+     */
+    const std::bitset<PIXEL_COUNT>& GetMismatches() const { return mismatches_; }
+
+    size_t GetMismatchCount() const { return mismatchCount_; }
+
+    /**
+     * First pixel that differed in the last Compare(), or -1
+     */
+    int GetFirstMismatch() const { return firstMismatch_; }
+
+    /**
+     * Number of sprites drawn on a line of the last frame (0-10)
+     */
+    int GetSpriteCount(int ly) const { return spriteCounts_[ly]; }
+
+private:
+    /**
+     * Per-pixel background/window result of one line
+     */
+    struct LineBG {
+        std::array<uint8_t, WIDTH> color;      // Color index 0-3
+        std::array<uint8_t, WIDTH> palette;    // CGB palette 0-7
+        std::array<uint8_t, WIDTH> priority;   // CGB attribute bit 7
+    };
+
+    /**
+     * Fetch tile rows from a map into line.color/palette/priority
+     * @param mapX First map column fetched (0-31)
+     * @param fineX Pixels to skip from the first tile
+     * @param mapY Map pixel row (0-255)
+     * @param startX First screen column written
+     */
+    void FetchMapRow(const ScanlineRegisters& registers, bool highMap, int mapX, int fineX,
+                     int mapY, int startX, LineBG& line) const;
+
+    /**
+     * Select, order and draw the sprites of one line into the frame
+     */
+    void DrawSprites(int ly, const ScanlineRegisters& registers, const LineBG& line, uint16_t* out);
+
+    /**
+     * Decode a tile row from a VRAM bank, with an optional horizontal flip
+     */
+    void DecodeRow(int bank, uint16_t tile, int row, bool hFlip, uint8_t* out) const;
+
+    const uint8_t* vram_[2];
+    const uint8_t* oam_;
+    const CGBPalette* bgPalettes_;
+    const CGBPalette* spritePalettes_;
+    bool cgb_;
+
+    Frame frame_;
+    std::array<uint8_t, HEIGHT> spriteCounts_;
+    std::bitset<PIXEL_COUNT> mismatches_;
+    size_t mismatchCount_;
+    int firstMismatch_;
+};
+
+} // namespace GBDebug
+
+#endif // FRAME_COMPOSITOR_H
@@ -1,9 +1,15 @@
 #ifndef GBDEBUGGER_H
 #define GBDEBUGGER_H
 
+#include "DebuggerTypes.h"
+#include "TraceBuffer.h"
+#include "TraceFile.h"
+#include "ScanlineTimeline.h"
 #include <cstdint>
 #include <cstddef>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 // Forward declarations
 struct SDL_Window;
@@ -19,11 +25,26 @@ class FlagsPanel;
 class MemoryViewerPanel;
 class ControlPanel;
 class VRAMViewerPanel;
+class BreakpointsPanel;
+class DisassemblyPanel;
+class TracePanel;
+class HistoryPanel;
+class TilemapPanel;
+class ScanlinePanel;
+class ScreenPanel;
+class StateHistory;
+class BreakpointManager;
+class WatchpointManager;
+struct Watchpoint;
 
 // Forward declarations for VRAM viewer types
 enum class EmulationMode;
 struct CGBPalette;
 
+// Defined in SnapshotChannel.h
+struct DebugSnapshot;
+template <typename T> class SnapshotChannel;
+
 /**
  * GBDebugger - Emulator-agnostic GameBoy debugger
  * 
@@ -36,6 +57,14 @@ struct CGBPalette;
  * - CPU flags (Z, N, H, C) with visual indicators
  * - Full 64KB memory viewer with region highlighting
  * - Control panel with Run/Stop, Step, and Exit buttons
+ * - Disassembly around PC and an execution trace
+ * - Rewind history with a timeline scrubber
+ * - BG/window tilemaps with the scroll viewport and window overlaid
+ * - LCD registers per scanline, graphed against LY
+ * - The LCD image rebuilt from VRAM/OAM/registers, diffed against the
+ *   emulator's framebuffer
+ * - PC breakpoints (optionally per ROM bank and conditional) and memory
+ *   watchpoints
  * 
  * Architecture:
  * - GBDebugger (this class): Public API, coordinates panels and backend
@@ -50,16 +79,35 @@ struct CGBPalette;
  *       debugger.ProcessSDLEvent(&event);
  *       debugger.UpdateCPU(cycle, pc, sp, af, bc, de, hl, ime);
  *       debugger.UpdateMemory(memoryBuffer, 65536);
+ *       // or, without copying: debugger.BorrowMemory(memoryBuffer, 65536, generation);
  *       debugger.BeginFrame();
  *       debugger.Render();
  *       debugger.EndFrame();
  *       
- *       if (debugger.IsRunning()) { ... }
+ *       if (debugger.IsRunning()) {
+ *           // per instruction: if (debugger.ShouldBreak(pc, romBank)) break;
+ *       }
  *       if (debugger.IsStepRequested()) { ... }
  *       if (debugger.IsExitRequested()) { break; }
  *   }
  *   
  *   debugger.Close();
+ * 
+ * Render governor (optional): after SetTargetUIRate(), frames are only
+ * drawn at that rate and only when state changed or the user interacted:
+ *   if (debugger.ShouldRender()) {
+ *       debugger.BeginFrame(); debugger.Render(); debugger.EndFrame();
+ *   }
+ * 
+ * Threaded usage (emulator and UI on separate threads):
+ *   // Emulator thread, as often as it likes, never blocks
+ *   DebugSnapshot& snapshot = debugger.BeginPublish();
+ *   ... fill snapshot.cpu, snapshot.memory, VRAM bank 1 and palettes (CGB) ...
+ *   debugger.EndPublish();
+ *   if (debugger.ConsumeStepRequest()) { ... }
+ *   
+ *   // UI thread: BeginFrame/Render/EndFrame as above; Render() picks up
+ *   // the newest published snapshot by itself
  */
 class GBDebugger {
 public:
@@ -114,6 +162,34 @@ public:
      */
     void EndFrame();
     
+    // ========== Render Governor ==========
+    
+    /**
+     * Limit how often the debugger redraws
+     * 
+     * With a non-zero rate, vsync is turned off (the governor does the
+     * pacing) so EndFrame() never blocks the emulator.
+     * 
+     * @param hz Maximum UI frames per second, 0 = no limit (default, vsync on)
+     */
+    void SetTargetUIRate(float hz);
+    
+    /**
+     * Get the UI rate set by SetTargetUIRate() (0 = no limit)
+     */
+    float GetTargetUIRate() const;
+    
+    /**
+     * Decide whether the next BeginFrame/Render/EndFrame should draw
+     * 
+     * Returns false when the target rate interval has not elapsed yet, or
+     * when no state update, published snapshot or input event arrived since
+     * the last drawn frame. When it returns false the following frame calls
+     * are no-ops, so hosts may call them unconditionally.
+     * Hosts that never call this get a frame on every call, as before.
+     */
+    bool ShouldRender();
+    
     // ========== State Updates ==========
     
     /**
@@ -138,6 +214,340 @@ public:
      */
     bool UpdateMemory(const uint8_t* buffer, size_t size);
     
+    /**
+     * Set the ROM bank mapped at $4000-$7FFF
+     * 
+     * Used to label and cache disassembly of switchable ROM per bank.
+     * Defaults to 1.
+     */
+    void SetROMBank(int bank);
+    
+    /**
+     * Update a contiguous range of memory
+     * 
+     * Only the panels whose data overlaps the range are touched: the memory
+     * viewer always, the VRAM viewer for $8000-$9FFF (bank 0) and $FE00-$FE9F,
+     * and only tiles whose bytes changed get re-decoded.
+     * 
+     * @param address First address written
+     * @param data Bytes written
+     * @param length Number of bytes (address + length must not exceed 65536)
+     * @return true if successful
+     */
+    bool UpdateMemoryRange(uint16_t address, const uint8_t* data, size_t length);
+    
+    /**
+     * Apply a batch of individual memory writes
+     * 
+     * Equivalent to calling UpdateMemoryRange() with one byte per record,
+     * in order. Meant for emulators that log writes since the last frame.
+     * 
+     * @param records Array of writes (see WriteRecord in DebuggerTypes.h)
+     * @param count Number of records
+     * @return true if successful
+     */
+    bool ApplyWriteLog(const WriteRecord* records, size_t count);
+    
+    /**
+     * Get the 64KB memory on display (nullptr before the first update)
+     */
+    const uint8_t* GetMemory() const;
+    
+    /**
+     * Get a VRAM bank (0 or 1) as held by the VRAM viewer
+     * 
+     * Borrowed memory (BorrowMemory()) is synced into this copy at the next
+     * Render().
+     */
+    const uint8_t* GetVRAMBank(int bank) const;
+    
+    /**
+     * Get the 160 bytes of OAM held by the VRAM viewer
+     */
+    const uint8_t* GetOAM() const;
+    
+    /**
+     * Check whether the cartridge header ($0143) selected CGB mode
+     */
+    bool IsCGBMode() const;
+    
+    // ========== Threaded Updates ==========
+    
+    /**
+     * Get the snapshot slot to fill from the emulator thread
+     * 
+     * The slot is reused, so every field must be written before
+     * EndPublish(). Only one thread may publish.
+     */
+    DebugSnapshot& BeginPublish();
+    
+    /**
+     * Hand the filled snapshot to the UI thread without blocking
+     * The next Render() displays the newest published snapshot.
+     */
+    void EndPublish();
+    
+    /**
+     * Let the debugger read the emulator's memory in place (zero-copy)
+     * 
+     * Unlike UpdateMemory(), nothing is copied here: panels read the buffer
+     * during Render(), and VRAM/OAM are only re-diffed when the generation
+     * changed. Cheap enough to call after every instruction step.
+     * 
+     * The buffer must stay valid until ReleaseMemory() or UpdateMemory() is
+     * called, and must not be written while Render() runs.
+     * 
+     * @param buffer Pointer to 64KB memory buffer
+     * @param size Must be 65536
+     * @param generation Counter the emulator changes whenever memory changes
+     * @return true if successful
+     */
+    bool BorrowMemory(const uint8_t* buffer, size_t size, uint64_t generation);
+    
+    /**
+     * Stop reading borrowed memory (e.g. before freeing the buffer)
+     * The last borrowed contents are copied once so panels keep showing them.
+     */
+    void ReleaseMemory();
+    
+    // ========== Breakpoints ==========
+    
+    /**
+     * Check whether execution should stop before the instruction at pc
+     * 
+     * Cheap enough to call before every instruction: with no breakpoint at
+     * pc this is one load and one bit test. On a hit, running is set to
+     * false and true is returned. The first check after the stop is let
+     * through if it is at the same address (and, with the CPUState
+     * overload, the same cycle), so Run moves past the breakpoint. A step
+     * (ClearStepRequest() or ConsumeStepRequest()) cancels that pass.
+     * Call from the emulator thread only.
+     * 
+     * Conditional breakpoints never fire here; they need the live registers
+     * and memory of the CPUState overload.
+     * 
+     * @param pc Address of the instruction about to execute
+     * @param bank ROM bank mapped at $4000-$7FFF (ignored elsewhere)
+     */
+    bool ShouldBreak(uint16_t pc, int bank = 0) {
+        if (((breakpoint_bits_[pc >> 6].load(std::memory_order_relaxed) >> (pc & 63)) & 1) == 0) {
+            return false;
+        }
+        return HandleBreakpoint(pc, bank, nullptr, nullptr);
+    }
+    
+    /**
+     * ShouldBreak() with live registers and memory for breakpoint conditions
+     * 
+     * @param cpu Current registers (cpu.pc is the instruction about to execute)
+     * @param bank ROM bank mapped at $4000-$7FFF
+     * @param memory Flat 64KB memory for conditions, or nullptr (conditional
+     *               breakpoints then do not fire)
+     */
+    bool ShouldBreak(const CPUState& cpu, int bank, const uint8_t* memory = nullptr) {
+        uint16_t pc = cpu.pc;
+        if (((breakpoint_bits_[pc >> 6].load(std::memory_order_relaxed) >> (pc & 63)) & 1) == 0) {
+            return false;
+        }
+        return HandleBreakpoint(pc, bank, &cpu, memory);
+    }
+    
+    /**
+     * Report a memory access so watchpoints can stop execution
+     * 
+     * Cheap enough to call on every bus access: accesses to pages without a
+     * matching watch are rejected with one load and one bit test. On a hit,
+     * running is set to false, the address is highlighted in the memory
+     * viewer, and true is returned.
+     * 
+     * @param address Accessed address
+     * @param value Value read, or value being written
+     * @param isWrite true for writes, false for reads
+     */
+    bool CheckAccess(uint16_t address, uint8_t value, bool isWrite) {
+        // Page flag bit 0 = read watched, bit 1 = write watched
+        if (((watch_pages_[address >> 8].load(std::memory_order_relaxed) >> (isWrite ? 1 : 0)) & 1) == 0) {
+            return false;
+        }
+        return HandleWatchAccess(address, value, isWrite);
+    }
+    
+    /**
+     * Add a memory watchpoint (see WatchpointManager.h)
+     * "Value changed" watches compare against the memory on display first.
+     */
+    void AddWatchpoint(const Watchpoint& watch);
+    
+    /**
+     * Add a PC breakpoint
+     * @param address Breakpoint address
+     * @param bank ROM bank (0-511) for $4000-$7FFF, or -1 for any bank; others are rejected
+     * @param condition Optional condition such as "A == 0x3C && [HL] > 5"
+     *                  (syntax in BreakCondition.h)
+     * @return true if the breakpoint was added, or its condition set
+     */
+    bool AddBreakpoint(uint16_t address, int bank = -1, const char* condition = nullptr);
+    
+    /**
+     * Remove a PC breakpoint added with the same address and bank
+     * @return true if a breakpoint was removed
+     */
+    bool RemoveBreakpoint(uint16_t address, int bank = -1);
+    
+    // ========== Execution Trace ==========
+    
+    /**
+     * Allocate the trace ring (16 bytes per record)
+     * 
+     * Tracing is off until a capacity is set. Must not be called while
+     * TraceInstruction() may run on another thread.
+     * 
+     * @param records Number of records to keep, rounded up to a power of two;
+     *                0 turns tracing off and frees the ring
+     */
+    void SetTraceCapacity(size_t records);
+    
+    /**
+     * Record one executed instruction in the trace
+     * 
+     * Meant to be called for every instruction from the emulator core: it
+     * stores one 16-byte record into the ring with no locks and no check
+     * for fullness (the oldest record is overwritten). Safe to call with
+     * tracing off, in which case the record is discarded.
+     * 
+     * @param pc Address of the instruction
+     * @param opcode First opcode byte (0xCB for prefixed instructions)
+     * @param cycle Cycle count before the instruction executes
+     * @param bank ROM bank mapped at $4000-$7FFF
+     */
+    void TraceInstruction(uint16_t pc, uint8_t opcode, uint16_t af, uint16_t bc,
+                          uint16_t de, uint16_t hl, uint64_t cycle, int bank = 0) {
+        trace_->Record(pc, opcode, af, bc, de, hl, cycle, bank);
+    }
+    
+    /**
+     * TraceInstruction() with the full register set, also streamed to the
+     * trace file when one is open (see StartTraceFile())
+     * 
+     * @param state Registers and cycle before the instruction executes
+     * @param opcode First opcode byte (0xCB for prefixed instructions)
+     * @param bank ROM bank mapped at $4000-$7FFF
+     */
+    void TraceInstruction(const CPUState& state, uint8_t opcode, int bank = 0) {
+        trace_->Record(state.pc, opcode, state.af, state.bc, state.de, state.hl, state.cycle, bank);
+        trace_file_->Append(state, opcode);
+    }
+    
+    /**
+     * Access the trace (for export or custom views)
+     */
+    const TraceBuffer& GetTrace() const { return *trace_; }
+    
+    /**
+     * Start streaming traced instructions to a file
+     * 
+     * Records are delta-encoded in large blocks on a background thread
+     * (format in TraceFile.h; read back with TraceFileReader). Safe to call
+     * while TraceInstruction() runs on the emulator thread.
+     * 
+     * @return false if the file cannot be created
+     */
+    bool StartTraceFile(const char* path);
+    
+    /**
+     * Flush and close the trace file
+     * 
+     * Safe to call while TraceInstruction() runs on the emulator thread:
+     * waits for an instruction being appended, and later ones are not
+     * recorded.
+     * 
+     * @return false if any write to the file failed
+     */
+    bool StopTraceFile();
+    
+    // ========== Rewind History ==========
+    
+    /**
+     * Set the memory budget of the rewind history and drop what it holds
+     * 
+     * History is off until a budget is set. With history on, every
+     * published snapshot is captured automatically; hosts using the
+     * UpdateXxx() methods call CaptureHistory() once per emulated frame.
+     * Steps store only the 256-byte pages that changed, so a typical game
+     * needs well under 1 KB per frame (see StateHistory.h).
+     * 
+     * @param bytes Arena size in bytes; 0 turns history off
+     */
+    void SetHistoryBudget(size_t bytes);
+    
+    /**
+     * Record the state on display (CPU, memory, VRAM bank 1, palettes)
+     * 
+     * Refused after SeekToCycle() until the next UpdateCPU() or snapshot
+     * brings live state back, and for cycles older than the newest step.
+     * 
+     * @return false if history is off, the view shows a seek, the cycle
+     *         went backwards, or the step does not fit the budget
+     */
+    bool CaptureHistory();
+    
+    /**
+     * Show the newest captured step at or before a cycle in every panel
+     * 
+     * Only the debugger's view moves; the emulator keeps its own state
+     * (GetHistory() gives hosts the reconstructed state to restore). The
+     * next state update or published snapshot replaces the view.
+     * 
+     * @return false if no step that old is held
+     */
+    bool SeekToCycle(uint64_t cycle);
+    
+    /**
+     * Access the rewind history (reconstructed state after a seek)
+     */
+    const StateHistory& GetHistory() const { return *history_; }
+    
+    // ========== Scanline Registers ==========
+    
+    /**
+     * Record the LCD registers used to draw one scanline
+     * 
+     * Meant to be called from the PPU once per line (for example at the
+     * start of mode 3), so writes made mid-frame by STAT or HBlank handlers
+     * are seen: this is a single store into a preallocated 154-line frame.
+     * The lines recorded so far become the shown frame at the next
+     * UpdateCPU() or EndPublish(); the tilemap overlays then follow each
+     * line's scroll and window registers.
+     * 
+     * @param ly Line being drawn (0-153; other values are ignored)
+     * @param registers LCDC, STAT, SCY, SCX, BGP, OBP0, OBP1, WY, WX for the line
+     */
+    void RecordScanlineRegisters(uint8_t ly, const ScanlineRegisters& registers) {
+        scanlines_->Record(ly, registers);
+    }
+    
+    /**
+     * Access the shown scanline frame
+     */
+    const ScanlineTimeline& GetScanlines() const { return *scanlines_; }
+    
+    // ========== Screen Reconstruction ==========
+    
+    /**
+     * Give the debugger the emulator's finished LCD frame to check
+     * 
+     * The Screen panel rebuilds the frame from VRAM, OAM, palettes and the
+     * scanline registers (see FrameCompositor.h) and diffs it against this
+     * one pixel by pixel, acting as a PPU regression oracle. Pixels are in
+     * the LCD's native format so host color mapping does not matter: DMG
+     * shades 0-3 after BGP/OBP0/OBP1, or CGB RGB555 colors.
+     * 
+     * @param pixels 160x144 pixels, row-major
+     * @param count Must be 23040
+     * @return true if successful
+     */
+    bool UpdateFramebuffer(const uint16_t* pixels, size_t count);
+    
     // ========== Window Access ==========
     
     /**
@@ -172,6 +582,12 @@ public:
      */
     void ClearStepRequest();
     
+    /**
+     * Check and clear the step request atomically (safe from any thread)
+     * @return true if a step was requested
+     */
+    bool ConsumeStepRequest();
+    
     /**
      * Check if exit was requested
      */
@@ -199,8 +615,76 @@ private:
     std::unique_ptr<MemoryViewerPanel> memory_panel_;
     std::unique_ptr<ControlPanel> control_panel_;
     std::unique_ptr<VRAMViewerPanel> vram_panel_;
+    std::unique_ptr<TilemapPanel> tilemap_panel_;
+    std::unique_ptr<ScanlineTimeline> scanlines_;
+    std::unique_ptr<ScanlinePanel> scanline_panel_;
+    std::unique_ptr<ScreenPanel> screen_panel_;
+    std::unique_ptr<BreakpointManager> breakpoints_;
+    std::unique_ptr<WatchpointManager> watchpoints_;
+    std::unique_ptr<BreakpointsPanel> breakpoints_panel_;
+    std::unique_ptr<DisassemblyPanel> disassembly_panel_;
+    std::unique_ptr<TraceBuffer> trace_;
+    std::unique_ptr<TraceFileWriter> trace_file_;
+    std::unique_ptr<TracePanel> trace_panel_;
+    std::unique_ptr<StateHistory> history_;
+    std::unique_ptr<HistoryPanel> history_panel_;
+    bool showing_history_;   // A seek is on display until the next live CPU state
+    const std::atomic<uint64_t>* breakpoint_bits_;   // breakpoints_ hot bitmap
+    const std::atomic<uint8_t>* watch_pages_;        // watchpoints_ page filter
+    // Last breakpoint stop (emulator thread; the flag is also cleared on step)
+    std::atomic<bool> break_suppressed_;   // Let the first check after the stop through
+    uint16_t break_pc_;
+    uint64_t break_cycle_;
+    bool break_has_cycle_;                 // Stop came with live registers
+    uint32_t shown_watch_hit_;   // Last watch hit forwarded to the memory viewer
+    std::unique_ptr<SnapshotChannel<DebugSnapshot>> snapshots_;
+    uint64_t publish_generation_;   // Emulator thread only
     bool is_open_;
     
+    // Render governor state
+    typedef std::chrono::steady_clock Clock;
+    float target_ui_rate_;
+    bool skip_frame_;                         // Set by ShouldRender() for this frame
+    std::atomic<uint64_t> state_generation_;  // Bumped by every state change
+    uint64_t rendered_generation_;            // state_generation_ at last drawn frame
+    Clock::time_point last_render_time_;
+    Clock::time_point last_input_time_;
+    
+    /**
+     * Record that displayed state changed (safe from any thread)
+     */
+    void MarkStateChanged() { state_generation_.fetch_add(1, std::memory_order_relaxed); }
+    
+    /**
+     * Slow path of ShouldBreak() for addresses flagged in the bitmap
+     */
+    bool HandleBreakpoint(uint16_t pc, int bank, const CPUState* cpu, const uint8_t* memory);
+    
+    /**
+     * Slow path of CheckAccess() for accesses to flagged pages
+     */
+    bool HandleWatchAccess(uint16_t address, uint8_t value, bool isWrite);
+    
+    /**
+     * Show the newest published snapshot, if one arrived (UI thread)
+     */
+    void ApplyLatestSnapshot();
+    
+    /**
+     * Push the history's reconstructed step into the panels
+     */
+    void ShowHistoryState();
+    
+    /**
+     * Switch the VRAM panel between DMG and CGB from the cartridge header
+     */
+    void DetectEmulationMode(uint8_t cgbFlag);
+    
+    /**
+     * Route a range that is already in the memory viewer to the VRAM viewer
+     */
+    void RouteRangeToVRAMPanel(uint16_t address, const uint8_t* data, size_t length);
+    
     // Disable copy
     GBDebugger(const GBDebugger&) = delete;
     GBDebugger& operator=(const GBDebugger&) = delete;
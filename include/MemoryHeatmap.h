@@ -0,0 +1,133 @@
+#ifndef MEMORY_HEATMAP_H
+#define MEMORY_HEATMAP_H
+
+#include "DebuggerTypes.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bitset>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * MemoryHeatmap - Per-byte write age from consecutive memory snapshots
+ *
+ * Each Observe() is one frame: the new 64KB image is compared with the
+ * previous one and every byte that differs records the frame it changed
+ * in, so a byte's age is a subtraction and nothing is aged per frame.
+ *
+ * Pages (256 bytes) are compared as a whole first, 16 bytes at a time with
+ * SSE2 (64-bit words elsewhere); only pages that differ are scanned for
+ * individual bytes and copied. A per-page bitmap of the last frame's
+ * changes and a per-page last-changed frame let renderers skip quiet
+ * memory without looking at its bytes.
+ *
+ * Change counts are kept per byte and per memory map region (see
+ * MEMORY_REGIONS) to find hot variables.
+ *
+ * Usage:
+ *   MemoryHeatmap heatmap;
+ *   heatmap.Observe(memory);              // per frame / step
+ *   if (heatmap.GetPageAge(addr >> 8) < 60) {
+ *       uint32_t age = heatmap.GetAge(addr);   // 0 = changed this frame
+ *   }
+ */
+class MemoryHeatmap {
+public:
+    static constexpr size_t MEMORY_SIZE = 0x10000;
+    static constexpr size_t PAGE_SIZE = 256;
+    static constexpr size_t PAGE_COUNT = MEMORY_SIZE / PAGE_SIZE;
+    static constexpr uint32_t NEVER_CHANGED = 0xFFFFFFFF;
+
+    MemoryHeatmap();
+
+    /**
+     * Compare memory with the previous frame and record changes
+     * The first call after construction or Reset() only takes a baseline.
+     * @param memory Flat 64KB memory
+     */
+    void Observe(const uint8_t* memory);
+
+    /**
+     * Forget all history; the next Observe() takes a new baseline
+     */
+    void Reset();
+
+    /**
+     * Number of frames observed after the baseline
+     */
+    uint32_t GetFrame() const { return frame_; }
+
+    /**
+     * Frames since a byte last changed (0 = in the last frame)
+     * @return NEVER_CHANGED if it has not changed since the baseline
+     */
+    uint32_t GetAge(uint16_t address) const {
+        uint32_t changed = lastChanged_[address];
+        return changed == 0 ? NEVER_CHANGED : frame_ - changed;
+    }
+
+    /**
+     * Frames since any byte of a page last changed
+     */
+    uint32_t GetPageAge(uint8_t page) const {
+        uint32_t changed = pageLastChanged_[page];
+        return changed == 0 ? NEVER_CHANGED : frame_ - changed;
+    }
+
+    /**
+     * Pages with at least one byte changed in the last frame
+     */
+    const std::bitset<PAGE_COUNT>& GetChangedPages() const { return changedPages_; }
+
+    /**
+     * Number of frames a byte changed in since the baseline
+     */
+    uint32_t GetChangeCount(uint16_t address) const { return changeCount_[address]; }
+
+    /**
+     * Bytes of a MEMORY_REGIONS entry changed in the last frame
+     */
+    uint32_t GetRegionChanges(size_t region) const { return regionChanges_[region]; }
+
+    /**
+     * Average bytes of a MEMORY_REGIONS entry changed per frame
+     */
+    double GetRegionRate(size_t region) const {
+        return frame_ == 0 ? 0.0 : static_cast<double>(regionTotals_[region]) / frame_;
+    }
+
+    /**
+     * Collect the most frequently changed addresses, most changes first
+     * @param count Maximum number of addresses
+     */
+    void GetHottest(std::vector<uint16_t>& out, size_t count) const;
+
+    /**
+     * Pages scanned byte by byte so far (pages that differed)
+     */
+    uint64_t GetPagesScanned() const { return pagesScanned_; }
+
+private:
+    /**
+     * Record the changed bytes of one page that differs from previous_
+     */
+    void ScanPage(size_t page, const uint8_t* memory);
+
+    std::array<uint8_t, MEMORY_SIZE> previous_;
+    std::array<uint32_t, MEMORY_SIZE> lastChanged_;   // Frame of last change, 0 = never
+    std::array<uint32_t, MEMORY_SIZE> changeCount_;
+    std::array<uint32_t, PAGE_COUNT> pageLastChanged_;
+    std::bitset<PAGE_COUNT> changedPages_;            // Changed in the last frame
+    std::bitset<PAGE_COUNT> everChanged_;
+    std::array<uint32_t, MEMORY_REGIONS_COUNT> regionChanges_;
+    std::array<uint64_t, MEMORY_REGIONS_COUNT> regionTotals_;
+    uint32_t frame_;
+    bool hasBaseline_;
+    uint64_t pagesScanned_;
+};
+
+} // namespace GBDebug
+
+#endif // MEMORY_HEATMAP_H
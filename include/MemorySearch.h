@@ -0,0 +1,146 @@
+#ifndef MEMORY_SEARCH_H
+#define MEMORY_SEARCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * How a search pattern is written
+ */
+enum class SearchMode {
+    Bytes,      // Hex bytes, "??" = any byte: "3E ?? EA 00 C0"
+    Value8,     // One byte: "200", "$C8" or "0xC8"
+    Value16,    // Little-endian word: "0x1234" matches 34 12
+    Text        // ASCII text
+};
+
+/**
+ * How cheat narrowing compares each candidate with the last snapshot
+ */
+enum class NarrowMode {
+    Unchanged,
+    Changed,
+    Increased,
+    Decreased
+};
+
+/**
+ * MemorySearch - Pattern search and cheat-style narrowing over 64KB memory
+ *
+ * Every search mode compiles to a byte pattern with optional wildcards.
+ * Find() scans for the pattern's first fixed byte 16 bytes at a time
+ * (SSE2 compare + movemask, bytewise elsewhere) and verifies the full
+ * pattern only at those positions.
+ *
+ * Cheat narrowing keeps one candidate bit per address and a copy of
+ * memory from the previous step. Narrow() compares memory with that copy
+ * 16 bytes at a time, ANDs the result into the candidate words and skips
+ * words with no candidates left, so repeated narrowing costs a few
+ * microseconds.
+ *
+ * Usage:
+ *   MemorySearch search;
+ *   if (search.SetPattern(SearchMode::Bytes, "3E ?? EA", error)) {
+ *       search.Find(memory, results);
+ *   }
+ *   search.StartNarrowing(memory);
+ *   ... run the game ...
+ *   search.Narrow(memory, NarrowMode::Increased);
+ *   search.GetCandidates(candidates);
+ */
+class MemorySearch {
+public:
+    static constexpr size_t MEMORY_SIZE = 0x10000;
+    static constexpr size_t MAX_PATTERN = 64;
+
+    MemorySearch();
+
+    /**
+     * Compile a search pattern
+     * @param error Receives the reason on failure
+     * @return false if the text is not valid for the mode
+     */
+    bool SetPattern(SearchMode mode, const std::string& text, std::string& error);
+
+    /**
+     * Number of bytes in the compiled pattern (0 = none)
+     */
+    size_t GetPatternLength() const { return pattern_.size(); }
+
+    /**
+     * Find every address where the compiled pattern starts
+     * Matches may overlap; patterns never wrap past $FFFF.
+     * @param memory Flat 64KB memory
+     * @param results Receives the addresses in ascending order
+     */
+    void Find(const uint8_t* memory, std::vector<uint16_t>& results) const;
+
+    /**
+     * Make every address a candidate and snapshot memory
+     */
+    void StartNarrowing(const uint8_t* memory);
+
+    /**
+     * Keep only candidates whose byte compares as asked with the last
+     * snapshot, then snapshot memory
+     * @return Number of candidates left
+     */
+    size_t Narrow(const uint8_t* memory, NarrowMode mode);
+
+    /**
+     * Keep only candidates whose byte currently equals a value
+     * @return Number of candidates left
+     */
+    size_t NarrowToValue(const uint8_t* memory, uint8_t value);
+
+    /**
+     * Check whether StartNarrowing() has been called since the last reset
+     */
+    bool IsNarrowing() const { return narrowing_; }
+
+    /**
+     * Drop all candidates
+     */
+    void ResetNarrowing();
+
+    size_t GetCandidateCount() const { return candidateCount_; }
+
+    /**
+     * Collect candidate addresses in ascending order
+     * @param limit Stop after this many
+     */
+    void GetCandidates(std::vector<uint16_t>& out, size_t limit = MEMORY_SIZE) const;
+
+    /**
+     * Value of a candidate in the last snapshot
+     */
+    uint8_t GetSnapshotValue(uint16_t address) const { return snapshot_[address]; }
+
+private:
+    static constexpr size_t CANDIDATE_WORDS = MEMORY_SIZE / 64;
+
+    /**
+     * AND per-byte keep masks into the candidates and count what is left
+     * @param keep Returns a 16-bit mask of bytes to keep for a 16-byte chunk
+     */
+    template <typename KeepFn>
+    size_t Filter(KeepFn keep);
+
+    std::vector<uint8_t> pattern_;
+    std::vector<uint8_t> wildcard_;   // 1 = any byte at this position
+    size_t anchor_;                   // First fixed position of pattern_
+
+    std::array<uint64_t, CANDIDATE_WORDS> candidates_;
+    std::array<uint8_t, MEMORY_SIZE> snapshot_;
+    size_t candidateCount_;
+    bool narrowing_;
+};
+
+} // namespace GBDebug
+
+#endif // MEMORY_SEARCH_H
@@ -0,0 +1,136 @@
+#ifndef PALETTE_SHADER_H
+#define PALETTE_SHADER_H
+
+#include <cstdint>
+#include "panels/VRAMViewerPanel.h"
+
+// Forward declarations for ImGui draw callback types
+struct ImDrawList;
+struct ImDrawCmd;
+
+namespace GBDebug {
+
+/**
+ * PaletteShader - GPU palette lookup for indexed tile textures
+ * 
+ * Lets tiles be stored once as 8-bit color indices (0-3) and colored at
+ * draw time by a fragment shader that looks the index up in a small
+ * palette texture. Changing palettes then costs one tiny texture upload
+ * instead of re-converting and re-uploading every tile.
+ * 
+ * The palette texture is 4x16 RGBA: rows 0-7 hold the background
+ * palettes, rows 8-15 the sprite palettes.
+ * 
+ * The shader is switched in and out through ImGui draw callbacks. It reuses
+ * the attribute locations and projection matrix of the ImGui OpenGL
+ * backend's own program, so ImGui's vertex setup is used unchanged.
+ * OpenGL 2.0 entry points are loaded through SDL at first use; if they are
+ * missing or the shader fails to compile, IsAvailable() returns false and
+ * callers should fall back to RGBA textures.
+ * 
+ * Usage:
+ *   PaletteShader shader;
+ *   if (shader.Initialize()) {
+ *       shader.UpdatePalettes(bgPalettes, spritePalettes);
+ *       shader.Begin(paletteRow);   // inside an ImGui window
+ *       ImGui::Image(indexTexture, size, uv0, uv1);
+ *       shader.End();
+ *   }
+ */
+class PaletteShader {
+public:
+    PaletteShader();
+    ~PaletteShader();
+    
+    /**
+     * Load GL entry points, compile the shaders and create the palette texture
+     * 
+     * Requires a current OpenGL context. Safe to call every frame; only the
+     * first call does any work.
+     * 
+     * @return true if palette lookup is available
+     */
+    bool Initialize();
+    
+    /**
+     * Check if palette lookup is available
+     */
+    bool IsAvailable() const { return available_; }
+    
+    /**
+     * Upload the background and sprite palettes if they changed
+     * 
+     * @param bgPalettes Pointer to 8 background palettes
+     * @param spritePalettes Pointer to 8 sprite palettes
+     * @return true if an upload occurred
+     */
+    bool UpdatePalettes(const Palette* bgPalettes, const Palette* spritePalettes);
+    
+    /**
+     * Switch the current ImGui window's draw list to palette lookup
+     * 
+     * Every image drawn until End() must use an indexed texture. Other
+     * widgets should be drawn after End().
+     * 
+     * @param paletteRow Palette texture row (0-7 BG, 8-15 sprite)
+     */
+    void Begin(int paletteRow);
+    
+    /**
+     * Restore ImGui's default shader on the current window's draw list
+     */
+    void End();
+    
+    /**
+     * Delete the GL program and palette texture
+     */
+    void Shutdown();
+    
+    /// Number of palette rows (8 BG + 8 sprite)
+    static constexpr int PALETTE_ROWS = 16;
+
+private:
+    /**
+     * Per-row callback payload (must outlive the ImGui frame)
+     */
+    struct DrawState {
+        PaletteShader* shader;
+        float paletteV;   // Texture V coordinate of the palette row
+    };
+    
+    static void DrawCallback(const ImDrawList* parentList, const ImDrawCmd* cmd);
+    
+    /**
+     * Bind the lookup program, matching ImGui's currently bound program
+     */
+    void Apply(float paletteV);
+    
+    /**
+     * Link the program with the attribute locations ImGui's program uses
+     */
+    bool LinkAgainst(unsigned int imguiProgram);
+    
+    unsigned int vertexShader_;
+    unsigned int fragmentShader_;
+    unsigned int program_;
+    unsigned int linkedFor_;        // ImGui program the attributes were matched to
+    unsigned int paletteTexture_;
+    
+    int projLocation_;
+    int indexLocation_;
+    int paletteLocation_;
+    int paletteVLocation_;
+    int imguiProjLocation_;
+    float projMatrix_[16];
+    
+    DrawState drawStates_[PALETTE_ROWS];
+    TileColor uploaded_[PALETTE_ROWS * 4];
+    
+    bool initialized_;
+    bool available_;
+    bool palettesValid_;
+};
+
+} // namespace GBDebug
+
+#endif // PALETTE_SHADER_H
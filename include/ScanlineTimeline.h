@@ -0,0 +1,130 @@
+#ifndef SCANLINE_TIMELINE_H
+#define SCANLINE_TIMELINE_H
+
+#include "DebuggerTypes.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace GBDebug {
+
+/**
+ * ScanlineTimeline - LCD registers for each of the 154 lines of a frame
+ *
+ * The emulator's PPU calls Record() once per line. Record() stores the
+ * registers into a preallocated slot indexed by LY, so it costs one bounds
+ * check and a 9-byte copy. Latch() then copies the recorded lines into the
+ * frame shown by the debugger. Lines that were not recorded keep their
+ * values from the previous frame.
+ *
+ * Record() and the Get/HasPending/ClearPending calls belong to the
+ * emulator's thread; the shown frame belongs to whichever thread renders.
+ * Single-threaded hosts latch directly (GBDebugger::UpdateCPU()); threaded
+ * hosts hand the recording over in a snapshot and the UI thread calls
+ * SetFrame() with it.
+ *
+ * Usage:
+ *   ScanlineTimeline timeline;
+ *   timeline.Record(ly, registers);      // per line, from the PPU
+ *   timeline.Latch();                    // per frame
+ *   uint8_t scx = timeline.GetLine(100).scx;
+ */
+class ScanlineTimeline {
+public:
+    static constexpr size_t LINE_COUNT = 154;        // 144 visible + 10 VBlank
+    static constexpr size_t VISIBLE_LINES = 144;
+    static constexpr size_t REGISTER_COUNT = 9;
+
+    typedef std::array<ScanlineRegisters, LINE_COUNT> Frame;
+
+    ScanlineTimeline();
+
+    /**
+     * Producer: store the registers used for line ly (ly >= 154 is ignored)
+     */
+    void Record(uint8_t ly, const ScanlineRegisters& registers) {
+        if (ly < LINE_COUNT) {
+            recording_[ly] = registers;
+            pending_ = true;
+        }
+    }
+
+    /**
+     * Producer: lines recorded so far (valid until the next Record())
+     */
+    const Frame& GetRecording() const { return recording_; }
+
+    /**
+     * Producer: check whether anything was recorded since the last Latch()
+     */
+    bool HasPending() const { return pending_; }
+
+    /**
+     * Producer: mark the recorded lines as handed over without latching them
+     */
+    void ClearPending() { pending_ = false; }
+
+    /**
+     * Make the recorded lines the shown frame
+     * @return false if nothing was recorded since the last call
+     */
+    bool Latch();
+
+    /**
+     * Replace the shown frame (e.g. with one carried by a snapshot)
+     */
+    void SetFrame(const Frame& frame);
+
+    /**
+     * Forget the shown frame; renderers fall back to the registers in memory
+     */
+    void Clear();
+
+    /**
+     * Check whether a frame has been latched or set
+     */
+    bool HasFrame() const { return hasFrame_; }
+
+    const Frame& GetFrame() const { return frame_; }
+    const ScanlineRegisters& GetLine(size_t ly) const { return frame_[ly]; }
+
+    /**
+     * Check whether every visible line of the shown frame used the same
+     * registers (STAT is ignored, its mode bits change by themselves)
+     */
+    bool IsUniform() const { return uniform_; }
+
+    /**
+     * Counter that changes whenever the shown frame changes
+     */
+    uint64_t GetGeneration() const { return generation_; }
+
+    /**
+     * Registers by index, in ScanlineRegisters field order
+     */
+    static uint8_t GetRegister(const ScanlineRegisters& registers, size_t index);
+    static const char* GetRegisterName(size_t index);
+
+    /**
+     * Read the registers from a flat 64KB memory image
+     */
+    static ScanlineRegisters ReadRegisters(const uint8_t* memory);
+
+private:
+    /**
+     * Recompute uniform_ and bump the generation after frame_ changed
+     */
+    void FrameChanged();
+
+    Frame recording_;
+    bool pending_;
+
+    Frame frame_;
+    bool hasFrame_;
+    bool uniform_;
+    uint64_t generation_;
+};
+
+} // namespace GBDebug
+
+#endif // SCANLINE_TIMELINE_H
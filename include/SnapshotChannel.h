@@ -0,0 +1,127 @@
+#ifndef SNAPSHOT_CHANNEL_H
+#define SNAPSHOT_CHANNEL_H
+
+#include "DebuggerTypes.h"
+#include "ScanlineTimeline.h"
+#include "FrameCompositor.h"
+#include "panels/VRAMViewerPanel.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace GBDebug {
+
+/**
+ * DebugSnapshot - Everything the debugger displays, captured at one instant
+ *
+ * Filled in by the emulator thread and handed to the UI thread through a
+ * SnapshotChannel. Slots are reused, so every field must be written on
+ * each publish.
+ */
+struct DebugSnapshot {
+    CPUState cpu;
+    std::array<uint8_t, 65536> memory;        // Full address space, VRAM/OAM included
+    std::array<uint8_t, 8192> vramBank1;      // CGB VRAM bank 1: tiles and BG map attributes
+    bool hasVRAMBank1;                        // false = no bank 1 (DMG), leave it untouched
+    std::array<CGBPalette, 8> bgPalettes;
+    std::array<CGBPalette, 8> spritePalettes;
+    bool hasCGBPalettes;                      // false = leave palettes untouched
+    int romBank;                              // ROM bank mapped at $4000-$7FFF
+    ScanlineTimeline::Frame scanlines;        // Set on publish from RecordScanlineRegisters()
+    bool hasScanlines;                        // Set on publish: lines were recorded
+    FrameCompositor::Frame framebuffer;       // Emulator's LCD output, native format (see UpdateFramebuffer)
+    bool hasFramebuffer;                      // false = leave the last framebuffer shown
+    uint64_t generation;                      // Set on publish, increases by one each time
+
+    DebugSnapshot()
+        : hasVRAMBank1(false), hasCGBPalettes(false), romBank(1), hasScanlines(false), hasFramebuffer(false),
+          generation(0) {
+        memory.fill(0);
+        vramBank1.fill(0);
+        framebuffer.fill(0);
+    }
+};
+
+/**
+ * SnapshotChannel - Lock-free triple buffer between one producer and one consumer
+ *
+ * The producer always owns a back slot it can fill without waiting, the
+ * consumer owns a front slot that stays stable while it is being read, and
+ * the third slot is exchanged between them through a single atomic byte.
+ * Publishing never blocks and the consumer always sees the newest complete
+ * snapshot; intermediate ones are simply overwritten.
+ *
+ * Usage:
+ *   // Producer thread
+ *   T& slot = channel.GetBack();
+ *   ... fill slot ...
+ *   channel.Publish();
+ *
+ *   // Consumer thread
+ *   if (channel.Acquire()) {
+ *       const T& latest = channel.GetFront();
+ *   }
+ */
+template <typename T>
+class SnapshotChannel {
+public:
+    SnapshotChannel() : back_(0), shared_(1), front_(2) {}
+
+    /**
+     * Producer: slot to fill before the next Publish()
+     */
+    T& GetBack() { return slots_[back_]; }
+
+    /**
+     * Producer: hand the back slot to the consumer and take a free one
+     */
+    void Publish() {
+        back_ = shared_.exchange(static_cast<uint8_t>(back_ | FRESH_BIT),
+                                 std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * Consumer: swap in the newest published slot, if any
+     * @return true if GetFront() now refers to a newer snapshot
+     */
+    bool Acquire() {
+        if (!HasPending()) {
+            return false;
+        }
+        front_ = shared_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Consumer: check whether a snapshot was published since the last Acquire()
+     */
+    bool HasPending() const {
+        return (shared_.load(std::memory_order_relaxed) & FRESH_BIT) != 0;
+    }
+
+    /**
+     * Consumer: latest acquired snapshot (valid until the next Acquire())
+     */
+    const T& GetFront() const { return slots_[front_]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH_BIT = 0x04;   // Shared slot not yet consumed
+
+    SnapshotChannel(const SnapshotChannel&) = delete;
+    SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    std::array<T, 3> slots_;
+
+    // Producer and consumer indices are padded onto separate cache lines
+    // (alignas would need C++17 aligned new for heap-allocated channels)
+    uint8_t back_;
+    char padBack_[63];
+    std::atomic<uint8_t> shared_;
+    char padShared_[63];
+    uint8_t front_;
+};
+
+} // namespace GBDebug
+
+#endif // SNAPSHOT_CHANNEL_H
@@ -0,0 +1,113 @@
+#ifndef SPRITE_OCCUPANCY_H
+#define SPRITE_OCCUPANCY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace GBDebug {
+
+/**
+ * SpriteLine - Sprites on one scanline as the PPU's OAM scan sees them
+ */
+struct SpriteLine {
+    static constexpr int MAX_DRAWN = 10;
+
+    uint64_t covering;      // Bit N = OAM entry N spans this line
+    uint64_t dropped;       // Covering entries past the first 10, never drawn
+    uint8_t coveringCount;  // Entries spanning the line (0-40)
+    uint8_t drawnCount;     // Entries selected for drawing (0-10)
+    std::array<uint8_t, MAX_DRAWN> order;   // Selected entries, highest priority first
+
+    SpriteLine() : covering(0), dropped(0), coveringCount(0), drawnCount(0) { order.fill(0); }
+};
+
+/**
+ * SpriteOccupancy - Per-scanline sprite selection for the 144 visible lines
+ *
+ * For every line, records which OAM entries span it and which of them the
+ * OAM scan selects. The scan takes the first 10 in OAM order, whatever
+ * their X, so off-screen sprites still count. The rest are recorded as
+ * dropped. Selected entries are stored in drawing priority: on DMG a lower
+ * X wins (ties go to the lower OAM index); on CGB only the OAM index
+ * counts.
+ *
+ * Sprite height comes from LCDC bit 2. The pass works on fixed-size
+ * tables and never allocates. It is skipped when OAM, height and mode are
+ * unchanged since the last call. SelectLine() is the single copy of the
+ * selection rules; FrameCompositor uses it for every line it draws.
+ *
+ * Usage:
+ *   SpriteOccupancy occupancy;
+ *   occupancy.Analyze(oam, lcdc, cgb);
+ *   const SpriteLine& line = occupancy.GetLine(ly);
+ *   if (line.dropped != 0) { line hit the 10-sprite limit }
+ */
+class SpriteOccupancy {
+public:
+    static constexpr int LINE_COUNT = 144;
+    static constexpr int OAM_ENTRIES = 40;
+    static constexpr size_t OAM_SIZE = OAM_ENTRIES * 4;
+
+    SpriteOccupancy();
+
+    /**
+     * Rebuild the per-line tables
+     * @param oam 160-byte OAM
+     * @param lcdc LCDC register (bit 2 selects 8x16 sprites)
+     * @param cgb true for CGB priority (OAM order only)
+     * @return false if nothing changed since the last call
+     */
+    bool Analyze(const uint8_t* oam, uint8_t lcdc, bool cgb);
+
+    /**
+     * Run the OAM scan for one line
+     * @param oam 160-byte OAM
+     * @param ly Line (may be outside 0-143)
+     * @param height Sprite height (8 or 16)
+     * @param cgb true for CGB priority (OAM order only)
+     * @param line Receives the covering, selected and dropped entries
+     */
+    static void SelectLine(const uint8_t* oam, int ly, int height, bool cgb, SpriteLine& line);
+
+    const SpriteLine& GetLine(int ly) const { return lines_[ly]; }
+
+    /**
+     * Sprite height used by the last analysis (8 or 16)
+     */
+    int GetSpriteHeight() const { return height_; }
+
+    /**
+     * OAM entries dropped on at least one line
+     */
+    uint64_t GetDroppedSprites() const { return droppedSprites_; }
+
+    /**
+     * Number of lines where an entry was dropped
+     */
+    int GetOverflowLines() const { return overflowLines_; }
+
+    /**
+     * Highest number of entries spanning any one line
+     */
+    int GetPeakCount() const { return peakCount_; }
+
+    /**
+     * Force the next Analyze() to run
+     */
+    void Invalidate() { valid_ = false; }
+
+private:
+    std::array<SpriteLine, LINE_COUNT> lines_;
+    std::array<uint8_t, OAM_SIZE> oam_;    // OAM of the last analysis
+    uint64_t droppedSprites_;
+    int overflowLines_;
+    int peakCount_;
+    int height_;
+    bool cgb_;
+    bool valid_;
+};
+
+} // namespace GBDebug
+
+#endif // SPRITE_OCCUPANCY_H
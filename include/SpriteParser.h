@@ -2,6 +2,7 @@
 #define SPRITE_PARSER_H
 
 #include <cstdint>
+#include <array>
 #include <vector>
 #include "panels/VRAMViewerPanel.h"
 
@@ -25,9 +26,13 @@ namespace GBDebug {
  *   - Bit 4: DMG palette number / CGB VRAM bank
  *   - Bits 0-2: CGB palette number
  * 
+ * The array overload of ParseOAM() fills a caller-owned table and never
+ * allocates; the vector overload is kept for existing callers.
+ * 
  * Usage:
  *   SpriteParser parser;
- *   auto sprites = parser.ParseOAM(oamBuffer, 160);
+ *   SpriteParser::SpriteTable sprites;
+ *   parser.ParseOAM(oamBuffer, 160, sprites);
  *   for (const auto& sprite : sprites) {
  *       if (parser.IsSpriteVisible(sprite)) {
  *           // Render sprite
@@ -36,9 +41,31 @@ namespace GBDebug {
  */
 class SpriteParser {
 public:
+    /// Maximum number of sprites in OAM
+    static constexpr size_t MAX_SPRITES = 40;
+    
+    /// Size of each sprite entry in bytes
+    static constexpr size_t SPRITE_ENTRY_SIZE = 4;
+    
+    /// Total OAM size in bytes
+    static constexpr size_t OAM_SIZE = MAX_SPRITES * SPRITE_ENTRY_SIZE;
+    
+    /// Parsed attributes of every OAM entry, in OAM order
+    typedef std::array<SpriteAttributes, MAX_SPRITES> SpriteTable;
+    
     SpriteParser() = default;
     ~SpriteParser() = default;
     
+    /**
+     * Parse all sprites from OAM buffer into a fixed table
+     * 
+     * @param oam Pointer to OAM buffer (160 bytes)
+     * @param size Size of OAM buffer (must be 160)
+     * @param sprites Table to fill; left untouched on error
+     * @return Number of sprites parsed (40), or 0 on error
+     */
+    size_t ParseOAM(const uint8_t* oam, size_t size, SpriteTable& sprites);
+    
     /**
      * Parse all sprites from OAM buffer
      * 
@@ -78,15 +105,6 @@ public:
      * @return true if sprite is at least partially visible
      */
     bool IsSpriteVisible(const SpriteAttributes& sprite);
-    
-    /// Maximum number of sprites in OAM
-    static constexpr size_t MAX_SPRITES = 40;
-    
-    /// Size of each sprite entry in bytes
-    static constexpr size_t SPRITE_ENTRY_SIZE = 4;
-    
-    /// Total OAM size in bytes
-    static constexpr size_t OAM_SIZE = MAX_SPRITES * SPRITE_ENTRY_SIZE;
 };
 
 } // namespace GBDebug
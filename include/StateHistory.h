@@ -0,0 +1,176 @@
+#ifndef STATE_HISTORY_H
+#define STATE_HISTORY_H
+
+#include "DebuggerTypes.h"
+#include "panels/VRAMViewerPanel.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * StateHistory - Rewind buffer of keyframes and XOR/RLE page deltas
+ *
+ * Each captured step is a CPUState plus an image of everything the
+ * debugger displays: the 64KB address space (VRAM bank 0 and OAM
+ * included), VRAM bank 1 and the CGB palettes. The image is split into
+ * 256-byte pages; a step stores only the pages that changed since the
+ * previous step, XORed with their old contents and run-length encoded
+ * (small edits XOR to long zero runs). Every keyframe interval a step
+ * stores all non-zero pages instead, so reconstruction never replays more
+ * than one interval of deltas.
+ *
+ * Steps live in a fixed-size byte arena used as a ring; when it fills up
+ * the oldest keyframe and its deltas are dropped together. Because XOR
+ * deltas are their own inverse, seeking near the last reconstructed step
+ * walks forward or backward from it instead of starting at a keyframe.
+ *
+ * Encoded step: repeated [uint16 page][uint16 length][RLE bytes],
+ * terminated by page 0xFFFF. RLE control byte c: c >= 0x80 = (c - 0x7F)
+ * zero bytes; otherwise c + 1 literal bytes follow.
+ *
+ * Usage:
+ *   StateHistory history;
+ *   history.SetBudget(256 * 1024 * 1024);
+ *   history.Capture(cpu, memory, vramBank1, bgPalettes, spritePalettes);   // per frame
+ *   if (history.SeekToCycle(cycle)) {
+ *       const uint8_t* pastMemory = history.GetMemory();
+ *   }
+ */
+class StateHistory {
+public:
+    static constexpr size_t PAGE_SIZE = 256;
+    static constexpr size_t MEMORY_SIZE = 0x10000;
+    static constexpr size_t VRAM_BANK_SIZE = 0x2000;
+    static constexpr size_t PALETTE_BYTES = 64;        // 8 palettes x 4 colors x 2 bytes
+    static constexpr size_t IMAGE_SIZE = MEMORY_SIZE + VRAM_BANK_SIZE + PAGE_SIZE;
+    static constexpr size_t PAGE_COUNT = IMAGE_SIZE / PAGE_SIZE;
+    static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 300;
+
+    StateHistory();
+
+    /**
+     * Set the arena size and drop all history
+     * @param bytes Arena size; 0 turns history off and frees the arena
+     */
+    void SetBudget(size_t bytes);
+
+    size_t GetBudget() const { return arena_.size(); }
+
+    /**
+     * Set how many steps apart keyframes are (takes effect at the next keyframe)
+     */
+    void SetKeyframeInterval(size_t steps) { keyframeInterval_ = steps > 0 ? steps : 1; }
+
+    bool IsEnabled() const { return !arena_.empty(); }
+
+    /**
+     * Record one step
+     * @param memory Flat 64KB memory
+     * @param vramBank1 8KB VRAM bank 1, or nullptr (DMG)
+     * @param bgPalettes 8 CGB background palettes, or nullptr
+     * @param spritePalettes 8 CGB sprite palettes, or nullptr
+     * @return false if history is off, cpu.cycle is older than the newest
+     *         step, or the step does not fit in the arena
+     */
+    bool Capture(const CPUState& cpu, const uint8_t* memory, const uint8_t* vramBank1,
+                 const CGBPalette* bgPalettes, const CGBPalette* spritePalettes);
+
+    /**
+     * Reconstruct the newest step at or before a cycle
+     * @return false if no step that old is held
+     */
+    bool SeekToCycle(uint64_t cycle);
+
+    /**
+     * Reconstruct a step by position (0 = oldest held)
+     */
+    bool SeekToStep(size_t step);
+
+    // Reconstructed state from the last successful seek
+    const CPUState& GetCPU() const { return cursorCPU_; }
+    const uint8_t* GetMemory() const { return cursor_.data(); }
+    const uint8_t* GetVRAMBank1() const { return cursor_.data() + MEMORY_SIZE; }
+    void CopyPalettes(CGBPalette* bgPalettes, CGBPalette* spritePalettes) const;
+
+    /**
+     * Position of the last seek (0 = oldest held)
+     */
+    size_t GetCursorStep() const { return static_cast<size_t>(cursorSeq_ - firstSeq_); }
+
+    size_t GetStepCount() const { return steps_.size(); }
+    size_t GetKeyframeCount() const { return keyframeCount_; }
+    size_t GetBytesUsed() const { return bytesUsed_; }
+    uint64_t GetOldestCycle() const { return steps_.empty() ? 0 : steps_.front().cpu.cycle; }
+    uint64_t GetNewestCycle() const { return steps_.empty() ? 0 : steps_.back().cpu.cycle; }
+
+    /**
+     * Cycle of a step by position (0 = oldest held)
+     */
+    uint64_t GetStepCycle(size_t step) const { return steps_[step].cpu.cycle; }
+
+    /**
+     * Drop all steps but keep the arena
+     */
+    void Clear();
+
+private:
+    struct Step {
+        CPUState cpu;
+        size_t offset;      // Start of the encoded pages in the arena
+        size_t size;
+        bool keyframe;
+    };
+
+    typedef std::array<uint8_t, IMAGE_SIZE> Image;
+
+    /**
+     * Encode page differences between two images into scratch_
+     * @param keyframe Encode against zeros, every non-zero page
+     */
+    void EncodeStep(const Image& previous, const Image& next, bool keyframe);
+
+    /**
+     * Move the cursor image to a step by sequence number
+     */
+    void MoveCursor(uint64_t seq);
+
+    /**
+     * XOR an encoded step into an image
+     */
+    static void ApplyStep(const uint8_t* data, Image& image);
+
+    /**
+     * Reserve contiguous arena space, evicting the oldest steps
+     * @return Offset of the space, or SIZE_MAX if it can never fit
+     */
+    size_t Allocate(size_t size);
+
+    void EvictFront();
+
+    std::vector<uint8_t> arena_;
+    size_t head_;                  // Next free arena offset
+    size_t bytesUsed_;
+    std::deque<Step> steps_;
+    uint64_t firstSeq_;            // Sequence number of steps_.front()
+    size_t keyframeCount_;
+    size_t keyframeInterval_;
+    size_t sinceKeyframe_;
+
+    Image last_;                   // Image of the newest step
+    Image next_;                   // Capture scratch
+    std::vector<uint8_t> scratch_; // Encode scratch
+    size_t scratchSize_;
+
+    Image cursor_;                 // Reconstructed image
+    CPUState cursorCPU_;
+    uint64_t cursorSeq_;
+    bool cursorValid_;
+};
+
+} // namespace GBDebug
+
+#endif // STATE_HISTORY_H
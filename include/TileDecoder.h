@@ -21,10 +21,21 @@ namespace GBDebug {
  * 
  * Supports horizontal and vertical flipping for sprite rendering.
  * 
+ * Whole rows are decoded at once through a 256-entry lookup table that
+ * spreads the 8 bits of a byte into 8 pixel bytes, so a row costs two table
+ * loads, a shift and an OR instead of 8 calls to DecodePixel(). The
+ * per-pixel path is kept as DecodeTileReference() for correctness tests.
+ * Sprite flips are applied while decoding: a horizontal flip reverses the
+ * two bitplane bytes through a second 256-entry table before spreading,
+ * and a vertical flip reads the rows bottom up.
+ * 
  * Usage:
  *   TileDecoder decoder;
  *   auto pixelData = decoder.DecodeTile(vramBuffer, tileIndex, bank);
  *   // pixelData is now an 8x8 array of color indices (0-3)
+ * 
+ *   // Or decode many tiles into one contiguous buffer (64 bytes per tile)
+ *   decoder.DecodeTiles(vramBuffer, 0, 384, pixelBuffer);
  */
 class TileDecoder {
 public:
@@ -49,6 +60,73 @@ public:
         uint8_t bank = 0
     );
     
+    /**
+     * Decode a contiguous run of tiles into a flat pixel buffer
+     * 
+     * Each tile is written as 64 color indices (row-major, 8 per row), and
+     * tiles follow each other in index order, so tile N starts at
+     * out + (N - firstTile) * 64.
+     * 
+     * @param vram Pointer to VRAM buffer (8192 bytes)
+     * @param firstTile Index of the first tile to decode
+     * @param count Number of tiles to decode
+     * @param out Output buffer, at least count * 64 bytes
+     */
+    void DecodeTiles(
+        const uint8_t* vram,
+        uint16_t firstTile,
+        uint16_t count,
+        uint8_t* out
+    );
+    
+    /**
+     * Decode one tile row from its two bitplane bytes
+     * 
+     * @param lsb Low bitplane byte of the row
+     * @param msb High bitplane byte of the row
+     * @param out Output for 8 color indices (0-3), leftmost pixel first
+     */
+    static void DecodeTileRow(uint8_t lsb, uint8_t msb, uint8_t* out);
+    
+    /**
+     * Reverse the bit order of a byte (bit 7 becomes bit 0)
+     * 
+     * Applied to both bitplane bytes of a row before DecodeTileRow(), it
+     * yields the row mirrored left-right.
+     */
+    static uint8_t ReverseBits(uint8_t value);
+    
+    /**
+     * Decode a tile with sprite flips applied
+     * 
+     * @param vram Pointer to VRAM buffer (8192 bytes)
+     * @param tileIndex Tile index (0-511 for full VRAM)
+     * @param hFlip Mirror the tile left-right
+     * @param vFlip Mirror the tile top-bottom
+     * @return 8x8 array of color indices (0-3), as displayed
+     */
+    std::array<std::array<uint8_t, 8>, 8> DecodeTileFlipped(
+        const uint8_t* vram,
+        uint16_t tileIndex,
+        bool hFlip,
+        bool vFlip
+    );
+    
+    /**
+     * Decode a complete tile pixel by pixel (scalar reference path)
+     * 
+     * Produces the same result as DecodeTile() using DecodePixel() for
+     * every pixel. Slow; intended for verifying the table-driven decoder.
+     * 
+     * @param vram Pointer to VRAM buffer (8192 bytes)
+     * @param tileIndex Tile index (0-511 for full VRAM)
+     * @return 8x8 array of color indices (0-3)
+     */
+    std::array<std::array<uint8_t, 8>, 8> DecodeTileReference(
+        const uint8_t* vram,
+        uint16_t tileIndex
+    );
+    
     /**
      * Decode a single pixel from tile data
      * 
@@ -6,6 +6,7 @@
 #include <vector>
 #include <unordered_map>
 #include "panels/VRAMViewerPanel.h"
+#include "PaletteShader.h"
 
 namespace GBDebug {
 
@@ -107,6 +108,127 @@ private:
     int GetIndex(int row, int col) const;
 };
 
+/**
+ * TileAtlas - Single OpenGL texture holding many 8x8 tiles
+ * 
+ * Packs tiles into one texture laid out as a grid of tileCols x tileRows
+ * tiles at 1:1 scale. Tiles are written into a CPU-side RGBA buffer and the
+ * whole batch is sent to the GPU with a single glTexSubImage2D call, so a
+ * grid of 384 tiles costs one upload per frame instead of one per tile.
+ * Display scaling is left to the GPU (GL_NEAREST keeps pixels sharp) and
+ * individual tiles are drawn by passing their UV rectangle to ImGui::Image().
+ * 
+ * Only the band of rows touched since the last upload is re-sent.
+ * 
+ * In indexed mode the atlas stores raw color indices (one byte per pixel)
+ * instead of RGBA and is colored at draw time by PaletteShader, so palette
+ * changes never require rewriting tiles.
+ * 
+ * Usage:
+ *   TileAtlas atlas;
+ *   atlas.Initialize(16, 24);  // 128x192 texture, 384 tiles
+ *   atlas.WriteTile(slot, pixelData, palette);
+ *   unsigned int tex = atlas.Upload();
+ *   atlas.GetTileUV(slot, u0, v0, u1, v1);
+ */
+class TileAtlas {
+public:
+    TileAtlas();
+    ~TileAtlas();
+    
+    /**
+     * Initialize the atlas texture and its CPU-side staging buffer
+     * 
+     * @param tileCols Number of tiles per atlas row
+     * @param tileRows Number of tile rows in the atlas
+     * @param indexed true to store 8-bit color indices instead of RGBA
+     */
+    void Initialize(int tileCols, int tileRows, bool indexed = false);
+    
+    /**
+     * Reinitialize if the atlas dimensions or format changed
+     * 
+     * @return true if reinitialization occurred
+     */
+    bool ReinitializeIfNeeded(int tileCols, int tileRows, bool indexed = false);
+    
+    /**
+     * Write a tile into the staging buffer (no GPU work)
+     * 
+     * @param slot Tile slot in the atlas (row-major, 0-based)
+     * @param pixelData 8x8 array of color indices (0-3)
+     * @param palette Palette containing 4 colors (ignored in indexed mode)
+     */
+    void WriteTile(
+        int slot,
+        const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+        const Palette& palette
+    );
+    
+    /**
+     * Replace the whole staging buffer with an RGBA image (no GPU work)
+     * 
+     * @param rgba tileCols * 8 by tileRows * 8 pixels, 4 bytes each
+     *             (ignored in indexed mode)
+     */
+    void WriteImage(const uint8_t* rgba);
+    
+    /**
+     * Upload pending changes to the GPU
+     * 
+     * Issues at most one glTexSubImage2D covering the dirty row band.
+     * 
+     * @return OpenGL texture ID for use with ImGui::Image()
+     */
+    unsigned int Upload();
+    
+    /**
+     * Get the texture coordinates of a tile slot
+     * 
+     * @param slot Tile slot in the atlas
+     * @param u0 Left texture coordinate
+     * @param v0 Top texture coordinate
+     * @param u1 Right texture coordinate
+     * @param v1 Bottom texture coordinate
+     */
+    void GetTileUV(int slot, float& u0, float& v0, float& u1, float& v1) const;
+    
+    /**
+     * Get the atlas texture ID
+     */
+    unsigned int GetTexture() const { return texture_; }
+    
+    /**
+     * Check if the atlas is initialized
+     */
+    bool IsInitialized() const { return initialized_; }
+    
+    /**
+     * Check if the atlas stores color indices rather than RGBA
+     */
+    bool IsIndexed() const { return indexed_; }
+    
+    /**
+     * Get the number of tile slots in the atlas
+     */
+    int GetTileCount() const { return tileCols_ * tileRows_; }
+    
+    /**
+     * Delete the texture and release the staging buffer
+     */
+    void Clear();
+
+private:
+    unsigned int texture_;
+    std::vector<uint8_t> pixels_;  // Staging buffer (width x height x bytes per pixel)
+    int tileCols_;
+    int tileRows_;
+    int dirtyMinRow_;              // First tile row written since last upload
+    int dirtyMaxRow_;              // Last tile row written since last upload (-1 = clean)
+    bool indexed_;                 // 1 byte per pixel color indices instead of RGBA
+    bool initialized_;
+};
+
 /**
  * TileRenderer - Manages OpenGL textures for tile display in the VRAM viewer
  * 
@@ -116,7 +238,10 @@ private:
  * to RGBA textures using the provided palette.
  * 
  * Key features:
- * - Uses TexturePool for fixed-size grids (tile grid, sprite grid, inspector)
+ * - Uses a TileAtlas for the tile grid (one texture, one upload per frame)
+ * - Optional GPU palette lookup: indexed atlas + PaletteShader, so palette
+ *   changes cost one 4x16 texture upload instead of re-rendering tiles
+ * - Uses TexturePool for fixed-size grids (sprite grid, inspector)
  * - Supports scaling tiles for display (default 2x = 16x16 pixels)
  * - Updates existing textures in-place rather than creating new ones
  * - Provides separate pools for tile grid, sprites, and inspector views
@@ -126,12 +251,14 @@ private:
  * 
  * Usage:
  *   TileRenderer renderer;
- *   // Initialize pools for your grid sizes
- *   renderer.InitializeTileGridPool(24, 16, 2);  // 384 tiles, 16 per row
+ *   // Initialize the atlas for your grid size
+ *   renderer.InitializeTileAtlas(16, 24);  // 384 tiles, 16 per row
  *   
- *   // Render a tile at a grid position (updates existing texture)
- *   unsigned int texture = renderer.RenderTileAt(row, col, pixelData, palette);
- *   // Use texture with ImGui::Image()
+ *   // Write tiles into the atlas, then upload once
+ *   renderer.RenderTileToAtlas(slot, pixelData, palette);
+ *   unsigned int texture = renderer.UploadTileAtlas();
+ *   renderer.GetAtlasTileUV(slot, u0, v0, u1, v1);
+ *   // Use texture and UVs with ImGui::Image()
  *   
  *   // Cleanup when done
  *   renderer.ClearTextures();
@@ -163,8 +290,9 @@ public:
      * 
      * @param maxSprites Maximum number of sprites (typically 40)
      * @param scale Scale factor for sprites
+     * @return true if the textures were (re)created
      */
-    void InitializeSpritePool(int maxSprites, int scale);
+    bool InitializeSpritePool(int maxSprites, int scale);
     
     /**
      * Initialize the inspector texture pool
@@ -175,13 +303,86 @@ public:
      */
     void InitializeInspectorPool(int scale);
     
-    // ========== Grid-Based Rendering (Preferred) ==========
+    /**
+     * Initialize the tile atlas
+     * 
+     * Creates one texture large enough for tileCols x tileRows tiles at 1:1
+     * scale (e.g. 16 x 24 = 128x192 for one VRAM bank, 16 x 48 = 128x384
+     * for both CGB banks). Will reinitialize if parameters change.
+     * 
+     * @param tileCols Number of tiles per atlas row (typically 16)
+     * @param tileRows Number of tile rows
+     * @param indexed true to store color indices for GPU palette lookup
+     * @return true if the atlas was (re)created and its contents are undefined
+     */
+    bool InitializeTileAtlas(int tileCols, int tileRows, bool indexed = false);
+    
+    /**
+     * Check (and lazily set up) GPU palette lookup support
+     * 
+     * Requires a current OpenGL context. When this returns false, use an
+     * RGBA atlas instead.
+     * 
+     * @return true if indexed atlases can be drawn with palette lookup
+     */
+    bool IsPaletteLookupAvailable();
+    
+    // ========== Atlas-Based Rendering (Preferred for tile grid) ==========
+    
+    /**
+     * Write a tile into the atlas staging buffer
+     * 
+     * No GPU work is done until UploadTileAtlas() is called.
+     * 
+     * @param slot Tile slot in the atlas
+     * @param pixelData 8x8 array of color indices (0-3)
+     * @param palette Palette containing 4 colors for mapping indices
+     */
+    void RenderTileToAtlas(
+        int slot,
+        const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+        const Palette& palette
+    );
+    
+    /**
+     * Upload all tiles written since the last upload in a single call
+     * 
+     * @return OpenGL texture ID of the atlas for use with ImGui::Image()
+     */
+    unsigned int UploadTileAtlas();
+    
+    /**
+     * Get the texture coordinates of a tile slot in the atlas
+     */
+    void GetAtlasTileUV(int slot, float& u0, float& v0, float& u1, float& v1) const;
+    
+    /**
+     * Upload palettes used by GPU palette lookup (only if they changed)
+     * 
+     * @param bgPalettes Pointer to 8 background palettes
+     * @param spritePalettes Pointer to 8 sprite palettes
+     */
+    void UpdateLookupPalettes(const Palette* bgPalettes, const Palette* spritePalettes);
+    
+    /**
+     * Start drawing indexed atlas tiles with a palette (current ImGui window)
+     * 
+     * @param paletteRow 0-7 for background palettes, 8-15 for sprite palettes
+     */
+    void BeginPaletteLookup(int paletteRow);
+    
+    /**
+     * Return to normal ImGui drawing after BeginPaletteLookup()
+     */
+    void EndPaletteLookup();
+    
+    // ========== Grid-Based Rendering ==========
     
     /**
      * Render a tile at a specific grid position
      * 
      * Updates the texture at the given grid position with new pixel data.
-     * This is the preferred method for rendering tiles in the grid view.
+     * Prefer the atlas methods for large grids; this issues one upload per tile.
      * 
      * @param row Row index in the tile grid
      * @param col Column index in the tile grid
@@ -280,6 +481,26 @@ public:
      * Get the number of cached textures
      */
     size_t GetCacheSize() const;
+    
+    /**
+     * Convert tile pixel data to scaled RGBA pixels
+     * 
+     * Writes (8 * scale) x (8 * scale) RGBA pixels into caller-provided
+     * storage without allocating. Each output row is built once from packed
+     * 32-bit colors and then replicated with memcpy for the remaining
+     * scale - 1 rows.
+     * 
+     * @param pixelData 8x8 array of color indices (0-3, larger values clamp to 3)
+     * @param palette Palette containing 4 colors for mapping indices
+     * @param scale Scale factor (>= 1)
+     * @param out Output buffer of at least (8 * scale)^2 * 4 bytes
+     */
+    static void ConvertToRGBA(
+        const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+        const Palette& palette,
+        int scale,
+        uint8_t* out
+    );
 
 private:
     /**
@@ -293,16 +514,24 @@ private:
     void UpdateTexture(unsigned int texture, const uint8_t* data, int width, int height);
     
     /**
-     * Convert tile pixel data to RGBA buffer
+     * Convert tile pixel data into the renderer's scratch buffer
+     * 
+     * @return Pointer to (8 * scale)^2 RGBA pixels, valid until the next call
      */
-    std::vector<uint8_t> ConvertToRGBA(
+    const uint8_t* ConvertToScratch(
         const std::array<std::array<uint8_t, 8>, 8>& pixelData,
         const Palette& palette,
         int scale
     );
     
+    // Texture atlas for the main tile grid (all tiles in one texture)
+    TileAtlas tileAtlas_;
+    
+    // GPU palette lookup for indexed atlases
+    PaletteShader paletteShader_;
+    
     // Texture pools for different views
-    TexturePool tileGridPool_;      // Main tile grid (24 rows x 16 cols for 384 tiles)
+    TexturePool tileGridPool_;      // Per-tile grid textures (legacy path)
     TexturePool spritePool_;        // Sprite display (40 sprites, 2 textures each for 8x16)
     TexturePool inspectorPool_;     // Inspector view (1 texture at larger scale)
     
@@ -310,7 +539,7 @@ private:
     std::unordered_map<int, unsigned int> tileTextures_;
     std::unordered_map<int, bool> dirtyFlags_;
     
-    // Reusable buffer for texture data to avoid allocations
+    // Reusable scratch buffer for texture data (grows once, never shrinks)
     std::vector<uint8_t> textureBuffer_;
     
     // Current scale factor (cached for consistency)
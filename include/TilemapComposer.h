@@ -0,0 +1,112 @@
+#ifndef TILEMAP_COMPOSER_H
+#define TILEMAP_COMPOSER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bitset>
+
+namespace GBDebug {
+
+/**
+ * TilemapCell - One resolved 8x8 cell of a 32x32 tilemap
+ */
+struct TilemapCell {
+    uint16_t tile;       // Tile number in its bank (0-383), addressing mode applied
+    uint8_t bank;        // VRAM bank of the tile data (CGB attribute bit 3)
+    uint8_t palette;     // BG palette (CGB attribute bits 0-2)
+    bool hFlip;          // CGB attribute bit 5
+    bool vFlip;          // CGB attribute bit 6
+    bool priority;       // CGB attribute bit 7: BG over sprites
+
+    TilemapCell() : tile(0), bank(0), palette(0), hFlip(false), vFlip(false), priority(false) {}
+};
+
+/**
+ * TilemapComposer - Tracks which cells of a BG/window tilemap need redrawing
+ *
+ * Resolves each of the 1024 map entries at $9800 or $9C00 to a tile using
+ * the LCDC tile data addressing mode ($8000 unsigned or $8800 signed) and,
+ * when VRAM bank 1 is given, the CGB attribute byte of the cell.
+ *
+ * Update() keeps shadow copies of the tile data, map and attribute bytes
+ * and marks a cell dirty only when its map entry, its attributes or the 16
+ * bytes of the tile it shows changed. Dirty cells accumulate until
+ * ClearDirty(), so a caller can redraw exactly those cells into a 256x256
+ * image with DecodeCell().
+ *
+ * Usage:
+ *   TilemapComposer composer;
+ *   composer.Update(vram0, vram1, lcdc, highMap);
+ *   for each cell set in composer.GetDirtyCells():
+ *       composer.DecodeCell(cell, pixels);   // flips applied
+ *       draw pixels with palette composer.GetCell(cell).palette
+ *   composer.ClearDirty();
+ */
+class TilemapComposer {
+public:
+    static constexpr int MAP_SIZE = 32;
+    static constexpr int CELL_COUNT = MAP_SIZE * MAP_SIZE;
+    static constexpr int TILES_PER_BANK = 384;
+
+    typedef std::array<std::array<uint8_t, 8>, 8> CellPixels;
+
+    TilemapComposer();
+
+    /**
+     * Compare VRAM with the last update and mark changed cells dirty
+     * @param vram0 8KB VRAM bank 0 ($8000-$9FFF)
+     * @param vram1 8KB VRAM bank 1, or nullptr to ignore attributes (DMG)
+     * @param lcdc LCDC register (bit 4 selects the tile data addressing)
+     * @param highMap true for the map at $9C00, false for $9800
+     * @return Number of cells newly marked dirty
+     */
+    size_t Update(const uint8_t* vram0, const uint8_t* vram1, uint8_t lcdc, bool highMap);
+
+    /**
+     * Mark every cell dirty (e.g. after a palette change)
+     */
+    void Invalidate();
+
+    const std::bitset<CELL_COUNT>& GetDirtyCells() const { return dirty_; }
+
+    void ClearDirty() { dirty_.reset(); }
+
+    /**
+     * Resolved tile and attributes of a cell as of the last Update()
+     * @param cell Row-major cell index (0-1023)
+     */
+    const TilemapCell& GetCell(int cell) const { return cells_[cell]; }
+
+    /**
+     * Decode a cell's tile into color indices with its flips applied
+     */
+    void DecodeCell(int cell, CellPixels& out) const;
+
+    /**
+     * Resolve a map byte to a tile number for an addressing mode
+     * @param unsignedMode true for $8000 addressing (LCDC bit 4 set)
+     */
+    static uint16_t ResolveTile(uint8_t mapByte, bool unsignedMode) {
+        return unsignedMode ? mapByte : static_cast<uint16_t>(256 + static_cast<int8_t>(mapByte));
+    }
+
+private:
+    static constexpr size_t TILE_DATA_SIZE = TILES_PER_BANK * 16;
+    static constexpr size_t MAP_9800 = 0x1800;
+    static constexpr size_t MAP_9C00 = 0x1C00;
+
+    std::array<std::array<uint8_t, TILE_DATA_SIZE>, 2> tiles_;   // Tile data shadow per bank
+    std::array<uint8_t, CELL_COUNT> map_;
+    std::array<uint8_t, CELL_COUNT> attributes_;
+    std::array<TilemapCell, CELL_COUNT> cells_;
+    std::bitset<CELL_COUNT> dirty_;
+    bool hasShadow_;
+    bool unsignedMode_;
+    bool highMap_;
+    bool hasAttributes_;
+};
+
+} // namespace GBDebug
+
+#endif // TILEMAP_COMPOSER_H
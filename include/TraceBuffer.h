@@ -0,0 +1,134 @@
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+namespace GBDebug {
+
+/**
+ * TraceRecord - One executed instruction, 16 bytes
+ *
+ * SP is not recorded to keep records at 16 bytes; the cycle count is
+ * truncated to 32 bits (about 17 minutes of DMG time before it wraps).
+ */
+struct alignas(16) TraceRecord {
+    uint32_t cycle;    // Low 32 bits of the cycle count
+    uint16_t pc;
+    uint16_t af;
+    uint16_t bc;
+    uint16_t de;
+    uint16_t hl;
+    uint8_t opcode;
+    uint8_t bank;      // Low byte of the ROM bank mapped at $4000-$7FFF
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes");
+
+/**
+ * TraceBuffer - Execution trace in a preallocated power-of-two ring
+ *
+ * Record() is a handful of stores: the slot is picked by masking a
+ * free-running counter, the oldest record is overwritten without any check
+ * for fullness, and the counter is published with a release store. A
+ * release fence before the slot stores keeps them behind the previous
+ * publish on weakly ordered CPUs. With no capacity set, records go to a
+ * single scratch slot, so the producer never branches either way.
+ *
+ * One producer (the emulator thread) may record while readers call Read();
+ * a reader that races with the producer overwriting a slot gets false
+ * rather than a torn record.
+ *
+ * Usage:
+ *   TraceBuffer trace;
+ *   trace.SetCapacity(1 << 20);   // before the producer starts
+ *   trace.Record(pc, opcode, af, bc, de, hl, cycle, bank);
+ *   TraceRecord record;
+ *   if (trace.Read(trace.GetTotal() - 1, record)) { newest instruction }
+ */
+class TraceBuffer {
+public:
+    TraceBuffer();
+
+    /**
+     * Allocate the ring and clear it
+     * Must not be called while Record() may run on another thread.
+     * @param records Capacity, rounded up to a power of two; 0 disables tracing
+     */
+    void SetCapacity(size_t records);
+
+    /**
+     * Get the ring capacity in records (0 = tracing disabled)
+     */
+    size_t GetCapacity() const { return capacity_; }
+
+    /**
+     * Producer: append one instruction, overwriting the oldest when full
+     */
+    void Record(uint16_t pc, uint8_t opcode, uint16_t af, uint16_t bc,
+                uint16_t de, uint16_t hl, uint64_t cycle, int bank) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        
+        // Seqlock writer: the previous head_ store must be visible before
+        // any store into this slot, or a reader could validate a torn copy
+        // against the old head. Free on x86, one barrier on ARM.
+        std::atomic_thread_fence(std::memory_order_release);
+        TraceRecord& record = ring_[head & mask_];
+        record.cycle = static_cast<uint32_t>(cycle);
+        record.pc = pc;
+        record.af = af;
+        record.bc = bc;
+        record.de = de;
+        record.hl = hl;
+        record.opcode = opcode;
+        record.bank = static_cast<uint8_t>(bank);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * Total number of instructions recorded; the newest has index total - 1
+     */
+    uint64_t GetTotal() const { return head_.load(std::memory_order_acquire); }
+
+    /**
+     * Index of the oldest readable record for a given total
+     * One slot is kept for the record being written, so at most
+     * capacity - 1 records are readable.
+     */
+    uint64_t GetOldest(uint64_t total) const {
+        if (capacity_ == 0) {
+            return total;
+        }
+        return total >= capacity_ ? total - capacity_ + 1 : 0;
+    }
+
+    /**
+     * Copy out the record with a given index
+     * @return false if it was never written, has been overwritten, or was
+     *         being overwritten while it was copied
+     */
+    bool Read(uint64_t index, TraceRecord& out) const;
+
+    /**
+     * Drop all records
+     * Must not be called while Record() may run on another thread.
+     */
+    void Clear();
+
+private:
+    std::unique_ptr<TraceRecord[]> storage_;
+    TraceRecord* ring_;            // storage_ or &scratch_
+    uint64_t mask_;
+    size_t capacity_;
+    TraceRecord scratch_;          // Sink for records while disabled
+    std::atomic<uint64_t> head_;   // Records ever written
+
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+};
+
+} // namespace GBDebug
+
+#endif // TRACE_BUFFER_H
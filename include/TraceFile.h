@@ -0,0 +1,270 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include "DebuggerTypes.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * TraceFileRecord - One instruction as stored in a trace file
+ */
+struct TraceFileRecord {
+    CPUState state;     // Registers and cycle before the instruction executes
+    uint8_t opcode;     // First opcode byte (0xCB for prefixed instructions)
+
+    TraceFileRecord() : opcode(0) {}
+};
+
+/*
+ * Trace file format (version 1, all integers little-endian)
+ *
+ * File header, 16 bytes:
+ *   char[8]  magic "GBTRACE\0"
+ *   uint32   version (1)
+ *   uint32   reserved (0)
+ *
+ * Followed by blocks until end of file. Each block is a 48-byte header
+ * and a payload:
+ *   uint32   magic "TBLK"
+ *   uint32   payload size in bytes
+ *   uint32   record count (at least 1)
+ *   uint64   cycle of the first record
+ *   uint64   cycle of the last record
+ *   uint16   pc, sp, af, bc, de, hl of the first record
+ *   uint8    opcode of the first record
+ *   uint8    ime of the first record (0 or 1)
+ *   uint8[6] reserved (0)
+ *
+ * The header holds the first record in full, so every block decodes on
+ * its own. The payload encodes records 1..count-1, each relative to the
+ * record before it:
+ *   uint8    tag: bit 0-4 = AF, BC, DE, HL, SP changed; bit 5 = IME
+ *            toggled; bit 6 = PC is not the fall-through address; bit 7 = 0
+ *   uint8    opcode
+ *   varint   cycle delta (unsigned LEB128)
+ *   varint   if bit 6: PC minus the fall-through address (zigzag LEB128),
+ *            where fall-through = previous pc + previous instruction length
+ *   uint16   new value of each changed register, in bit order
+ *
+ * A typical record is 3-5 bytes instead of the 24 a raw CPUState takes.
+ */
+
+/**
+ * TraceFileWriter - Streams instructions to a trace file on a background thread
+ *
+ * Append() copies the record into the current raw block; full blocks are
+ * handed to a writer thread that delta-encodes and writes them, so the
+ * caller never touches the file system. A small pool of blocks is
+ * recycled; if the disk cannot keep up, Append() waits for a free block
+ * rather than dropping instructions.
+ *
+ * Open() and Close() may run on another thread than Append(). Append()
+ * only touches the block while it holds the appending_ flag and sees
+ * open_ set. Close() clears open_ and then waits for the flag to drop
+ * before it takes the block back. That costs the producer one full
+ * barrier per record, and makes a concurrent Close() a clean cut.
+ *
+ * Usage:
+ *   TraceFileWriter writer;
+ *   writer.Open("soak.gbtrace", error);
+ *   writer.Append(cpuState, opcode);   // per instruction
+ *   writer.Close();                    // flushes the last partial block
+ */
+class TraceFileWriter {
+public:
+    static constexpr size_t BLOCK_RECORDS = 65536;
+    static constexpr size_t POOL_BLOCKS = 4;
+
+    TraceFileWriter();
+    ~TraceFileWriter();
+
+    /**
+     * Create the file and start the writer thread
+     * @return false with error set if the file cannot be created
+     */
+    bool Open(const std::string& path, std::string& error);
+
+    /**
+     * Flush pending blocks, stop the writer thread and close the file
+     * Waits for an Append() in progress on the producer thread.
+     * @return false if any write failed
+     */
+    bool Close();
+
+    bool IsOpen() const { return open_.load(std::memory_order_acquire); }
+
+    /**
+     * Append one instruction if the file is open (one producer thread)
+     */
+    void Append(const CPUState& state, uint8_t opcode) {
+        if (!open_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        appending_.store(true, std::memory_order_seq_cst);
+        if (open_.load(std::memory_order_seq_cst)) {
+            TraceFileRecord& record = current_->records[current_->count];
+            record.state = state;
+            record.opcode = opcode;
+            if (++current_->count == BLOCK_RECORDS) {
+                SubmitBlock();
+            }
+        }
+        appending_.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Records written to disk so far
+     */
+    uint64_t GetRecordsWritten() const { return recordsWritten_.load(std::memory_order_relaxed); }
+
+    /**
+     * Bytes written to disk so far, headers included
+     */
+    uint64_t GetBytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+
+    /**
+     * Check whether a write has failed since Open()
+     */
+    bool HasError() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    struct RawBlock {
+        std::vector<TraceFileRecord> records;
+        size_t count;
+
+        RawBlock() : records(BLOCK_RECORDS), count(0) {}
+    };
+
+    /**
+     * Queue the current block and take a free one
+     */
+    void SubmitBlock();
+
+    void WriterLoop();
+
+    /**
+     * Encode a raw block into header + payload and write it
+     */
+    bool WriteBlock(const RawBlock& block);
+
+    std::FILE* file_;                    // Owned by the Open()/Close() thread
+    std::atomic<bool> open_;             // Append() may use current_
+    std::atomic<bool> appending_;        // Producer is inside Append()
+    std::vector<std::unique_ptr<RawBlock>> pool_;
+    RawBlock* current_;                  // Producer's block
+    std::deque<RawBlock*> full_;         // Waiting to be written
+    std::deque<RawBlock*> free_;         // Ready for the producer
+    std::mutex mutex_;
+    std::condition_variable fullReady_;
+    std::condition_variable freeReady_;
+    bool stopping_;
+    std::thread thread_;
+    std::vector<uint8_t> encoded_;       // Writer thread scratch
+    std::atomic<uint64_t> recordsWritten_;
+    std::atomic<uint64_t> bytesWritten_;
+    std::atomic<bool> failed_;
+
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+};
+
+/**
+ * TraceFileReader - Random access to a trace file by record index or cycle
+ *
+ * The file is memory-mapped (read into memory where mmap is unavailable)
+ * and only block headers are scanned on open. Looking up a record decodes
+ * the one block containing it.
+ *
+ * Usage:
+ *   TraceFileReader reader;
+ *   if (reader.Open("soak.gbtrace", error)) {
+ *       uint64_t index = reader.FindCycle(123456789);
+ *       TraceFileRecord record;
+ *       reader.ReadRecord(index, record);
+ *   }
+ */
+class TraceFileReader {
+public:
+    TraceFileReader();
+    ~TraceFileReader();
+
+    /**
+     * Map a trace file and index its blocks
+     * A truncated final block (for example from a crash) is ignored.
+     */
+    bool Open(const std::string& path, std::string& error);
+
+    void Close();
+
+    /**
+     * Total number of records in the file
+     */
+    uint64_t GetRecordCount() const { return recordCount_; }
+
+    /**
+     * Number of blocks in the file
+     */
+    size_t GetBlockCount() const { return blocks_.size(); }
+
+    /**
+     * Index of the first record at or after a cycle
+     * @return GetRecordCount() if every record is earlier
+     */
+    uint64_t FindCycle(uint64_t cycle);
+
+    /**
+     * Read one record by index
+     */
+    bool ReadRecord(uint64_t index, TraceFileRecord& out);
+
+    /**
+     * Decode every record of one block
+     */
+    bool ReadBlock(size_t block, std::vector<TraceFileRecord>& out);
+
+private:
+    struct BlockInfo {
+        size_t offset;          // Header offset in the file
+        uint64_t firstRecord;   // Index of the block's first record
+        uint32_t count;
+        uint64_t firstCycle;
+        uint64_t lastCycle;
+    };
+
+    /**
+     * Find the block holding a record index
+     */
+    size_t FindBlock(uint64_t index) const;
+
+    /**
+     * Decode a block into decoded_ unless it is already there
+     */
+    bool LoadBlock(size_t block);
+
+    const uint8_t* data_;
+    size_t size_;
+    std::vector<uint8_t> buffer_;       // File contents when not mapped
+    bool mapped_;
+    std::vector<BlockInfo> blocks_;
+    uint64_t recordCount_;
+    std::vector<TraceFileRecord> decoded_;
+    size_t decodedBlock_;               // Block held in decoded_, or SIZE_MAX
+
+    TraceFileReader(const TraceFileReader&) = delete;
+    TraceFileReader& operator=(const TraceFileReader&) = delete;
+};
+
+} // namespace GBDebug
+
+#endif // TRACE_FILE_H
@@ -0,0 +1,162 @@
+#ifndef WATCHPOINT_MANAGER_H
+#define WATCHPOINT_MANAGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <mutex>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * WatchType - Which memory accesses a watchpoint reacts to
+ */
+enum class WatchType : uint8_t {
+    Read = 1,
+    Write = 2,
+    Access = 3   // Read or write
+};
+
+/**
+ * WatchCondition - Extra test applied to the accessed value
+ */
+enum class WatchCondition : uint8_t {
+    Always,        // Any matching access
+    ValueEquals,   // Accessed value equals Watchpoint::value
+    ValueChanged   // Accessed value differs from the last one seen at that address
+};
+
+/**
+ * Watchpoint - A memory watch over an inclusive address range
+ */
+struct Watchpoint {
+    uint16_t start;
+    uint16_t end;
+    WatchType type;
+    WatchCondition condition;
+    uint8_t value;         // Compared value for ValueEquals
+    bool enabled;
+    uint32_t hitCount;
+
+    Watchpoint()
+        : start(0), end(0), type(WatchType::Write), condition(WatchCondition::Always),
+          value(0), enabled(true), hitCount(0) {}
+};
+
+/**
+ * WatchHit - Details of the most recent watchpoint hit
+ */
+struct WatchHit {
+    uint16_t address;
+    uint8_t value;
+    bool isWrite;
+};
+
+/**
+ * WatchpointManager - Read/write watchpoints behind a per-page filter
+ *
+ * Each of the 256 memory pages has a flag byte with bit 0 set when any
+ * enabled watch covers a read in that page and bit 1 for writes. The
+ * per-access check tests one flag bit; only accesses to flagged pages go
+ * on to scan the watch list under the mutex.
+ *
+ * Usage:
+ *   WatchpointManager watches;
+ *   Watchpoint w; w.start = w.end = 0xC000; w.type = WatchType::Write;
+ *   watches.Add(w);
+ *   if (watches.MayHit(addr, isWrite) && watches.Check(addr, value, isWrite)) { stop }
+ */
+class WatchpointManager {
+public:
+    WatchpointManager();
+
+    static constexpr size_t PAGE_COUNT = 256;
+
+    /**
+     * Hot path: could a watch match this access?
+     * Page flag bit 0 = read watched, bit 1 = write watched.
+     */
+    bool MayHit(uint16_t address, bool isWrite) const {
+        return ((pageFlags_[address >> 8].load(std::memory_order_relaxed) >> (isWrite ? 1 : 0)) & 1) != 0;
+    }
+
+    /**
+     * Exact check for an access MayHit() flagged; counts and records hits
+     * @return true if an enabled watch matched
+     */
+    bool Check(uint16_t address, uint8_t value, bool isWrite);
+
+    /**
+     * Add a watchpoint (start and end are swapped if reversed)
+     * @param memory 64KB memory to seed "value changed" comparisons from,
+     *               so the first real change fires; nullptr = the first
+     *               access in the range only records the value
+     */
+    void Add(const Watchpoint& watch, const uint8_t* memory = nullptr);
+
+    /**
+     * Enable or disable the entry at a list index
+     */
+    void SetEnabled(size_t index, bool enabled);
+
+    /**
+     * Remove the entry at a list index
+     */
+    void RemoveAt(size_t index);
+
+    /**
+     * Remove all watchpoints and forget the values seen so far
+     */
+    void Clear();
+
+    /**
+     * Copy the current entries into out (reuses out's capacity)
+     */
+    void CopyWatchpoints(std::vector<Watchpoint>& out) const;
+
+    /**
+     * Get the most recent hit
+     * @return Hit counter (0 = no hit yet); changes on every hit
+     */
+    uint32_t GetLastHit(WatchHit& hit) const;
+
+    /**
+     * Number of hits so far; cheap to poll for "anything new?"
+     */
+    uint32_t GetHitSequence() const { return hitSequence_.load(std::memory_order_acquire); }
+
+    /**
+     * Get the flag array MayHit() reads, for callers that inline the test
+     */
+    const std::atomic<uint8_t>* GetPageFlags() const { return pageFlags_.data(); }
+
+private:
+    static constexpr uint8_t PAGE_READ = 0x01;
+    static constexpr uint8_t PAGE_WRITE = 0x02;
+
+    /**
+     * Recompute the page filter from entries_ (mutex must be held)
+     */
+    void RebuildPageFlags();
+
+    std::array<std::atomic<uint8_t>, PAGE_COUNT> pageFlags_;
+    std::vector<Watchpoint> entries_;
+
+    // Last value seen at each address that reached the slow path
+    std::array<uint8_t, 65536> lastValues_;
+    std::bitset<65536> lastKnown_;
+
+    WatchHit lastHit_;
+    std::atomic<uint32_t> hitSequence_;
+    mutable std::mutex mutex_;
+
+    WatchpointManager(const WatchpointManager&) = delete;
+    WatchpointManager& operator=(const WatchpointManager&) = delete;
+};
+
+} // namespace GBDebug
+
+#endif // WATCHPOINT_MANAGER_H
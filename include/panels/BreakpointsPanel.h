@@ -0,0 +1,83 @@
+#ifndef BREAKPOINTS_PANEL_H
+#define BREAKPOINTS_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "BreakpointManager.h"
+#include "WatchpointManager.h"
+#include "BreakCondition.h"
+#include <string>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * BreakpointsPanel - Add, remove and toggle PC breakpoints and watchpoints
+ * 
+ * Shows every breakpoint held by a BreakpointManager with its enabled state,
+ * address, ROM bank, condition and hit count, plus a form for adding new
+ * entries. Conditions are compiled as they are typed so errors show
+ * immediately; clicking a row edits its condition. The most recent hit is
+ * shown at the top. Memory watchpoints from a
+ * WatchpointManager are listed and edited in their own section.
+ * 
+ * Usage:
+ *   BreakpointsPanel panel(breakpointManager, watchpointManager);
+ *   panel.SetMemory(memory);   // seeds new "value changed" watches
+ *   panel.Render();
+ */
+class BreakpointsPanel : public IDebuggerPanel {
+public:
+    BreakpointsPanel(BreakpointManager& breakpoints, WatchpointManager& watchpoints);
+    ~BreakpointsPanel() override = default;
+    
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Breakpoints"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+    
+    /**
+     * Set the 64KB memory new watchpoints take their starting values from
+     */
+    void SetMemory(const uint8_t* memory) { memory_ = memory; }
+
+private:
+    void RenderAddForm();
+    void RenderConditionEditor();
+    void RenderWatchpoints();
+    
+    /**
+     * Compile text into the scratch condition to check it (empty is valid)
+     */
+    void ValidateCondition(const char* text, std::string& error);
+    
+    /**
+     * Show "OK" or the compile error under a condition input
+     */
+    static void RenderConditionStatus(const char* text, const std::string& error);
+    
+    BreakpointManager& breakpoints_;
+    WatchpointManager& watchpoints_;
+    std::vector<Breakpoint> entries_;   // Per-frame copy, capacity reused
+    std::vector<Watchpoint> watchEntries_;
+    char watchStartInput_[8];           // New watch range start (hex)
+    char watchEndInput_[8];             // New watch range end (hex, optional)
+    char watchValueInput_[4];           // Compared value (hex)
+    int watchType_;                     // Index into WatchType choices
+    int watchCondition_;                // Index into WatchCondition choices
+    char addressInput_[8];             // New breakpoint address (hex)
+    int bankInput_;                    // New breakpoint ROM bank
+    bool anyBank_;                     // New breakpoint matches every bank
+    char conditionInput_[128];         // New breakpoint condition
+    std::string conditionError_;       // Compile error for conditionInput_
+    int editIndex_;                    // Row whose condition is being edited, or -1
+    char editInput_[128];              // Condition text for editIndex_
+    std::string editError_;            // Compile error for editInput_
+    BreakCondition scratch_;           // Compile target for live validation
+    const uint8_t* memory_;            // Memory on display, or nullptr
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // BREAKPOINTS_PANEL_H
@@ -32,6 +32,11 @@ public:
      * Update the CPU state to display
      */
     void Update(const CPUState& state);
+    
+    /**
+     * Get the most recently displayed CPU state
+     */
+    const CPUState& GetState() const { return state_; }
 
 private:
     CPUState state_;
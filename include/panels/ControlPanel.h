@@ -2,6 +2,7 @@
 #define CONTROLPANEL_H
 
 #include "IDebuggerPanel.h"
+#include <atomic>
 
 namespace GBDebug {
 
@@ -12,6 +13,9 @@ namespace GBDebug {
  * the emulator execution. It communicates state changes back to the
  * main application through getter methods.
  * 
+ * Control state is held in atomics, so the emulator thread may poll and
+ * clear it while the UI thread renders the panel.
+ * 
  * Usage:
  *   panel.Render();
  *   if (panel.IsStepRequested()) { step }
@@ -29,14 +33,20 @@ public:
     void SetVisible(bool visible) override { visible_ = visible; }
     
     // State accessors
-    bool IsRunning() const { return running_; }
-    void SetRunning(bool running) { running_ = running; }
-    void ToggleRunning() { running_ = !running_; }
+    bool IsRunning() const { return running_.load(std::memory_order_relaxed); }
+    void SetRunning(bool running) { running_.store(running, std::memory_order_relaxed); }
+    void ToggleRunning();
+    
+    bool IsStepRequested() const { return step_requested_.load(std::memory_order_relaxed); }
+    void ClearStepRequest() { step_requested_.store(false, std::memory_order_relaxed); }
     
-    bool IsStepRequested() const { return step_requested_; }
-    void ClearStepRequest() { step_requested_ = false; }
+    /**
+     * Read and clear the step request in one operation, so a step requested
+     * between a separate check and clear is never lost
+     */
+    bool ConsumeStepRequest() { return step_requested_.exchange(false, std::memory_order_relaxed); }
     
-    bool IsExitRequested() const { return exit_requested_; }
+    bool IsExitRequested() const { return exit_requested_.load(std::memory_order_relaxed); }
     
     // Speed control: supports 1/8x, 1/4x, 1/2x, 1x, 2x, 4x, 8x
     // Returns multiplier as float (e.g., 0.125 for 1/8x, 8.0 for 8x)
@@ -44,14 +54,14 @@ public:
     void CycleSpeedUp();   // T: increases speed
     void CycleSpeedDown(); // Shift+T: decreases speed
     void SetSpeedIndex(int index);
-    int GetSpeedIndex() const { return speed_index_; }
+    int GetSpeedIndex() const { return speed_index_.load(std::memory_order_relaxed); }
 
 private:
     bool visible_;
-    bool running_;
-    bool step_requested_;
-    bool exit_requested_;
-    int speed_index_; // 0=1/8x, 1=1/4x, 2=1/2x, 3=1x, 4=2x, 5=4x, 6=8x
+    std::atomic<bool> running_;
+    std::atomic<bool> step_requested_;
+    std::atomic<bool> exit_requested_;
+    std::atomic<int> speed_index_; // 0=1/8x, 1=1/4x, 2=1/2x, 3=1x, 4=2x, 5=4x, 6=8x
     static constexpr int SPEED_COUNT = 7;
     static constexpr int SPEED_1X_INDEX = 3;
 };
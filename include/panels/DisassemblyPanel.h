@@ -0,0 +1,69 @@
+#ifndef DISASSEMBLY_PANEL_H
+#define DISASSEMBLY_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "Disassembler.h"
+#include "BreakpointManager.h"
+#include <cstdint>
+
+namespace GBDebug {
+
+/**
+ * DisassemblyPanel - Scrolling SM83 disassembly around PC
+ * 
+ * Lists the instructions of the 16KB region containing PC (or a chosen
+ * address), marks breakpoints and highlights the current instruction.
+ * Only the rows on screen are decoded, through a list clipper, and decodes
+ * come from the Disassembler's per-bank cache, so following PC at full
+ * emulation speed costs a handful of cache lookups per frame.
+ * 
+ * Usage:
+ *   1. Call Update() with the 64KB memory view and PC before Render()
+ *   2. Call SetROMBank() when the mapped ROM bank changes
+ *   3. Call Render() each frame to draw the panel
+ */
+class DisassemblyPanel : public IDebuggerPanel {
+public:
+    explicit DisassemblyPanel(const BreakpointManager& breakpoints);
+    ~DisassemblyPanel() override = default;
+    
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Disassembly"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+    
+    /**
+     * Set the memory to disassemble and the current PC
+     * @param memory Flat 64KB memory view, or nullptr if none is available
+     */
+    void Update(const uint8_t* memory, uint16_t pc);
+    
+    /**
+     * Set the ROM bank mapped at $4000-$7FFF
+     */
+    void SetROMBank(int bank) { bank_ = bank; }
+    
+    /**
+     * Access the disassembler (and its cache statistics)
+     */
+    const Disassembler& GetDisassembler() const { return disassembler_; }
+
+private:
+    void RenderRow(uint16_t address);
+    
+    const BreakpointManager& breakpoints_;
+    Disassembler disassembler_;
+    const uint8_t* memory_;
+    uint16_t pc_;
+    int bank_;
+    bool followPC_;              // Keep PC on screen as it moves
+    uint16_t viewAddress_;       // Region shown when not following PC
+    bool scrollPending_;         // Scroll the focus row into view this frame
+    char gotoInput_[8];          // Address to jump to (hex)
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // DISASSEMBLY_PANEL_H
@@ -0,0 +1,57 @@
+#ifndef HISTORY_PANEL_H
+#define HISTORY_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "StateHistory.h"
+#include <cstdint>
+
+namespace GBDebug {
+
+/**
+ * HistoryPanel - Timeline scrubber over the rewind history
+ * 
+ * Shows how much of the history budget is in use and a slider over every
+ * held step. Moving the slider (or the step buttons) raises a seek
+ * request, which GBDebugger polls and applies by reconstructing that step
+ * into the other panels.
+ * 
+ * Usage:
+ *   HistoryPanel panel(stateHistory);
+ *   panel.Render();
+ *   uint64_t cycle;
+ *   if (panel.ConsumeSeekRequest(cycle)) { seek to cycle }
+ */
+class HistoryPanel : public IDebuggerPanel {
+public:
+    explicit HistoryPanel(const StateHistory& history);
+    ~HistoryPanel() override = default;
+    
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "History"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+    
+    /**
+     * Check and clear a pending seek request
+     * @param cycle Receives the cycle of the selected step
+     * @return true if the user picked a step since the last call
+     */
+    bool ConsumeSeekRequest(uint64_t& cycle);
+
+private:
+    /**
+     * Select a step and raise a seek request for it
+     */
+    void RequestStep(int step);
+    
+    const StateHistory& history_;
+    int selectedStep_;
+    bool seekRequested_;
+    uint64_t seekCycle_;
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // HISTORY_PANEL_H
@@ -3,6 +3,10 @@
 
 #include "IDebuggerPanel.h"
 #include "DebuggerTypes.h"
+#include "MemoryHeatmap.h"
+#include "MemorySearch.h"
+#include <string>
+#include <vector>
 
 namespace GBDebug {
 
@@ -13,9 +17,26 @@ namespace GBDebug {
  * - Color-coded memory regions (ROM, VRAM, RAM, I/O, etc.)
  * - Hexadecimal and ASCII representation side by side
  * - Region headers showing address ranges
+ * - An alternative continuous 64KB view with jump-to-address
+ * - An optional change heatmap coloring bytes by how recently they
+ *   changed, with per-region change rates and the hottest addresses
+ * - Byte pattern / value / text search and cheat-style narrowing, with
+ *   results listed for jump-to
+ * 
+ * Hex rows are virtualized with ImGuiListClipper, so only rows that are
+ * actually visible get formatted, and formatting uses a byte-to-hex lookup
+ * table instead of snprintf.
+ * 
+ * Memory can either be copied in with Update() or borrowed with Borrow(),
+ * in which case Render() reads straight from the emulator's buffer and no
+ * copy is made until the user freezes a snapshot for comparison.
+ * 
+ * With the heatmap on, each new memory generation seen by Render() counts
+ * as one frame for MemoryHeatmap; with it off nothing is compared.
  * 
  * Usage:
- *   1. Call Update() with a 64KB memory buffer after each emulator step
+ *   1. Call Update() with a 64KB memory buffer after each emulator step,
+ *      or Borrow() once per step with the emulator's buffer and generation
  *   2. Call Render() each frame to draw the panel
  */
 class MemoryViewerPanel : public IDebuggerPanel {
@@ -36,13 +57,116 @@ public:
      * @return true if successful
      */
     bool Update(const uint8_t* buffer, size_t size);
+    
+    /**
+     * Display the emulator's memory in place instead of copying it
+     * 
+     * The buffer is read during Render() and must stay valid until the next
+     * Borrow(), Update() or Release() call.
+     * 
+     * @param buffer Pointer to 64KB memory buffer
+     * @param size Size of buffer (must be 65536)
+     * @param generation Counter the caller changes whenever memory changes
+     * @return true if successful
+     */
+    bool Borrow(const uint8_t* buffer, size_t size, uint64_t generation);
+    
+    /**
+     * Overwrite part of the owned memory copy
+     * Releases borrowed memory first, since the panel must own the bytes.
+     * 
+     * @param address First address to write
+     * @param data Bytes to write
+     * @param length Number of bytes (address + length must not exceed 65536)
+     * @return true if successful
+     */
+    bool UpdateRange(uint16_t address, const uint8_t* data, size_t length);
+    
+    /**
+     * Stop reading borrowed memory, keeping a copy of its last contents
+     */
+    void Release();
+    
+    /**
+     * Check whether the panel is currently reading borrowed memory
+     */
+    bool IsBorrowed() const { return memory_ != nullptr && memory_ != state_.buffer.data(); }
+    
+    /**
+     * Get the memory currently displayed (owned copy or borrowed), or nullptr
+     */
+    const uint8_t* GetMemory() const { return memory_; }
+    
+    /**
+     * Get the generation of the memory currently displayed
+     */
+    uint64_t GetGeneration() const { return generation_; }
+    
+    /**
+     * Highlight one byte and scroll the continuous view to it
+     * Used to point at watchpoint hits.
+     */
+    void HighlightAddress(uint16_t address);
+    
+    /**
+     * Turn the change heatmap on or off
+     * Turning it on starts from a fresh baseline.
+     */
+    void SetHeatmapEnabled(bool enabled);
+    
+    bool IsHeatmapEnabled() const { return heatmapEnabled_; }
+    
+    /**
+     * Get the change heatmap (meaningful while enabled)
+     */
+    const MemoryHeatmap& GetHeatmap() const { return heatmap_; }
 
 private:
     void RenderMemoryRegion(const MemoryRegion& region);
     void RenderIORegisters();
+    void RenderContinuousView();
+    void RenderSnapshotControls();
+    void RenderHeatmapControls();
+    void RenderHeatmapSummary();
+    void RenderSearch();
+    void RenderNarrowing();
+    
+    /**
+     * Clipped list of addresses with their current values; click to jump
+     */
+    void RenderAddressList(const char* id, const std::vector<uint16_t>& addresses);
     
-    MemoryState state_;
+    /**
+     * Draw one 16-byte hex/ASCII row as a single text item
+     * @param addr Address of the first byte in the row
+     * @param count Number of bytes in the row (1-16)
+     */
+    void RenderHexRow(uint32_t addr, int count);
+    
+    MemoryState state_;       // Owned copy (Update) or last borrowed contents
+    MemoryState frozen_;      // Snapshot taken with "Freeze" for comparison
+    const uint8_t* memory_;   // Memory being displayed: state_ or borrowed
+    uint64_t generation_;     // Generation of memory_
+    uint64_t frozenGeneration_;
     bool visible_;
+    bool continuousView_;     // Single 64KB view instead of region sections
+    char jumpInput_[8];       // Jump-to-address text field (hex)
+    int pendingJumpRow_;      // Row to scroll to on next render (-1 = none)
+    int highlightAddress_;    // Address highlighted after a jump (-1 = none)
+    
+    MemoryHeatmap heatmap_;
+    bool heatmapEnabled_;
+    uint64_t heatmapGeneration_;   // Generation last fed to heatmap_
+    int heatmapFadeFrames_;        // Ages shown as "recent"
+    std::vector<uint16_t> hottest_;
+    
+    MemorySearch search_;
+    int searchMode_;                       // SearchMode as int for radio buttons
+    char searchInput_[128];
+    std::string searchError_;
+    std::vector<uint16_t> searchResults_;
+    std::vector<uint16_t> candidates_;     // Listed narrowing candidates
+    int narrowValue_;                      // Byte for "Equals value" (0-255)
 };
 
 } // namespace GBDebug
@@ -0,0 +1,51 @@
+#ifndef SCANLINE_PANEL_H
+#define SCANLINE_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "ScanlineTimeline.h"
+#include <cstdint>
+#include <array>
+
+namespace GBDebug {
+
+/**
+ * ScanlinePanel - LCD register values graphed against LY
+ *
+ * Plots each selected register over the 154 lines of the last latched
+ * frame, so mid-frame writes (scroll splits, palette changes) show up as
+ * steps in the graph. Below the graphs, every line where a register
+ * differs from the line before is listed.
+ *
+ * Usage:
+ *   ScanlinePanel panel(scanlineTimeline);
+ *   panel.Render();
+ */
+class ScanlinePanel : public IDebuggerPanel {
+public:
+    explicit ScanlinePanel(const ScanlineTimeline& timeline);
+    ~ScanlinePanel() override = default;
+
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Scanlines"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+
+private:
+    /**
+     * Rebuild the plot values from the timeline's frame
+     */
+    void RefreshValues();
+
+    void RenderChanges();
+
+    const ScanlineTimeline& timeline_;
+    std::array<std::array<float, ScanlineTimeline::LINE_COUNT>, ScanlineTimeline::REGISTER_COUNT> values_;
+    std::array<bool, ScanlineTimeline::REGISTER_COUNT> plotted_;
+    uint64_t shownGeneration_;   // Timeline generation values_ was built from
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // SCANLINE_PANEL_H
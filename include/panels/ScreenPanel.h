@@ -0,0 +1,99 @@
+#ifndef SCREEN_PANEL_H
+#define SCREEN_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "FrameCompositor.h"
+#include "TileRenderer.h"
+#include "PaletteManager.h"
+#include "panels/VRAMViewerPanel.h"
+#include <cstdint>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * ScreenPanel - The LCD image rebuilt from debugger state, beside the emulator's
+ *
+ * FrameCompositor renders the 160x144 frame from VRAM, OAM, palettes and
+ * the per-scanline registers. When the host supplies its own framebuffer
+ * (GBDebugger::UpdateFramebuffer()), it is shown next to the rebuilt frame
+ * and the two are compared pixel by pixel. Mismatches can be painted
+ * magenta over the emulator's image.
+ *
+ * The frame is only recomposed when the debugger state or the framebuffer
+ * changed, and never while the panel is hidden.
+ *
+ * Usage:
+ *   ScreenPanel panel;
+ *   panel.SetReference(framebuffer);   // optional, native pixel format
+ *   panel.Update(memory, vramBank1, bgPalettes, spritePalettes, mode, &scanlines, generation);
+ *   panel.Render();
+ */
+class ScreenPanel : public IDebuggerPanel {
+public:
+    ScreenPanel();
+    ~ScreenPanel() override = default;
+
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Screen"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+
+    /**
+     * Set the emulator's framebuffer to compare against
+     * @param pixels FrameCompositor::PIXEL_COUNT pixels: DMG shades or CGB RGB555
+     */
+    void SetReference(const uint16_t* pixels);
+
+    /**
+     * Recompose the frame if the state changed (does nothing while hidden)
+     *
+     * @param memory Flat 64KB memory
+     * @param vramBank1 8KB VRAM bank 1 (CGB only)
+     * @param bgPalettes 8 CGB background palettes
+     * @param spritePalettes 8 CGB sprite palettes
+     * @param mode DMG or CGB rendering rules
+     * @param scanlines Per-line registers, or nullptr
+     * @param generation Changes whenever any of the above changed
+     */
+    void Update(const uint8_t* memory, const uint8_t* vramBank1,
+                const CGBPalette* bgPalettes, const CGBPalette* spritePalettes,
+                EmulationMode mode, const ScanlineTimeline* scanlines, uint64_t generation);
+
+    /**
+     * Access the compositor (last frame and comparison)
+     */
+    const FrameCompositor& GetCompositor() const { return compositor_; }
+
+private:
+    /**
+     * Convert native pixels to RGBA in rgba_, optionally marking mismatches
+     */
+    void ConvertToRGBA(const uint16_t* pixels, bool markMismatches);
+
+    /**
+     * Rebuild both textures' staging images after a compose or comparison
+     */
+    void RefreshImages();
+
+    void RenderPixelTooltip(float originX, float originY, float scale);
+
+    FrameCompositor compositor_;
+    PaletteManager paletteManager_;
+    TileAtlas screenAtlas_;
+    TileAtlas referenceAtlas_;
+    std::vector<uint8_t> rgba_;           // Conversion scratch
+    FrameCompositor::Frame reference_;
+    bool hasReference_;
+    bool referenceChanged_;
+    bool imagesDirty_;
+    bool composed_;
+    uint64_t composedGeneration_;
+    bool showDiff_;
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // SCREEN_PANEL_H
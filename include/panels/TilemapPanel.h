@@ -0,0 +1,112 @@
+#ifndef TILEMAP_PANEL_H
+#define TILEMAP_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "TilemapComposer.h"
+#include "TileRenderer.h"
+#include "PaletteManager.h"
+#include "ScanlineTimeline.h"
+#include "panels/VRAMViewerPanel.h"
+#include <cstdint>
+#include <array>
+
+namespace GBDebug {
+
+/**
+ * TilemapPanel - The 32x32 BG/window tilemaps as one 256x256 image
+ * 
+ * Cells are drawn into a 32x32-tile RGBA TileAtlas, which is the CPU-side
+ * 256x256 buffer, and uploaded with one texture update per frame covering
+ * only the rows that changed. TilemapComposer decides which cells changed
+ * (tile bytes, map entry or CGB attributes); a palette, mode or map change
+ * redraws all of them.
+ * 
+ * The SCX/SCY viewport (wrapping at the map edges) and the visible window
+ * area from WX/WY are drawn on top, along with optional grid lines and the
+ * CGB BG-priority cells. With a recorded scanline frame the overlays follow
+ * each line's registers, so scroll splits and moving windows show up as
+ * separate strips; otherwise every line uses the registers in memory.
+ * 
+ * Usage:
+ *   TilemapPanel panel;
+ *   panel.Update(memory, vramBank1, bgPalettes, mode, &scanlines);   // per frame
+ *   panel.Render();
+ */
+class TilemapPanel : public IDebuggerPanel {
+public:
+    TilemapPanel();
+    ~TilemapPanel() override = default;
+    
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Tilemap"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+    
+    /**
+     * Set the state to show (does nothing while the panel is hidden)
+     * 
+     * @param memory Flat 64KB memory (VRAM bank 0 and the LCD registers)
+     * @param vramBank1 8KB VRAM bank 1 (used in CGB mode only)
+     * @param bgPalettes 8 CGB background palettes
+     * @param mode DMG uses BGP for shades; CGB uses attributes and palettes
+     * @param scanlines Per-line registers for the overlays, or nullptr
+     */
+    void Update(const uint8_t* memory, const uint8_t* vramBank1,
+                const CGBPalette* bgPalettes, EmulationMode mode,
+                const ScanlineTimeline* scanlines = nullptr);
+
+private:
+    /**
+     * Redraw the composer's dirty cells into the atlas
+     */
+    void ComposeDirtyCells();
+    
+    /**
+     * Draw the grid, priority cells and viewport/window strips
+     */
+    void RenderOverlays(float originX, float originY, float scale);
+    
+    /**
+     * Outline the map area each visible line shows, merging lines with the
+     * same scroll/window registers into one strip
+     */
+    void RenderViewport(float originX, float originY, float scale);
+    
+    void RenderCellTooltip(float originX, float originY, float scale);
+    
+    /**
+     * Outline a rectangle of map pixels, split where it wraps past 256
+     */
+    void DrawWrappedRect(float originX, float originY, float scale, int x, int y,
+                         int width, int height, uint32_t color);
+    
+    /**
+     * Which map is shown: 0 = BG (LCDC bit 3), 1 = window (LCDC bit 6),
+     * 2 = $9800, 3 = $9C00
+     */
+    bool IsHighMapSelected() const;
+    
+    TilemapComposer composer_;
+    TileAtlas atlas_;
+    PaletteManager paletteManager_;
+    std::array<Palette, 8> palettes_;     // Palettes the atlas was drawn with
+    std::array<ScanlineRegisters, ScanlineTimeline::VISIBLE_LINES> lines_;   // Registers per visible line
+    
+    const uint8_t* memory_;
+    uint8_t lcdc_;
+    uint8_t scx_;
+    uint8_t scy_;
+    uint8_t wx_;
+    uint8_t wy_;
+    int mapSelect_;
+    bool showViewport_;
+    bool showGrid_;
+    bool showPriority_;
+    bool cgb_;
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // TILEMAP_PANEL_H
@@ -0,0 +1,60 @@
+#ifndef TRACE_PANEL_H
+#define TRACE_PANEL_H
+
+#include "IDebuggerPanel.h"
+#include "TraceBuffer.h"
+#include "TraceFile.h"
+#include <cstdint>
+#include <vector>
+
+namespace GBDebug {
+
+/**
+ * TracePanel - Scrollable view of the execution trace
+ * 
+ * Shows every record held by a TraceBuffer (millions of rows) through a
+ * list clipper, so only the rows on screen are read each frame. With
+ * Follow on the view sticks to the newest instruction; otherwise it stays
+ * on the records it showed when Follow was turned off, until they are
+ * overwritten. A PC range / opcode filter scans the buffer once and lists
+ * the matching records. The status of trace file streaming is shown on top.
+ * 
+ * Usage:
+ *   TracePanel panel(traceBuffer, traceFileWriter);
+ *   panel.Render();
+ */
+class TracePanel : public IDebuggerPanel {
+public:
+    TracePanel(const TraceBuffer& trace, const TraceFileWriter& file);
+    ~TracePanel() override = default;
+    
+    // IDebuggerPanel interface
+    void Render() override;
+    const char* GetName() const override { return "Trace"; }
+    bool IsVisible() const override { return visible_; }
+    void SetVisible(bool visible) override { visible_ = visible; }
+
+private:
+    void RenderFilter();
+    void RenderRow(uint64_t index);
+    
+    /**
+     * Scan the held records into matches_ using the current filter inputs
+     */
+    void ApplyFilter();
+    
+    const TraceBuffer& trace_;
+    const TraceFileWriter& file_;
+    bool followTail_;                // Track the newest record
+    uint64_t viewTotal_;             // Record count the view is pinned to
+    char pcFromInput_[8];            // Filter: first PC (hex)
+    char pcToInput_[8];              // Filter: last PC (hex, optional)
+    char opcodeInput_[4];            // Filter: opcode (hex, optional)
+    bool filterActive_;
+    std::vector<uint64_t> matches_;  // Record indices passing the filter
+    bool visible_;
+};
+
+} // namespace GBDebug
+
+#endif // TRACE_PANEL_H
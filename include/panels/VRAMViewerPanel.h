@@ -4,6 +4,7 @@
 #include "IDebuggerPanel.h"
 #include <cstdint>
 #include <array>
+#include <bitset>
 #include <memory>
 
 namespace GBDebug {
@@ -12,6 +13,8 @@ namespace GBDebug {
 class TileDecoder;
 class TileRenderer;
 class PaletteManager;
+class SpriteOccupancy;
+class SpriteParser;
 
 /**
  * EmulationMode - Specifies the Game Boy hardware mode
@@ -171,6 +174,17 @@ public:
      */
     bool UpdateVRAM(const uint8_t* buffer, size_t size, uint8_t bank);
     
+    /**
+     * Update part of a VRAM bank, marking only the touched tiles dirty
+     * 
+     * @param offset Offset into the bank (0-8191)
+     * @param data Bytes to write
+     * @param length Number of bytes (offset + length must not exceed 8192)
+     * @param bank VRAM bank (0 or 1, only 0 used in DMG mode)
+     * @return true if update successful, false on error
+     */
+    bool UpdateVRAMRange(size_t offset, const uint8_t* data, size_t length, uint8_t bank);
+    
     /**
      * Update OAM (Object Attribute Memory) contents
      * 
@@ -180,6 +194,16 @@ public:
      */
     bool UpdateOAM(const uint8_t* buffer, size_t size);
     
+    /**
+     * Update part of OAM
+     * 
+     * @param offset Offset into OAM (0-159)
+     * @param data Bytes to write
+     * @param length Number of bytes (offset + length must not exceed 160)
+     * @return true if update successful, false on error
+     */
+    bool UpdateOAMRange(size_t offset, const uint8_t* data, size_t length);
+    
     /**
      * Update CGB color palettes
      * 
@@ -195,24 +219,145 @@ public:
      * @param mode EmulationMode::DMG or EmulationMode::CGB
      */
     void SetEmulationMode(EmulationMode mode);
+    
+    /**
+     * Get the emulation mode set by SetEmulationMode()
+     */
+    EmulationMode GetEmulationMode() const { return state_.mode; }
+    
+    /**
+     * Set the LCDC register (bit 2 selects 8x16 sprites)
+     */
+    void SetLCDC(uint8_t lcdc) { lcdc_ = lcdc; }
+    
+    /**
+     * Read VRAM and OAM from the emulator's buffers instead of copying them
+     * on every update
+     * 
+     * Borrowed buffers are only read inside Render(), and only when the
+     * generation differs from the last one synced, so repeated updates
+     * between two renders cost nothing. Pointers must stay valid until the
+     * next BorrowMemory() or ReleaseMemory() call.
+     * 
+     * @param vram Pointer to 8192-byte VRAM bank 0 buffer
+     * @param oam Pointer to 160-byte OAM buffer
+     * @param generation Counter the caller changes whenever memory changes
+     */
+    void BorrowMemory(const uint8_t* vram, const uint8_t* oam, uint64_t generation);
+    
+    /**
+     * Sync the last borrowed contents once and stop reading the buffers
+     */
+    void ReleaseMemory();
+    
+    /**
+     * Get the contents of a VRAM bank as last updated
+     * 
+     * @param bank VRAM bank (0 or 1)
+     * @return Pointer to 8192 bytes
+     */
+    const uint8_t* GetVRAMBank(uint8_t bank) const {
+        return bank == 0 ? vramBank0_.data() : vramBank1_.data();
+    }
+    
+    /**
+     * Get the 160 bytes of OAM as last updated
+     */
+    const uint8_t* GetOAM() const { return oam_.data(); }
+    
+    /**
+     * Get the 8 CGB background palettes as last updated
+     */
+    const CGBPalette* GetBGPalettes() const { return bgPalettes_.data(); }
+    
+    /**
+     * Get the 8 CGB sprite palettes as last updated
+     */
+    const CGBPalette* GetSpritePalettes() const { return spritePalettes_.data(); }
 
 private:
+    /**
+     * Pull borrowed VRAM/OAM into the decode shadow if the generation moved
+     */
+    void SyncBorrowedMemory();
+    
     // Rendering methods
     void RenderTileGrid();
     void RenderSpriteView();
     void RenderTileInspector();
     
+    /**
+     * Draw one cell per visible line colored by how many sprites span it,
+     * marking lines past the 10-sprite limit
+     */
+    void RenderOccupancyStrip();
+    
+    /**
+     * Mark every tile in both banks for re-decode (palette or mode change)
+     */
+    void MarkAllTilesDirty();
+    
+    /**
+     * Force every sprite's textures to be rebuilt on next render
+     */
+    void InvalidateSpriteCache();
+    
+    /**
+     * Decode and upload one sprite's textures unless its inputs are unchanged
+     * @param index OAM entry (0-39)
+     * @param palette Resolved palette for the sprite
+     * @param tall 8x16 mode
+     */
+    void UpdateSpriteTextures(int index, const Palette& palette, bool tall);
+    
+    /**
+     * Everything a sprite's textures depend on, and the textures themselves
+     */
+    struct SpriteCacheEntry {
+        std::array<uint8_t, 4> entry;    // OAM bytes
+        std::array<uint8_t, 32> tiles;   // Tile data (second tile in 8x16 mode)
+        Palette palette;
+        bool tall;
+        bool valid;
+        unsigned int topTexture;
+        unsigned int bottomTexture;
+        
+        SpriteCacheEntry() : tall(false), valid(false), topTexture(0), bottomTexture(0) {}
+    };
+    
+    /// Number of tiles in the tile data area of one VRAM bank ($8000-$97FF)
+    static constexpr int TILE_DATA_COUNT = 384;
+    
     // Helper components
     std::unique_ptr<TileDecoder> decoder_;
     std::unique_ptr<TileRenderer> renderer_;
     std::unique_ptr<PaletteManager> paletteManager_;
+    std::unique_ptr<SpriteOccupancy> occupancy_;
+    std::unique_ptr<SpriteParser> spriteParser_;
     
     // VRAM storage (8KB per bank)
     std::array<uint8_t, 8192> vramBank0_;
     std::array<uint8_t, 8192> vramBank1_;
     
+    // Per-bank dirty bitmaps: bit N set = tile N changed since last decode
+    std::array<std::bitset<TILE_DATA_COUNT>, 2> dirtyTiles_;
+    
+    // Palette the tile atlas was last rendered with
+    Palette atlasPalette_;
+    
+    // Borrowed emulator buffers (nullptr when data is copied in)
+    const uint8_t* borrowedVram_;
+    const uint8_t* borrowedOam_;
+    uint64_t borrowedGeneration_;
+    uint64_t syncedGeneration_;
+    
     // OAM storage (160 bytes, 40 sprites × 4 bytes)
     std::array<uint8_t, 160> oam_;
+    uint8_t lcdc_;
+    
+    // Parsed OAM and per-entry texture cache for the sprite view
+    std::array<SpriteAttributes, 40> sprites_;
+    std::array<SpriteCacheEntry, 40> spriteCache_;
     
     // CGB palette storage
     std::array<CGBPalette, 8> bgPalettes_;
@@ -0,0 +1,405 @@
+#include "BreakCondition.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace GBDebug {
+
+constexpr int BreakCondition::MAX_STACK;
+
+/**
+ * BreakConditionParser - Recursive-descent parser emitting BreakCondition bytecode
+ *
+ * Tracks the operand stack depth of the emitted code so expressions that
+ * would overflow the evaluation stack are rejected at compile time.
+ */
+class BreakConditionParser {
+public:
+    typedef BreakCondition::Op Op;
+    typedef BreakCondition::Instruction Instruction;
+
+    BreakConditionParser(const std::string& source, std::vector<Instruction>& code)
+        : source_(source), pos_(0), code_(code), depth_(0), maxDepth_(0) {}
+
+    bool Parse(std::string& error) {
+        SkipSpaces();
+        if (AtEnd()) {
+            return Fail("Empty condition", error);
+        }
+        if (!ParseOr(error)) {
+            return false;
+        }
+        SkipSpaces();
+        if (!AtEnd()) {
+            return Fail(std::string("Unexpected '") + source_[pos_] + "'", error);
+        }
+        if (maxDepth_ > BreakCondition::MAX_STACK) {
+            return Fail("Condition is too deeply nested", error);
+        }
+        return true;
+    }
+
+private:
+    bool AtEnd() const { return pos_ >= source_.size(); }
+
+    void SkipSpaces() {
+        while (!AtEnd() && std::isspace(static_cast<unsigned char>(source_[pos_]))) {
+            pos_++;
+        }
+    }
+
+    /**
+     * Consume an operator token if it is next (and not the prefix of a longer one)
+     */
+    bool Accept(const char* token) {
+        SkipSpaces();
+        size_t length = std::strlen(token);
+        if (source_.compare(pos_, length, token) != 0) {
+            return false;
+        }
+        // "&" must not match "&&", "|" not "||", "<" not "<=", and so on
+        if (length == 1 && pos_ + 1 < source_.size()) {
+            char next = source_[pos_ + 1];
+            if ((token[0] == '&' && next == '&') || (token[0] == '|' && next == '|') ||
+                ((token[0] == '<' || token[0] == '>' || token[0] == '!') && next == '=')) {
+                return false;
+            }
+        }
+        pos_ += length;
+        return true;
+    }
+
+    bool Fail(const std::string& message, std::string& error) {
+        error = message + " (at column " + std::to_string(pos_ + 1) + ")";
+        return false;
+    }
+
+    void Emit(Op op, int64_t operand, int stackEffect) {
+        Instruction instruction;
+        instruction.op = op;
+        instruction.operand = operand;
+        code_.push_back(instruction);
+        depth_ += stackEffect;
+        if (depth_ > maxDepth_) {
+            maxDepth_ = depth_;
+        }
+    }
+
+    void PatchJump(size_t at) {
+        code_[at].operand = static_cast<int64_t>(code_.size());
+    }
+
+    bool ParseOr(std::string& error) {
+        if (!ParseAnd(error)) {
+            return false;
+        }
+        while (Accept("||")) {
+            Emit(Op::ToBool, 0, 0);
+            size_t jump = code_.size();
+            Emit(Op::JumpIfTrue, 0, -1);
+            if (!ParseAnd(error)) {
+                return false;
+            }
+            Emit(Op::ToBool, 0, 0);
+            PatchJump(jump);
+        }
+        return true;
+    }
+
+    bool ParseAnd(std::string& error) {
+        if (!ParseComparison(error)) {
+            return false;
+        }
+        while (Accept("&&")) {
+            size_t jump = code_.size();
+            Emit(Op::JumpIfFalse, 0, -1);
+            if (!ParseComparison(error)) {
+                return false;
+            }
+            Emit(Op::ToBool, 0, 0);
+            PatchJump(jump);
+        }
+        return true;
+    }
+
+    bool ParseComparison(std::string& error) {
+        if (!ParseBitwise(error)) {
+            return false;
+        }
+
+        static const struct { const char* token; Op op; } COMPARISONS[] = {
+            {"==", Op::Equal}, {"!=", Op::NotEqual}, {"<=", Op::LessEqual},
+            {">=", Op::GreaterEqual}, {"<", Op::Less}, {">", Op::Greater}
+        };
+        for (const auto& comparison : COMPARISONS) {
+            if (Accept(comparison.token)) {
+                if (!ParseBitwise(error)) {
+                    return false;
+                }
+                Emit(comparison.op, 0, -1);
+                return true;
+            }
+        }
+
+        SkipSpaces();
+        if (!AtEnd() && source_[pos_] == '=') {
+            return Fail("Use '==' to compare", error);
+        }
+        return true;
+    }
+
+    bool ParseBitwise(std::string& error) {
+        if (!ParseSum(error)) {
+            return false;
+        }
+        while (true) {
+            Op op;
+            if (Accept("&")) {
+                op = Op::BitAnd;
+            } else if (Accept("|")) {
+                op = Op::BitOr;
+            } else if (Accept("^")) {
+                op = Op::BitXor;
+            } else {
+                return true;
+            }
+            if (!ParseSum(error)) {
+                return false;
+            }
+            Emit(op, 0, -1);
+        }
+    }
+
+    bool ParseSum(std::string& error) {
+        if (!ParseUnary(error)) {
+            return false;
+        }
+        while (true) {
+            Op op;
+            if (Accept("+")) {
+                op = Op::Add;
+            } else if (Accept("-")) {
+                op = Op::Sub;
+            } else {
+                return true;
+            }
+            if (!ParseUnary(error)) {
+                return false;
+            }
+            Emit(op, 0, -1);
+        }
+    }
+
+    bool ParseUnary(std::string& error) {
+        Op op;
+        if (Accept("!")) {
+            op = Op::LogicalNot;
+        } else if (Accept("-")) {
+            op = Op::Negate;
+        } else if (Accept("~")) {
+            op = Op::BitNot;
+        } else {
+            return ParsePrimary(error);
+        }
+        if (!ParseUnary(error)) {
+            return false;
+        }
+        Emit(op, 0, 0);
+        return true;
+    }
+
+    bool ParsePrimary(std::string& error) {
+        SkipSpaces();
+        if (AtEnd()) {
+            return Fail("Expression ends early", error);
+        }
+
+        if (Accept("(")) {
+            if (!ParseOr(error)) {
+                return false;
+            }
+            return Accept(")") ? true : Fail("Missing ')'", error);
+        }
+
+        if (Accept("[")) {
+            if (!ParseOr(error)) {
+                return false;
+            }
+            if (!Accept("]")) {
+                return Fail("Missing ']'", error);
+            }
+            Emit(Op::LoadByte, 0, 0);
+            return true;
+        }
+
+        char c = source_[pos_];
+        if (c == '$' || std::isdigit(static_cast<unsigned char>(c))) {
+            return ParseNumber(error);
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            return ParseRegister(error);
+        }
+        return Fail(std::string("Unexpected '") + c + "'", error);
+    }
+
+    bool ParseNumber(std::string& error) {
+        int base = 10;
+        if (source_[pos_] == '$') {
+            base = 16;
+            pos_++;
+        } else if (source_.compare(pos_, 2, "0x") == 0 || source_.compare(pos_, 2, "0X") == 0) {
+            base = 16;
+            pos_ += 2;
+        }
+
+        const char* start = source_.c_str() + pos_;
+        char* end = nullptr;
+        unsigned long long value = std::strtoull(start, &end, base);
+        if (end == start || std::isalnum(static_cast<unsigned char>(*end))) {
+            return Fail("Invalid number", error);
+        }
+        pos_ += static_cast<size_t>(end - start);
+        Emit(Op::PushConst, static_cast<int64_t>(value), 1);
+        return true;
+    }
+
+    bool ParseRegister(std::string& error) {
+        size_t start = pos_;
+        while (!AtEnd() && std::isalnum(static_cast<unsigned char>(source_[pos_]))) {
+            pos_++;
+        }
+        std::string name = source_.substr(start, pos_ - start);
+        for (auto& ch : name) {
+            ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        }
+
+        static const struct { const char* name; BreakCondition::Register reg; } REGISTERS[] = {
+            {"A", BreakCondition::REG_A}, {"F", BreakCondition::REG_F},
+            {"B", BreakCondition::REG_B}, {"C", BreakCondition::REG_C},
+            {"D", BreakCondition::REG_D}, {"E", BreakCondition::REG_E},
+            {"H", BreakCondition::REG_H}, {"L", BreakCondition::REG_L},
+            {"AF", BreakCondition::REG_AF}, {"BC", BreakCondition::REG_BC},
+            {"DE", BreakCondition::REG_DE}, {"HL", BreakCondition::REG_HL},
+            {"SP", BreakCondition::REG_SP}, {"PC", BreakCondition::REG_PC},
+            {"ZF", BreakCondition::REG_ZF}, {"NF", BreakCondition::REG_NF},
+            {"HF", BreakCondition::REG_HF}, {"CF", BreakCondition::REG_CF},
+            {"CYCLE", BreakCondition::REG_CYCLE}, {"IME", BreakCondition::REG_IME}
+        };
+        for (const auto& entry : REGISTERS) {
+            if (name == entry.name) {
+                Emit(Op::PushRegister, entry.reg, 1);
+                return true;
+            }
+        }
+
+        // Bare hex such as [FF40] is accepted when it is not a register name
+        if (name.find_first_not_of("0123456789ABCDEF") == std::string::npos) {
+            Emit(Op::PushConst, static_cast<int64_t>(std::strtoull(name.c_str(), nullptr, 16)), 1);
+            return true;
+        }
+        
+        pos_ = start;
+        return Fail("Unknown name '" + name + "'", error);
+    }
+
+    const std::string& source_;
+    size_t pos_;
+    std::vector<Instruction>& code_;
+    int depth_;
+    int maxDepth_;
+};
+
+bool BreakCondition::Compile(const std::string& source, std::string& error) {
+    std::vector<Instruction> code;
+    BreakConditionParser parser(source, code);
+    if (!parser.Parse(error)) {
+        return false;
+    }
+
+    code_.swap(code);
+    source_ = source;
+    error.clear();
+    return true;
+}
+
+int64_t BreakCondition::ReadRegister(const CPUState& cpu, int64_t reg) {
+    uint8_t f = cpu.af & 0xFF;
+    switch (reg) {
+        case REG_A:     return cpu.af >> 8;
+        case REG_F:     return f;
+        case REG_B:     return cpu.bc >> 8;
+        case REG_C:     return cpu.bc & 0xFF;
+        case REG_D:     return cpu.de >> 8;
+        case REG_E:     return cpu.de & 0xFF;
+        case REG_H:     return cpu.hl >> 8;
+        case REG_L:     return cpu.hl & 0xFF;
+        case REG_AF:    return cpu.af;
+        case REG_BC:    return cpu.bc;
+        case REG_DE:    return cpu.de;
+        case REG_HL:    return cpu.hl;
+        case REG_SP:    return cpu.sp;
+        case REG_PC:    return cpu.pc;
+        case REG_ZF:    return (f >> 7) & 1;
+        case REG_NF:    return (f >> 6) & 1;
+        case REG_HF:    return (f >> 5) & 1;
+        case REG_CF:    return (f >> 4) & 1;
+        case REG_CYCLE: return static_cast<int64_t>(cpu.cycle);
+        case REG_IME:   return cpu.ime ? 1 : 0;
+        default:        return 0;
+    }
+}
+
+bool BreakCondition::Evaluate(const CPUState& cpu, const uint8_t* memory) const {
+    if (code_.empty()) {
+        return true;
+    }
+
+    int64_t stack[MAX_STACK];
+    int top = -1;
+    const Instruction* code = code_.data();
+    const size_t count = code_.size();
+
+    for (size_t ip = 0; ip < count; ip++) {
+        const Instruction& in = code[ip];
+        switch (in.op) {
+            case Op::PushConst:    stack[++top] = in.operand; break;
+            case Op::PushRegister: stack[++top] = ReadRegister(cpu, in.operand); break;
+            case Op::LoadByte:
+                stack[top] = memory != nullptr ? memory[stack[top] & 0xFFFF] : 0;
+                break;
+            case Op::Negate:       stack[top] = -stack[top]; break;
+            case Op::LogicalNot:   stack[top] = stack[top] == 0; break;
+            case Op::BitNot:       stack[top] = ~stack[top]; break;
+            case Op::Add:          top--; stack[top] = stack[top] + stack[top + 1]; break;
+            case Op::Sub:          top--; stack[top] = stack[top] - stack[top + 1]; break;
+            case Op::BitAnd:       top--; stack[top] = stack[top] & stack[top + 1]; break;
+            case Op::BitOr:        top--; stack[top] = stack[top] | stack[top + 1]; break;
+            case Op::BitXor:       top--; stack[top] = stack[top] ^ stack[top + 1]; break;
+            case Op::Equal:        top--; stack[top] = stack[top] == stack[top + 1]; break;
+            case Op::NotEqual:     top--; stack[top] = stack[top] != stack[top + 1]; break;
+            case Op::Less:         top--; stack[top] = stack[top] < stack[top + 1]; break;
+            case Op::LessEqual:    top--; stack[top] = stack[top] <= stack[top + 1]; break;
+            case Op::Greater:      top--; stack[top] = stack[top] > stack[top + 1]; break;
+            case Op::GreaterEqual: top--; stack[top] = stack[top] >= stack[top + 1]; break;
+            case Op::ToBool:       stack[top] = stack[top] != 0; break;
+            case Op::JumpIfFalse:
+                if (stack[top] == 0) {
+                    ip = static_cast<size_t>(in.operand) - 1;
+                } else {
+                    top--;
+                }
+                break;
+            case Op::JumpIfTrue:
+                if (stack[top] != 0) {
+                    ip = static_cast<size_t>(in.operand) - 1;
+                } else {
+                    top--;
+                }
+                break;
+        }
+    }
+
+    return stack[top] != 0;
+}
+
+} // namespace GBDebug
@@ -0,0 +1,193 @@
+#include "BreakpointManager.h"
+
+namespace GBDebug {
+
+constexpr int Breakpoint::ANY_BANK;
+constexpr int Breakpoint::MAX_BANK;
+constexpr size_t BreakpointManager::HOT_WORDS;
+constexpr uint16_t BreakpointManager::BANKED_START;
+constexpr uint16_t BreakpointManager::BANKED_END;
+constexpr size_t BreakpointManager::BANK_SIZE;
+
+BreakpointManager::BreakpointManager()
+    : hasLastHit_(false)
+    , lastHitAddress_(0)
+    , lastHitBank_(Breakpoint::ANY_BANK) {
+    for (auto& word : hotBits_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool BreakpointManager::Check(uint16_t pc, int bank, const CPUState* cpu, const uint8_t* memory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool candidate = anyBankBits_[pc];
+    if (!candidate && IsBanked(pc) && bank >= 0 && static_cast<size_t>(bank) < bankBits_.size()) {
+        candidate = bankBits_[bank][pc - BANKED_START];
+    }
+    if (!candidate) {
+        return false;
+    }
+
+    // Only entries at this address get here, so a linear scan is fine
+    int effectiveBank = EffectiveBank(pc, bank);
+    bool hit = false;
+    for (auto& entry : entries_) {
+        if (!entry.enabled || entry.address != pc ||
+            (entry.bank != Breakpoint::ANY_BANK && entry.bank != effectiveBank)) {
+            continue;
+        }
+        if (entry.condition && (cpu == nullptr || !entry.condition->Evaluate(*cpu, memory))) {
+            continue;
+        }
+        entry.hitCount++;
+        hit = true;
+    }
+    if (!hit) {
+        return false;
+    }
+
+    hasLastHit_ = true;
+    lastHitAddress_ = pc;
+    lastHitBank_ = effectiveBank;
+    return true;
+}
+
+bool BreakpointManager::Add(uint16_t address, int bank) {
+    if (!IsValidBank(bank)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bank = EffectiveBank(address, bank);
+    for (const auto& entry : entries_) {
+        if (entry.address == address && entry.bank == bank) {
+            return false;
+        }
+    }
+
+    entries_.push_back(Breakpoint(address, bank));
+    RebuildBitmaps();
+    return true;
+}
+
+bool BreakpointManager::Remove(uint16_t address, int bank) {
+    if (!IsValidBank(bank)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bank = EffectiveBank(address, bank);
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i].address == address && entries_[i].bank == bank) {
+            entries_.erase(entries_.begin() + i);
+            RebuildBitmaps();
+            return true;
+        }
+    }
+    return false;
+}
+
+int BreakpointManager::Find(uint16_t address, int bank) const {
+    if (!IsValidBank(bank)) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bank = EffectiveBank(address, bank);
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i].address == address && entries_[i].bank == bank) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool BreakpointManager::SetCondition(size_t index, const std::string& expression, std::string& error) {
+    // Compile outside the lock; the emulator thread may be checking
+    std::shared_ptr<BreakCondition> condition;
+    if (expression.find_first_not_of(" \t") != std::string::npos) {
+        condition = std::make_shared<BreakCondition>();
+        if (!condition->Compile(expression, error)) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= entries_.size()) {
+        error = "No such breakpoint";
+        return false;
+    }
+    entries_[index].condition = condition;
+    error.clear();
+    return true;
+}
+
+void BreakpointManager::SetEnabled(size_t index, bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index < entries_.size() && entries_[index].enabled != enabled) {
+        entries_[index].enabled = enabled;
+        RebuildBitmaps();
+    }
+}
+
+void BreakpointManager::RemoveAt(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index < entries_.size()) {
+        entries_.erase(entries_.begin() + index);
+        RebuildBitmaps();
+    }
+}
+
+void BreakpointManager::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    entries_.clear();
+    RebuildBitmaps();
+}
+
+void BreakpointManager::CopyBreakpoints(std::vector<Breakpoint>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.assign(entries_.begin(), entries_.end());
+}
+
+bool BreakpointManager::GetLastHit(uint16_t& address, int& bank) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    address = lastHitAddress_;
+    bank = lastHitBank_;
+    return hasLastHit_;
+}
+
+void BreakpointManager::RebuildBitmaps() {
+    std::array<uint64_t, HOT_WORDS> hot;
+    hot.fill(0);
+    anyBankBits_.reset();
+    for (auto& bits : bankBits_) {
+        bits.reset();
+    }
+
+    for (const auto& entry : entries_) {
+        if (!entry.enabled) {
+            continue;
+        }
+
+        hot[entry.address >> 6] |= uint64_t(1) << (entry.address & 63);
+        if (entry.bank == Breakpoint::ANY_BANK) {
+            anyBankBits_.set(entry.address);
+        } else {
+            if (static_cast<size_t>(entry.bank) >= bankBits_.size()) {
+                bankBits_.resize(entry.bank + 1);
+            }
+            bankBits_[entry.bank].set(entry.address - BANKED_START);
+        }
+    }
+
+    for (size_t i = 0; i < HOT_WORDS; i++) {
+        hotBits_[i].store(hot[i], std::memory_order_relaxed);
+    }
+}
+
+} // namespace GBDebug
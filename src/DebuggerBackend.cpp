@@ -16,7 +16,8 @@ DebuggerBackend::DebuggerBackend()
     : window_(nullptr)
     , gl_context_(nullptr)
     , initialized_(false)
-    , should_close_(false) {
+    , should_close_(false)
+    , vsync_(true) {
 }
 
 DebuggerBackend::~DebuggerBackend() {
@@ -69,7 +70,7 @@ bool DebuggerBackend::Initialize(const char* title, int width, int height) {
     }
     
     SDL_GL_MakeCurrent(window_, gl_context_);
-    SDL_GL_SetSwapInterval(1); // Enable vsync
+    SDL_GL_SetSwapInterval(vsync_ ? 1 : 0);
     
     // Initialize ImGui backends - use GLSL 120 for OpenGL 2.1 compatibility
     ImGui_ImplSDL2_InitForOpenGL(window_, gl_context_);
@@ -128,6 +129,14 @@ void DebuggerBackend::ProcessEvent(SDL_Event* event) {
     ImGui_ImplSDL2_ProcessEvent(event);
 }
 
+void DebuggerBackend::SetVSync(bool enabled) {
+    vsync_ = enabled;
+    if (initialized_) {
+        SDL_GL_MakeCurrent(window_, gl_context_);
+        SDL_GL_SetSwapInterval(vsync_ ? 1 : 0);
+    }
+}
+
 void DebuggerBackend::BeginFrame() {
     if (!initialized_) {
         return;
@@ -0,0 +1,669 @@
+#include "Disassembler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace GBDebug {
+
+constexpr size_t DisassembledInstruction::MAX_TEXT;
+constexpr size_t Disassembler::REGION_SIZE;
+constexpr uint16_t Disassembler::BANKED_START;
+constexpr uint16_t Disassembler::BANKED_END;
+constexpr size_t Disassembler::MAX_ANCHORS;
+constexpr size_t Disassembler::MAX_REGIONS;
+
+namespace {
+
+// Formats take at most one int argument, as described by the operand type.
+// CB-prefixed lengths include the prefix byte.
+constexpr OpcodeInfo BASE_OPCODES[256] = {
+    {"NOP",               1, OperandType::None},       // 00
+    {"LD BC,$%04X",       3, OperandType::Imm16},      // 01
+    {"LD (BC),A",         1, OperandType::None},       // 02
+    {"INC BC",            1, OperandType::None},       // 03
+    {"INC B",             1, OperandType::None},       // 04
+    {"DEC B",             1, OperandType::None},       // 05
+    {"LD B,$%02X",        2, OperandType::Imm8},       // 06
+    {"RLCA",              1, OperandType::None},       // 07
+    {"LD ($%04X),SP",     3, OperandType::Imm16},      // 08
+    {"ADD HL,BC",         1, OperandType::None},       // 09
+    {"LD A,(BC)",         1, OperandType::None},       // 0A
+    {"DEC BC",            1, OperandType::None},       // 0B
+    {"INC C",             1, OperandType::None},       // 0C
+    {"DEC C",             1, OperandType::None},       // 0D
+    {"LD C,$%02X",        2, OperandType::Imm8},       // 0E
+    {"RRCA",              1, OperandType::None},       // 0F
+    {"STOP",              2, OperandType::None},       // 10
+    {"LD DE,$%04X",       3, OperandType::Imm16},      // 11
+    {"LD (DE),A",         1, OperandType::None},       // 12
+    {"INC DE",            1, OperandType::None},       // 13
+    {"INC D",             1, OperandType::None},       // 14
+    {"DEC D",             1, OperandType::None},       // 15
+    {"LD D,$%02X",        2, OperandType::Imm8},       // 16
+    {"RLA",               1, OperandType::None},       // 17
+    {"JR $%04X",          2, OperandType::Relative8},  // 18
+    {"ADD HL,DE",         1, OperandType::None},       // 19
+    {"LD A,(DE)",         1, OperandType::None},       // 1A
+    {"DEC DE",            1, OperandType::None},       // 1B
+    {"INC E",             1, OperandType::None},       // 1C
+    {"DEC E",             1, OperandType::None},       // 1D
+    {"LD E,$%02X",        2, OperandType::Imm8},       // 1E
+    {"RRA",               1, OperandType::None},       // 1F
+    {"JR NZ,$%04X",       2, OperandType::Relative8},  // 20
+    {"LD HL,$%04X",       3, OperandType::Imm16},      // 21
+    {"LD (HL+),A",        1, OperandType::None},       // 22
+    {"INC HL",            1, OperandType::None},       // 23
+    {"INC H",             1, OperandType::None},       // 24
+    {"DEC H",             1, OperandType::None},       // 25
+    {"LD H,$%02X",        2, OperandType::Imm8},       // 26
+    {"DAA",               1, OperandType::None},       // 27
+    {"JR Z,$%04X",        2, OperandType::Relative8},  // 28
+    {"ADD HL,HL",         1, OperandType::None},       // 29
+    {"LD A,(HL+)",        1, OperandType::None},       // 2A
+    {"DEC HL",            1, OperandType::None},       // 2B
+    {"INC L",             1, OperandType::None},       // 2C
+    {"DEC L",             1, OperandType::None},       // 2D
+    {"LD L,$%02X",        2, OperandType::Imm8},       // 2E
+    {"CPL",               1, OperandType::None},       // 2F
+    {"JR NC,$%04X",       2, OperandType::Relative8},  // 30
+    {"LD SP,$%04X",       3, OperandType::Imm16},      // 31
+    {"LD (HL-),A",        1, OperandType::None},       // 32
+    {"INC SP",            1, OperandType::None},       // 33
+    {"INC (HL)",          1, OperandType::None},       // 34
+    {"DEC (HL)",          1, OperandType::None},       // 35
+    {"LD (HL),$%02X",     2, OperandType::Imm8},       // 36
+    {"SCF",               1, OperandType::None},       // 37
+    {"JR C,$%04X",        2, OperandType::Relative8},  // 38
+    {"ADD HL,SP",         1, OperandType::None},       // 39
+    {"LD A,(HL-)",        1, OperandType::None},       // 3A
+    {"DEC SP",            1, OperandType::None},       // 3B
+    {"INC A",             1, OperandType::None},       // 3C
+    {"DEC A",             1, OperandType::None},       // 3D
+    {"LD A,$%02X",        2, OperandType::Imm8},       // 3E
+    {"CCF",               1, OperandType::None},       // 3F
+    {"LD B,B",            1, OperandType::None},       // 40
+    {"LD B,C",            1, OperandType::None},       // 41
+    {"LD B,D",            1, OperandType::None},       // 42
+    {"LD B,E",            1, OperandType::None},       // 43
+    {"LD B,H",            1, OperandType::None},       // 44
+    {"LD B,L",            1, OperandType::None},       // 45
+    {"LD B,(HL)",         1, OperandType::None},       // 46
+    {"LD B,A",            1, OperandType::None},       // 47
+    {"LD C,B",            1, OperandType::None},       // 48
+    {"LD C,C",            1, OperandType::None},       // 49
+    {"LD C,D",            1, OperandType::None},       // 4A
+    {"LD C,E",            1, OperandType::None},       // 4B
+    {"LD C,H",            1, OperandType::None},       // 4C
+    {"LD C,L",            1, OperandType::None},       // 4D
+    {"LD C,(HL)",         1, OperandType::None},       // 4E
+    {"LD C,A",            1, OperandType::None},       // 4F
+    {"LD D,B",            1, OperandType::None},       // 50
+    {"LD D,C",            1, OperandType::None},       // 51
+    {"LD D,D",            1, OperandType::None},       // 52
+    {"LD D,E",            1, OperandType::None},       // 53
+    {"LD D,H",            1, OperandType::None},       // 54
+    {"LD D,L",            1, OperandType::None},       // 55
+    {"LD D,(HL)",         1, OperandType::None},       // 56
+    {"LD D,A",            1, OperandType::None},       // 57
+    {"LD E,B",            1, OperandType::None},       // 58
+    {"LD E,C",            1, OperandType::None},       // 59
+    {"LD E,D",            1, OperandType::None},       // 5A
+    {"LD E,E",            1, OperandType::None},       // 5B
+    {"LD E,H",            1, OperandType::None},       // 5C
+    {"LD E,L",            1, OperandType::None},       // 5D
+    {"LD E,(HL)",         1, OperandType::None},       // 5E
+    {"LD E,A",            1, OperandType::None},       // 5F
+    {"LD H,B",            1, OperandType::None},       // 60
+    {"LD H,C",            1, OperandType::None},       // 61
+    {"LD H,D",            1, OperandType::None},       // 62
+    {"LD H,E",            1, OperandType::None},       // 63
+    {"LD H,H",            1, OperandType::None},       // 64
+    {"LD H,L",            1, OperandType::None},       // 65
+    {"LD H,(HL)",         1, OperandType::None},       // 66
+    {"LD H,A",            1, OperandType::None},       // 67
+    {"LD L,B",            1, OperandType::None},       // 68
+    {"LD L,C",            1, OperandType::None},       // 69
+    {"LD L,D",            1, OperandType::None},       // 6A
+    {"LD L,E",            1, OperandType::None},       // 6B
+    {"LD L,H",            1, OperandType::None},       // 6C
+    {"LD L,L",            1, OperandType::None},       // 6D
+    {"LD L,(HL)",         1, OperandType::None},       // 6E
+    {"LD L,A",            1, OperandType::None},       // 6F
+    {"LD (HL),B",         1, OperandType::None},       // 70
+    {"LD (HL),C",         1, OperandType::None},       // 71
+    {"LD (HL),D",         1, OperandType::None},       // 72
+    {"LD (HL),E",         1, OperandType::None},       // 73
+    {"LD (HL),H",         1, OperandType::None},       // 74
+    {"LD (HL),L",         1, OperandType::None},       // 75
+    {"HALT",              1, OperandType::None},       // 76
+    {"LD (HL),A",         1, OperandType::None},       // 77
+    {"LD A,B",            1, OperandType::None},       // 78
+    {"LD A,C",            1, OperandType::None},       // 79
+    {"LD A,D",            1, OperandType::None},       // 7A
+    {"LD A,E",            1, OperandType::None},       // 7B
+    {"LD A,H",            1, OperandType::None},       // 7C
+    {"LD A,L",            1, OperandType::None},       // 7D
+    {"LD A,(HL)",         1, OperandType::None},       // 7E
+    {"LD A,A",            1, OperandType::None},       // 7F
+    {"ADD A,B",           1, OperandType::None},       // 80
+    {"ADD A,C",           1, OperandType::None},       // 81
+    {"ADD A,D",           1, OperandType::None},       // 82
+    {"ADD A,E",           1, OperandType::None},       // 83
+    {"ADD A,H",           1, OperandType::None},       // 84
+    {"ADD A,L",           1, OperandType::None},       // 85
+    {"ADD A,(HL)",        1, OperandType::None},       // 86
+    {"ADD A,A",           1, OperandType::None},       // 87
+    {"ADC A,B",           1, OperandType::None},       // 88
+    {"ADC A,C",           1, OperandType::None},       // 89
+    {"ADC A,D",           1, OperandType::None},       // 8A
+    {"ADC A,E",           1, OperandType::None},       // 8B
+    {"ADC A,H",           1, OperandType::None},       // 8C
+    {"ADC A,L",           1, OperandType::None},       // 8D
+    {"ADC A,(HL)",        1, OperandType::None},       // 8E
+    {"ADC A,A",           1, OperandType::None},       // 8F
+    {"SUB B",             1, OperandType::None},       // 90
+    {"SUB C",             1, OperandType::None},       // 91
+    {"SUB D",             1, OperandType::None},       // 92
+    {"SUB E",             1, OperandType::None},       // 93
+    {"SUB H",             1, OperandType::None},       // 94
+    {"SUB L",             1, OperandType::None},       // 95
+    {"SUB (HL)",          1, OperandType::None},       // 96
+    {"SUB A",             1, OperandType::None},       // 97
+    {"SBC A,B",           1, OperandType::None},       // 98
+    {"SBC A,C",           1, OperandType::None},       // 99
+    {"SBC A,D",           1, OperandType::None},       // 9A
+    {"SBC A,E",           1, OperandType::None},       // 9B
+    {"SBC A,H",           1, OperandType::None},       // 9C
+    {"SBC A,L",           1, OperandType::None},       // 9D
+    {"SBC A,(HL)",        1, OperandType::None},       // 9E
+    {"SBC A,A",           1, OperandType::None},       // 9F
+    {"AND B",             1, OperandType::None},       // A0
+    {"AND C",             1, OperandType::None},       // A1
+    {"AND D",             1, OperandType::None},       // A2
+    {"AND E",             1, OperandType::None},       // A3
+    {"AND H",             1, OperandType::None},       // A4
+    {"AND L",             1, OperandType::None},       // A5
+    {"AND (HL)",          1, OperandType::None},       // A6
+    {"AND A",             1, OperandType::None},       // A7
+    {"XOR B",             1, OperandType::None},       // A8
+    {"XOR C",             1, OperandType::None},       // A9
+    {"XOR D",             1, OperandType::None},       // AA
+    {"XOR E",             1, OperandType::None},       // AB
+    {"XOR H",             1, OperandType::None},       // AC
+    {"XOR L",             1, OperandType::None},       // AD
+    {"XOR (HL)",          1, OperandType::None},       // AE
+    {"XOR A",             1, OperandType::None},       // AF
+    {"OR B",              1, OperandType::None},       // B0
+    {"OR C",              1, OperandType::None},       // B1
+    {"OR D",              1, OperandType::None},       // B2
+    {"OR E",              1, OperandType::None},       // B3
+    {"OR H",              1, OperandType::None},       // B4
+    {"OR L",              1, OperandType::None},       // B5
+    {"OR (HL)",           1, OperandType::None},       // B6
+    {"OR A",              1, OperandType::None},       // B7
+    {"CP B",              1, OperandType::None},       // B8
+    {"CP C",              1, OperandType::None},       // B9
+    {"CP D",              1, OperandType::None},       // BA
+    {"CP E",              1, OperandType::None},       // BB
+    {"CP H",              1, OperandType::None},       // BC
+    {"CP L",              1, OperandType::None},       // BD
+    {"CP (HL)",           1, OperandType::None},       // BE
+    {"CP A",              1, OperandType::None},       // BF
+    {"RET NZ",            1, OperandType::None},       // C0
+    {"POP BC",            1, OperandType::None},       // C1
+    {"JP NZ,$%04X",       3, OperandType::Imm16},      // C2
+    {"JP $%04X",          3, OperandType::Imm16},      // C3
+    {"CALL NZ,$%04X",     3, OperandType::Imm16},      // C4
+    {"PUSH BC",           1, OperandType::None},       // C5
+    {"ADD A,$%02X",       2, OperandType::Imm8},       // C6
+    {"RST $00",           1, OperandType::None},       // C7
+    {"RET Z",             1, OperandType::None},       // C8
+    {"RET",               1, OperandType::None},       // C9
+    {"JP Z,$%04X",        3, OperandType::Imm16},      // CA
+    {"PREFIX CB",         2, OperandType::None},       // CB
+    {"CALL Z,$%04X",      3, OperandType::Imm16},      // CC
+    {"CALL $%04X",        3, OperandType::Imm16},      // CD
+    {"ADC A,$%02X",       2, OperandType::Imm8},       // CE
+    {"RST $08",           1, OperandType::None},       // CF
+    {"RET NC",            1, OperandType::None},       // D0
+    {"POP DE",            1, OperandType::None},       // D1
+    {"JP NC,$%04X",       3, OperandType::Imm16},      // D2
+    {"DB $%02X",          1, OperandType::Invalid},    // D3
+    {"CALL NC,$%04X",     3, OperandType::Imm16},      // D4
+    {"PUSH DE",           1, OperandType::None},       // D5
+    {"SUB $%02X",         2, OperandType::Imm8},       // D6
+    {"RST $10",           1, OperandType::None},       // D7
+    {"RET C",             1, OperandType::None},       // D8
+    {"RETI",              1, OperandType::None},       // D9
+    {"JP C,$%04X",        3, OperandType::Imm16},      // DA
+    {"DB $%02X",          1, OperandType::Invalid},    // DB
+    {"CALL C,$%04X",      3, OperandType::Imm16},      // DC
+    {"DB $%02X",          1, OperandType::Invalid},    // DD
+    {"SBC A,$%02X",       2, OperandType::Imm8},       // DE
+    {"RST $18",           1, OperandType::None},       // DF
+    {"LDH ($FF%02X),A",   2, OperandType::HighPage8},  // E0
+    {"POP HL",            1, OperandType::None},       // E1
+    {"LD ($FF00+C),A",    1, OperandType::None},       // E2
+    {"DB $%02X",          1, OperandType::Invalid},    // E3
+    {"DB $%02X",          1, OperandType::Invalid},    // E4
+    {"PUSH HL",           1, OperandType::None},       // E5
+    {"AND $%02X",         2, OperandType::Imm8},       // E6
+    {"RST $20",           1, OperandType::None},       // E7
+    {"ADD SP,%d",         2, OperandType::Signed8},    // E8
+    {"JP HL",             1, OperandType::None},       // E9
+    {"LD ($%04X),A",      3, OperandType::Imm16},      // EA
+    {"DB $%02X",          1, OperandType::Invalid},    // EB
+    {"DB $%02X",          1, OperandType::Invalid},    // EC
+    {"DB $%02X",          1, OperandType::Invalid},    // ED
+    {"XOR $%02X",         2, OperandType::Imm8},       // EE
+    {"RST $28",           1, OperandType::None},       // EF
+    {"LDH A,($FF%02X)",   2, OperandType::HighPage8},  // F0
+    {"POP AF",            1, OperandType::None},       // F1
+    {"LD A,($FF00+C)",    1, OperandType::None},       // F2
+    {"DI",                1, OperandType::None},       // F3
+    {"DB $%02X",          1, OperandType::Invalid},    // F4
+    {"PUSH AF",           1, OperandType::None},       // F5
+    {"OR $%02X",          2, OperandType::Imm8},       // F6
+    {"RST $30",           1, OperandType::None},       // F7
+    {"LD HL,SP%+d",       2, OperandType::Signed8},    // F8
+    {"LD SP,HL",          1, OperandType::None},       // F9
+    {"LD A,($%04X)",      3, OperandType::Imm16},      // FA
+    {"EI",                1, OperandType::None},       // FB
+    {"DB $%02X",          1, OperandType::Invalid},    // FC
+    {"DB $%02X",          1, OperandType::Invalid},    // FD
+    {"CP $%02X",          2, OperandType::Imm8},       // FE
+    {"RST $38",           1, OperandType::None},       // FF
+};
+
+constexpr OpcodeInfo CB_OPCODES[256] = {
+    {"RLC B",     2, OperandType::None},  // CB 00
+    {"RLC C",     2, OperandType::None},  // CB 01
+    {"RLC D",     2, OperandType::None},  // CB 02
+    {"RLC E",     2, OperandType::None},  // CB 03
+    {"RLC H",     2, OperandType::None},  // CB 04
+    {"RLC L",     2, OperandType::None},  // CB 05
+    {"RLC (HL)",  2, OperandType::None},  // CB 06
+    {"RLC A",     2, OperandType::None},  // CB 07
+    {"RRC B",     2, OperandType::None},  // CB 08
+    {"RRC C",     2, OperandType::None},  // CB 09
+    {"RRC D",     2, OperandType::None},  // CB 0A
+    {"RRC E",     2, OperandType::None},  // CB 0B
+    {"RRC H",     2, OperandType::None},  // CB 0C
+    {"RRC L",     2, OperandType::None},  // CB 0D
+    {"RRC (HL)",  2, OperandType::None},  // CB 0E
+    {"RRC A",     2, OperandType::None},  // CB 0F
+    {"RL B",      2, OperandType::None},  // CB 10
+    {"RL C",      2, OperandType::None},  // CB 11
+    {"RL D",      2, OperandType::None},  // CB 12
+    {"RL E",      2, OperandType::None},  // CB 13
+    {"RL H",      2, OperandType::None},  // CB 14
+    {"RL L",      2, OperandType::None},  // CB 15
+    {"RL (HL)",   2, OperandType::None},  // CB 16
+    {"RL A",      2, OperandType::None},  // CB 17
+    {"RR B",      2, OperandType::None},  // CB 18
+    {"RR C",      2, OperandType::None},  // CB 19
+    {"RR D",      2, OperandType::None},  // CB 1A
+    {"RR E",      2, OperandType::None},  // CB 1B
+    {"RR H",      2, OperandType::None},  // CB 1C
+    {"RR L",      2, OperandType::None},  // CB 1D
+    {"RR (HL)",   2, OperandType::None},  // CB 1E
+    {"RR A",      2, OperandType::None},  // CB 1F
+    {"SLA B",     2, OperandType::None},  // CB 20
+    {"SLA C",     2, OperandType::None},  // CB 21
+    {"SLA D",     2, OperandType::None},  // CB 22
+    {"SLA E",     2, OperandType::None},  // CB 23
+    {"SLA H",     2, OperandType::None},  // CB 24
+    {"SLA L",     2, OperandType::None},  // CB 25
+    {"SLA (HL)",  2, OperandType::None},  // CB 26
+    {"SLA A",     2, OperandType::None},  // CB 27
+    {"SRA B",     2, OperandType::None},  // CB 28
+    {"SRA C",     2, OperandType::None},  // CB 29
+    {"SRA D",     2, OperandType::None},  // CB 2A
+    {"SRA E",     2, OperandType::None},  // CB 2B
+    {"SRA H",     2, OperandType::None},  // CB 2C
+    {"SRA L",     2, OperandType::None},  // CB 2D
+    {"SRA (HL)",  2, OperandType::None},  // CB 2E
+    {"SRA A",     2, OperandType::None},  // CB 2F
+    {"SWAP B",    2, OperandType::None},  // CB 30
+    {"SWAP C",    2, OperandType::None},  // CB 31
+    {"SWAP D",    2, OperandType::None},  // CB 32
+    {"SWAP E",    2, OperandType::None},  // CB 33
+    {"SWAP H",    2, OperandType::None},  // CB 34
+    {"SWAP L",    2, OperandType::None},  // CB 35
+    {"SWAP (HL)", 2, OperandType::None},  // CB 36
+    {"SWAP A",    2, OperandType::None},  // CB 37
+    {"SRL B",     2, OperandType::None},  // CB 38
+    {"SRL C",     2, OperandType::None},  // CB 39
+    {"SRL D",     2, OperandType::None},  // CB 3A
+    {"SRL E",     2, OperandType::None},  // CB 3B
+    {"SRL H",     2, OperandType::None},  // CB 3C
+    {"SRL L",     2, OperandType::None},  // CB 3D
+    {"SRL (HL)",  2, OperandType::None},  // CB 3E
+    {"SRL A",     2, OperandType::None},  // CB 3F
+    {"BIT 0,B",   2, OperandType::None},  // CB 40
+    {"BIT 0,C",   2, OperandType::None},  // CB 41
+    {"BIT 0,D",   2, OperandType::None},  // CB 42
+    {"BIT 0,E",   2, OperandType::None},  // CB 43
+    {"BIT 0,H",   2, OperandType::None},  // CB 44
+    {"BIT 0,L",   2, OperandType::None},  // CB 45
+    {"BIT 0,(HL)", 2, OperandType::None},  // CB 46
+    {"BIT 0,A",   2, OperandType::None},  // CB 47
+    {"BIT 1,B",   2, OperandType::None},  // CB 48
+    {"BIT 1,C",   2, OperandType::None},  // CB 49
+    {"BIT 1,D",   2, OperandType::None},  // CB 4A
+    {"BIT 1,E",   2, OperandType::None},  // CB 4B
+    {"BIT 1,H",   2, OperandType::None},  // CB 4C
+    {"BIT 1,L",   2, OperandType::None},  // CB 4D
+    {"BIT 1,(HL)", 2, OperandType::None},  // CB 4E
+    {"BIT 1,A",   2, OperandType::None},  // CB 4F
+    {"BIT 2,B",   2, OperandType::None},  // CB 50
+    {"BIT 2,C",   2, OperandType::None},  // CB 51
+    {"BIT 2,D",   2, OperandType::None},  // CB 52
+    {"BIT 2,E",   2, OperandType::None},  // CB 53
+    {"BIT 2,H",   2, OperandType::None},  // CB 54
+    {"BIT 2,L",   2, OperandType::None},  // CB 55
+    {"BIT 2,(HL)", 2, OperandType::None},  // CB 56
+    {"BIT 2,A",   2, OperandType::None},  // CB 57
+    {"BIT 3,B",   2, OperandType::None},  // CB 58
+    {"BIT 3,C",   2, OperandType::None},  // CB 59
+    {"BIT 3,D",   2, OperandType::None},  // CB 5A
+    {"BIT 3,E",   2, OperandType::None},  // CB 5B
+    {"BIT 3,H",   2, OperandType::None},  // CB 5C
+    {"BIT 3,L",   2, OperandType::None},  // CB 5D
+    {"BIT 3,(HL)", 2, OperandType::None},  // CB 5E
+    {"BIT 3,A",   2, OperandType::None},  // CB 5F
+    {"BIT 4,B",   2, OperandType::None},  // CB 60
+    {"BIT 4,C",   2, OperandType::None},  // CB 61
+    {"BIT 4,D",   2, OperandType::None},  // CB 62
+    {"BIT 4,E",   2, OperandType::None},  // CB 63
+    {"BIT 4,H",   2, OperandType::None},  // CB 64
+    {"BIT 4,L",   2, OperandType::None},  // CB 65
+    {"BIT 4,(HL)", 2, OperandType::None},  // CB 66
+    {"BIT 4,A",   2, OperandType::None},  // CB 67
+    {"BIT 5,B",   2, OperandType::None},  // CB 68
+    {"BIT 5,C",   2, OperandType::None},  // CB 69
+    {"BIT 5,D",   2, OperandType::None},  // CB 6A
+    {"BIT 5,E",   2, OperandType::None},  // CB 6B
+    {"BIT 5,H",   2, OperandType::None},  // CB 6C
+    {"BIT 5,L",   2, OperandType::None},  // CB 6D
+    {"BIT 5,(HL)", 2, OperandType::None},  // CB 6E
+    {"BIT 5,A",   2, OperandType::None},  // CB 6F
+    {"BIT 6,B",   2, OperandType::None},  // CB 70
+    {"BIT 6,C",   2, OperandType::None},  // CB 71
+    {"BIT 6,D",   2, OperandType::None},  // CB 72
+    {"BIT 6,E",   2, OperandType::None},  // CB 73
+    {"BIT 6,H",   2, OperandType::None},  // CB 74
+    {"BIT 6,L",   2, OperandType::None},  // CB 75
+    {"BIT 6,(HL)", 2, OperandType::None},  // CB 76
+    {"BIT 6,A",   2, OperandType::None},  // CB 77
+    {"BIT 7,B",   2, OperandType::None},  // CB 78
+    {"BIT 7,C",   2, OperandType::None},  // CB 79
+    {"BIT 7,D",   2, OperandType::None},  // CB 7A
+    {"BIT 7,E",   2, OperandType::None},  // CB 7B
+    {"BIT 7,H",   2, OperandType::None},  // CB 7C
+    {"BIT 7,L",   2, OperandType::None},  // CB 7D
+    {"BIT 7,(HL)", 2, OperandType::None},  // CB 7E
+    {"BIT 7,A",   2, OperandType::None},  // CB 7F
+    {"RES 0,B",   2, OperandType::None},  // CB 80
+    {"RES 0,C",   2, OperandType::None},  // CB 81
+    {"RES 0,D",   2, OperandType::None},  // CB 82
+    {"RES 0,E",   2, OperandType::None},  // CB 83
+    {"RES 0,H",   2, OperandType::None},  // CB 84
+    {"RES 0,L",   2, OperandType::None},  // CB 85
+    {"RES 0,(HL)", 2, OperandType::None},  // CB 86
+    {"RES 0,A",   2, OperandType::None},  // CB 87
+    {"RES 1,B",   2, OperandType::None},  // CB 88
+    {"RES 1,C",   2, OperandType::None},  // CB 89
+    {"RES 1,D",   2, OperandType::None},  // CB 8A
+    {"RES 1,E",   2, OperandType::None},  // CB 8B
+    {"RES 1,H",   2, OperandType::None},  // CB 8C
+    {"RES 1,L",   2, OperandType::None},  // CB 8D
+    {"RES 1,(HL)", 2, OperandType::None},  // CB 8E
+    {"RES 1,A",   2, OperandType::None},  // CB 8F
+    {"RES 2,B",   2, OperandType::None},  // CB 90
+    {"RES 2,C",   2, OperandType::None},  // CB 91
+    {"RES 2,D",   2, OperandType::None},  // CB 92
+    {"RES 2,E",   2, OperandType::None},  // CB 93
+    {"RES 2,H",   2, OperandType::None},  // CB 94
+    {"RES 2,L",   2, OperandType::None},  // CB 95
+    {"RES 2,(HL)", 2, OperandType::None},  // CB 96
+    {"RES 2,A",   2, OperandType::None},  // CB 97
+    {"RES 3,B",   2, OperandType::None},  // CB 98
+    {"RES 3,C",   2, OperandType::None},  // CB 99
+    {"RES 3,D",   2, OperandType::None},  // CB 9A
+    {"RES 3,E",   2, OperandType::None},  // CB 9B
+    {"RES 3,H",   2, OperandType::None},  // CB 9C
+    {"RES 3,L",   2, OperandType::None},  // CB 9D
+    {"RES 3,(HL)", 2, OperandType::None},  // CB 9E
+    {"RES 3,A",   2, OperandType::None},  // CB 9F
+    {"RES 4,B",   2, OperandType::None},  // CB A0
+    {"RES 4,C",   2, OperandType::None},  // CB A1
+    {"RES 4,D",   2, OperandType::None},  // CB A2
+    {"RES 4,E",   2, OperandType::None},  // CB A3
+    {"RES 4,H",   2, OperandType::None},  // CB A4
+    {"RES 4,L",   2, OperandType::None},  // CB A5
+    {"RES 4,(HL)", 2, OperandType::None},  // CB A6
+    {"RES 4,A",   2, OperandType::None},  // CB A7
+    {"RES 5,B",   2, OperandType::None},  // CB A8
+    {"RES 5,C",   2, OperandType::None},  // CB A9
+    {"RES 5,D",   2, OperandType::None},  // CB AA
+    {"RES 5,E",   2, OperandType::None},  // CB AB
+    {"RES 5,H",   2, OperandType::None},  // CB AC
+    {"RES 5,L",   2, OperandType::None},  // CB AD
+    {"RES 5,(HL)", 2, OperandType::None},  // CB AE
+    {"RES 5,A",   2, OperandType::None},  // CB AF
+    {"RES 6,B",   2, OperandType::None},  // CB B0
+    {"RES 6,C",   2, OperandType::None},  // CB B1
+    {"RES 6,D",   2, OperandType::None},  // CB B2
+    {"RES 6,E",   2, OperandType::None},  // CB B3
+    {"RES 6,H",   2, OperandType::None},  // CB B4
+    {"RES 6,L",   2, OperandType::None},  // CB B5
+    {"RES 6,(HL)", 2, OperandType::None},  // CB B6
+    {"RES 6,A",   2, OperandType::None},  // CB B7
+    {"RES 7,B",   2, OperandType::None},  // CB B8
+    {"RES 7,C",   2, OperandType::None},  // CB B9
+    {"RES 7,D",   2, OperandType::None},  // CB BA
+    {"RES 7,E",   2, OperandType::None},  // CB BB
+    {"RES 7,H",   2, OperandType::None},  // CB BC
+    {"RES 7,L",   2, OperandType::None},  // CB BD
+    {"RES 7,(HL)", 2, OperandType::None},  // CB BE
+    {"RES 7,A",   2, OperandType::None},  // CB BF
+    {"SET 0,B",   2, OperandType::None},  // CB C0
+    {"SET 0,C",   2, OperandType::None},  // CB C1
+    {"SET 0,D",   2, OperandType::None},  // CB C2
+    {"SET 0,E",   2, OperandType::None},  // CB C3
+    {"SET 0,H",   2, OperandType::None},  // CB C4
+    {"SET 0,L",   2, OperandType::None},  // CB C5
+    {"SET 0,(HL)", 2, OperandType::None},  // CB C6
+    {"SET 0,A",   2, OperandType::None},  // CB C7
+    {"SET 1,B",   2, OperandType::None},  // CB C8
+    {"SET 1,C",   2, OperandType::None},  // CB C9
+    {"SET 1,D",   2, OperandType::None},  // CB CA
+    {"SET 1,E",   2, OperandType::None},  // CB CB
+    {"SET 1,H",   2, OperandType::None},  // CB CC
+    {"SET 1,L",   2, OperandType::None},  // CB CD
+    {"SET 1,(HL)", 2, OperandType::None},  // CB CE
+    {"SET 1,A",   2, OperandType::None},  // CB CF
+    {"SET 2,B",   2, OperandType::None},  // CB D0
+    {"SET 2,C",   2, OperandType::None},  // CB D1
+    {"SET 2,D",   2, OperandType::None},  // CB D2
+    {"SET 2,E",   2, OperandType::None},  // CB D3
+    {"SET 2,H",   2, OperandType::None},  // CB D4
+    {"SET 2,L",   2, OperandType::None},  // CB D5
+    {"SET 2,(HL)", 2, OperandType::None},  // CB D6
+    {"SET 2,A",   2, OperandType::None},  // CB D7
+    {"SET 3,B",   2, OperandType::None},  // CB D8
+    {"SET 3,C",   2, OperandType::None},  // CB D9
+    {"SET 3,D",   2, OperandType::None},  // CB DA
+    {"SET 3,E",   2, OperandType::None},  // CB DB
+    {"SET 3,H",   2, OperandType::None},  // CB DC
+    {"SET 3,L",   2, OperandType::None},  // CB DD
+    {"SET 3,(HL)", 2, OperandType::None},  // CB DE
+    {"SET 3,A",   2, OperandType::None},  // CB DF
+    {"SET 4,B",   2, OperandType::None},  // CB E0
+    {"SET 4,C",   2, OperandType::None},  // CB E1
+    {"SET 4,D",   2, OperandType::None},  // CB E2
+    {"SET 4,E",   2, OperandType::None},  // CB E3
+    {"SET 4,H",   2, OperandType::None},  // CB E4
+    {"SET 4,L",   2, OperandType::None},  // CB E5
+    {"SET 4,(HL)", 2, OperandType::None},  // CB E6
+    {"SET 4,A",   2, OperandType::None},  // CB E7
+    {"SET 5,B",   2, OperandType::None},  // CB E8
+    {"SET 5,C",   2, OperandType::None},  // CB E9
+    {"SET 5,D",   2, OperandType::None},  // CB EA
+    {"SET 5,E",   2, OperandType::None},  // CB EB
+    {"SET 5,H",   2, OperandType::None},  // CB EC
+    {"SET 5,L",   2, OperandType::None},  // CB ED
+    {"SET 5,(HL)", 2, OperandType::None},  // CB EE
+    {"SET 5,A",   2, OperandType::None},  // CB EF
+    {"SET 6,B",   2, OperandType::None},  // CB F0
+    {"SET 6,C",   2, OperandType::None},  // CB F1
+    {"SET 6,D",   2, OperandType::None},  // CB F2
+    {"SET 6,E",   2, OperandType::None},  // CB F3
+    {"SET 6,H",   2, OperandType::None},  // CB F4
+    {"SET 6,L",   2, OperandType::None},  // CB F5
+    {"SET 6,(HL)", 2, OperandType::None},  // CB F6
+    {"SET 6,A",   2, OperandType::None},  // CB F7
+    {"SET 7,B",   2, OperandType::None},  // CB F8
+    {"SET 7,C",   2, OperandType::None},  // CB F9
+    {"SET 7,D",   2, OperandType::None},  // CB FA
+    {"SET 7,E",   2, OperandType::None},  // CB FB
+    {"SET 7,H",   2, OperandType::None},  // CB FC
+    {"SET 7,L",   2, OperandType::None},  // CB FD
+    {"SET 7,(HL)", 2, OperandType::None},  // CB FE
+    {"SET 7,A",   2, OperandType::None},  // CB FF
+};
+
+const size_t PAGES_PER_BANK = 0x4000 / 256;
+
+int PageIndex(uint16_t address, int bank, bool banked) {
+    if (!banked || bank <= 0) {
+        return address >> 8;
+    }
+    return 256 + bank * static_cast<int>(PAGES_PER_BANK) + ((address - 0x4000) >> 8);
+}
+
+} // namespace
+
+Disassembler::Disassembler()
+    : decodeCount_(0)
+    , sweepCount_(0) {
+}
+
+const OpcodeInfo& Disassembler::GetOpcodeInfo(uint8_t opcode) {
+    return BASE_OPCODES[opcode];
+}
+
+const OpcodeInfo& Disassembler::GetCBOpcodeInfo(uint8_t opcode) {
+    return CB_OPCODES[opcode];
+}
+
+void Disassembler::Decode(const uint8_t* memory, uint16_t address, DisassembledInstruction& out) {
+    uint8_t opcode = memory[address];
+    uint8_t low = memory[static_cast<uint16_t>(address + 1)];
+    uint8_t high = memory[static_cast<uint16_t>(address + 2)];
+    
+    const OpcodeInfo& info = opcode == 0xCB ? CB_OPCODES[low] : BASE_OPCODES[opcode];
+    
+    int operand = 0;
+    switch (info.operand) {
+        case OperandType::None:      break;
+        case OperandType::Imm8:      operand = low; break;
+        case OperandType::Imm16:     operand = low | (high << 8); break;
+        case OperandType::Relative8: operand = static_cast<uint16_t>(address + 2 + static_cast<int8_t>(low)); break;
+        case OperandType::HighPage8: operand = low; break;
+        case OperandType::Signed8:   operand = static_cast<int8_t>(low); break;
+        case OperandType::Invalid:   operand = opcode; break;
+    }
+    
+    out.address = address;
+    out.length = info.length;
+    out.bytes[0] = opcode;
+    out.bytes[1] = low;
+    out.bytes[2] = high;
+    std::snprintf(out.text, sizeof(out.text), info.format, operand);
+}
+
+const DisassembledInstruction& Disassembler::Get(const uint8_t* memory, uint16_t address, int bank) {
+    size_t index = PageIndex(address, bank, IsBanked(address));
+    if (index >= pages_.size()) {
+        pages_.resize(index + 1);
+    }
+    if (!pages_[index]) {
+        pages_[index].reset(new CachePage());
+    }
+    
+    CachePage& page = *pages_[index];
+    DisassembledInstruction& entry = page.entries[address & 0xFF];
+    
+    // A cached decode stays valid for as long as its bytes are unchanged
+    if (page.valid[address & 0xFF]) {
+        bool same = true;
+        for (uint8_t i = 0; i < entry.length && same; i++) {
+            same = entry.bytes[i] == memory[static_cast<uint16_t>(address + i)];
+        }
+        if (same) {
+            return entry;
+        }
+    }
+    
+    Decode(memory, address, entry);
+    page.valid.set(address & 0xFF);
+    decodeCount_++;
+    return entry;
+}
+
+const std::vector<uint16_t>& Disassembler::GetLines(const uint8_t* memory, uint16_t address, int bank) {
+    uint32_t start = address & ~static_cast<uint32_t>(REGION_SIZE - 1);
+    int key = IsBanked(address) ? 4 + std::max(bank, 0) : static_cast<int>(start / REGION_SIZE);
+    
+    if (regions_.size() >= MAX_REGIONS && regions_.find(key) == regions_.end()) {
+        regions_.clear();
+    }
+    RegionLines& region = regions_[key];
+    
+    // Comparing 16KB is far cheaper than sweeping it
+    if (region.bytes.empty() || std::memcmp(region.bytes.data(), memory + start, REGION_SIZE) != 0) {
+        region.bytes.assign(memory + start, memory + start + REGION_SIZE);
+        Sweep(memory, start, region);
+    }
+    
+    if (!std::binary_search(region.lines.begin(), region.lines.end(), address)) {
+        // The sweep stepped over this address (data, or a jump into the
+        // middle of an instruction): resynchronize on it
+        if (region.anchors.size() >= MAX_ANCHORS) {
+            region.anchors.clear();
+        }
+        region.anchors.insert(std::lower_bound(region.anchors.begin(), region.anchors.end(), address), address);
+        Sweep(memory, start, region);
+    }
+    
+    return region.lines;
+}
+
+void Disassembler::Clear() {
+    pages_.clear();
+    regions_.clear();
+}
+
+void Disassembler::Sweep(const uint8_t* memory, uint32_t start, RegionLines& region) {
+    uint32_t end = start + REGION_SIZE;
+    std::vector<uint16_t>::const_iterator anchor = region.anchors.begin();
+    
+    region.lines.clear();
+    for (uint32_t address = start; address < end; ) {
+        region.lines.push_back(static_cast<uint16_t>(address));
+        uint32_t next = address + BASE_OPCODES[memory[address]].length;
+        
+        while (anchor != region.anchors.end() && *anchor <= address) {
+            ++anchor;
+        }
+        if (anchor != region.anchors.end() && *anchor < next) {
+            next = *anchor;
+        }
+        address = next;
+    }
+    sweepCount_++;
+}
+
+} // namespace GBDebug
@@ -0,0 +1,223 @@
+#include "FrameCompositor.h"
+#include "SpriteOccupancy.h"
+#include "TileDecoder.h"
+#include "TilemapComposer.h"
+
+namespace GBDebug {
+
+constexpr int FrameCompositor::WIDTH;
+constexpr int FrameCompositor::HEIGHT;
+constexpr size_t FrameCompositor::PIXEL_COUNT;
+constexpr int FrameCompositor::MAX_SPRITES_PER_LINE;
+
+static_assert(FrameCompositor::MAX_SPRITES_PER_LINE == SpriteLine::MAX_DRAWN,
+              "sprite selection comes from SpriteOccupancy::SelectLine()");
+
+namespace {
+
+constexpr uint16_t VRAM_START = 0x8000;
+constexpr uint16_t OAM_START = 0xFE00;
+constexpr size_t MAP_9800 = 0x1800;
+constexpr size_t MAP_9C00 = 0x1C00;
+
+// LCD off shows a blank screen: lightest DMG shade, white on CGB
+constexpr uint16_t DMG_BLANK = 0;
+constexpr uint16_t CGB_BLANK = 0x7FFF;
+
+// Stand-ins for inputs a DMG-only host does not have
+const uint8_t EMPTY_BANK[0x2000] = {};
+const CGBPalette EMPTY_PALETTES[8];
+
+} // namespace
+
+FrameCompositor::FrameCompositor()
+    : oam_(nullptr)
+    , bgPalettes_(EMPTY_PALETTES)
+    , spritePalettes_(EMPTY_PALETTES)
+    , cgb_(false)
+    , mismatchCount_(0)
+    , firstMismatch_(-1) {
+    vram_[0] = EMPTY_BANK;
+    vram_[1] = EMPTY_BANK;
+    frame_.fill(DMG_BLANK);
+    spriteCounts_.fill(0);
+}
+
+void FrameCompositor::Compose(const uint8_t* memory, const uint8_t* vramBank1,
+                              const CGBPalette* bgPalettes, const CGBPalette* spritePalettes,
+                              EmulationMode mode, const ScanlineTimeline* scanlines) {
+    cgb_ = mode == EmulationMode::CGB;
+    vram_[0] = memory + VRAM_START;
+    vram_[1] = cgb_ && vramBank1 != nullptr ? vramBank1 : EMPTY_BANK;
+    oam_ = memory + OAM_START;
+    bgPalettes_ = bgPalettes != nullptr ? bgPalettes : EMPTY_PALETTES;
+    spritePalettes_ = spritePalettes != nullptr ? spritePalettes : EMPTY_PALETTES;
+
+    const ScanlineRegisters memoryRegisters = ScanlineTimeline::ReadRegisters(memory);
+    const bool perLine = scanlines != nullptr && scanlines->HasFrame();
+
+    LineBG line;
+    int windowLine = 0;
+    bool windowTriggered = false;
+    for (int ly = 0; ly < HEIGHT; ly++) {
+        const ScanlineRegisters& registers = perLine ? scanlines->GetLine(ly) : memoryRegisters;
+        uint16_t* out = frame_.data() + ly * WIDTH;
+        spriteCounts_[ly] = 0;
+
+        if ((registers.lcdc & 0x80) == 0) {
+            std::fill(out, out + WIDTH, cgb_ ? CGB_BLANK : DMG_BLANK);
+            continue;
+        }
+
+        // On DMG, LCDC bit 0 turns BG and window off; on CGB it only
+        // takes away their priority over sprites
+        const bool bgEnabled = cgb_ || (registers.lcdc & 0x01) != 0;
+        if (bgEnabled) {
+            int mapY = (registers.scy + ly) & 0xFF;
+            FetchMapRow(registers, (registers.lcdc & 0x08) != 0, registers.scx >> 3, registers.scx & 7,
+                        mapY, 0, line);
+        } else {
+            line.color.fill(0);
+            line.palette.fill(0);
+            line.priority.fill(0);
+        }
+
+        // The window starts on the line where LY matches WY, then draws its
+        // own rows in order on every line it is shown
+        if (registers.wy == ly) {
+            windowTriggered = true;
+        }
+        int windowX = registers.wx - 7;
+        if (bgEnabled && (registers.lcdc & 0x20) != 0 && windowTriggered && windowX < WIDTH) {
+            FetchMapRow(registers, (registers.lcdc & 0x40) != 0, 0, windowX < 0 ? -windowX : 0,
+                        windowLine & 0xFF, windowX > 0 ? windowX : 0, line);
+            windowLine++;
+        }
+
+        if (cgb_) {
+            for (int x = 0; x < WIDTH; x++) {
+                out[x] = bgPalettes_[line.palette[x]].colors[line.color[x]] & 0x7FFF;
+            }
+        } else if (bgEnabled) {
+            for (int x = 0; x < WIDTH; x++) {
+                out[x] = (registers.bgp >> (line.color[x] * 2)) & 0x03;
+            }
+        } else {
+            std::fill(out, out + WIDTH, DMG_BLANK);
+        }
+
+        if ((registers.lcdc & 0x02) != 0) {
+            DrawSprites(ly, registers, line, out);
+        }
+    }
+}
+
+void FrameCompositor::FetchMapRow(const ScanlineRegisters& registers, bool highMap, int mapX, int fineX,
+                                  int mapY, int startX, LineBG& line) const {
+    size_t rowOffset = (highMap ? MAP_9C00 : MAP_9800) + (mapY >> 3) * 32;
+    const uint8_t* map = vram_[0] + rowOffset;
+    const uint8_t* attributes = vram_[1] + rowOffset;
+    const bool unsignedMode = (registers.lcdc & 0x10) != 0;
+
+    uint8_t pixels[8];
+    int x = startX;
+    int skip = fineX;
+    int column = mapX;
+    while (x < WIDTH) {
+        uint8_t attribute = cgb_ ? attributes[column] : 0;
+        int row = (attribute & 0x40) ? 7 - (mapY & 7) : (mapY & 7);
+        DecodeRow((attribute >> 3) & 1, TilemapComposer::ResolveTile(map[column], unsignedMode), row,
+                  (attribute & 0x20) != 0, pixels);
+
+        for (int i = skip; i < 8 && x < WIDTH; i++, x++) {
+            line.color[x] = pixels[i];
+            line.palette[x] = attribute & 0x07;
+            line.priority[x] = attribute >> 7;
+        }
+        skip = 0;
+        column = (column + 1) & 31;
+    }
+}
+
+void FrameCompositor::DrawSprites(int ly, const ScanlineRegisters& registers, const LineBG& line,
+                                  uint16_t* out) {
+    const int height = (registers.lcdc & 0x04) ? 16 : 8;
+
+    // Selection and drawing order shared with the VRAM viewer's occupancy
+    SpriteLine selection;
+    SpriteOccupancy::SelectLine(oam_, ly, height, cgb_, selection);
+    spriteCounts_[ly] = selection.drawnCount;
+
+    // The highest-priority opaque sprite pixel decides, even when the
+    // background then hides it
+    std::array<bool, WIDTH> taken;
+    taken.fill(false);
+    uint8_t pixels[8];
+    for (int k = 0; k < selection.drawnCount; k++) {
+        const uint8_t* entry = oam_ + selection.order[k] * 4;
+        int left = entry[1] - 8;
+        if (left <= -8 || left >= WIDTH) {
+            continue;
+        }
+
+        uint8_t attribute = entry[3];
+        int row = ly - (entry[0] - 16);
+        if (attribute & 0x40) {
+            row = height - 1 - row;
+        }
+        uint16_t tile = entry[2];
+        if (height == 16) {
+            tile = static_cast<uint16_t>((tile & 0xFE) | (row >> 3));
+        }
+        DecodeRow(cgb_ ? (attribute >> 3) & 1 : 0, tile, row & 7, (attribute & 0x20) != 0, pixels);
+
+        const uint8_t palette = cgb_ ? (attribute & 0x07) : ((attribute & 0x10) ? registers.obp1 : registers.obp0);
+        for (int i = 0; i < 8; i++) {
+            int x = left + i;
+            uint8_t color = pixels[i];
+            if (x < 0 || x >= WIDTH || color == 0 || taken[x]) {
+                continue;
+            }
+            taken[x] = true;
+
+            bool bgWins;
+            if (cgb_) {
+                bgWins = (registers.lcdc & 0x01) != 0 && line.color[x] != 0 &&
+                         ((attribute & 0x80) != 0 || line.priority[x] != 0);
+            } else {
+                bgWins = (attribute & 0x80) != 0 && line.color[x] != 0;
+            }
+            if (!bgWins) {
+                out[x] = cgb_ ? (spritePalettes_[palette].colors[color] & 0x7FFF)
+                              : static_cast<uint16_t>((palette >> (color * 2)) & 0x03);
+            }
+        }
+    }
+}
+
+void FrameCompositor::DecodeRow(int bank, uint16_t tile, int row, bool hFlip, uint8_t* out) const {
+    const uint8_t* data = vram_[bank] + tile * 16 + row * 2;
+    if (hFlip) {
+        TileDecoder::DecodeTileRow(TileDecoder::ReverseBits(data[0]), TileDecoder::ReverseBits(data[1]), out);
+    } else {
+        TileDecoder::DecodeTileRow(data[0], data[1], out);
+    }
+}
+
+size_t FrameCompositor::Compare(const uint16_t* reference) {
+    const uint16_t mask = cgb_ ? 0x7FFF : 0x0003;
+    mismatches_.reset();
+    mismatchCount_ = 0;
+    firstMismatch_ = -1;
+    for (size_t i = 0; i < PIXEL_COUNT; i++) {
+        if (((frame_[i] ^ reference[i]) & mask) != 0) {
+            mismatches_.set(i);
+            if (mismatchCount_++ == 0) {
+                firstMismatch_ = static_cast<int>(i);
+            }
+        }
+    }
+    return mismatchCount_;
+}
+
+} // namespace GBDebug
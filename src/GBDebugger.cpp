@@ -1,14 +1,39 @@
 #include "GBDebugger.h"
 #include "DebuggerBackend.h"
 #include "DebuggerTypes.h"
+#include "SnapshotChannel.h"
+#include "BreakpointManager.h"
+#include "WatchpointManager.h"
 #include "panels/CPUStatePanel.h"
 #include "panels/FlagsPanel.h"
 #include "panels/MemoryViewerPanel.h"
 #include "panels/ControlPanel.h"
 #include "panels/VRAMViewerPanel.h"
+#include "panels/TilemapPanel.h"
+#include "panels/ScanlinePanel.h"
+#include "panels/ScreenPanel.h"
+#include "panels/BreakpointsPanel.h"
+#include "panels/DisassemblyPanel.h"
+#include "panels/TracePanel.h"
+#include "panels/HistoryPanel.h"
+#include "StateHistory.h"
 
 namespace GBDebug {
 
+namespace {
+
+// Keep drawing for a moment after input so hover and click feedback settles
+constexpr std::chrono::milliseconds INPUT_SETTLE_TIME(250);
+
+// Memory map addresses routed to the VRAM viewer
+constexpr uint32_t CGB_FLAG_ADDRESS = 0x0143;
+constexpr uint32_t VRAM_START = 0x8000;
+constexpr uint32_t VRAM_END = 0xA000;    // exclusive
+constexpr uint32_t OAM_START = 0xFE00;
+constexpr uint32_t OAM_END = 0xFEA0;     // exclusive
+
+} // namespace
+
 GBDebugger::GBDebugger()
     : backend_(new DebuggerBackend())
     , cpu_panel_(new CPUStatePanel())
@@ -16,7 +41,34 @@ GBDebugger::GBDebugger()
     , memory_panel_(new MemoryViewerPanel())
     , control_panel_(new ControlPanel())
     , vram_panel_(new VRAMViewerPanel())
-    , is_open_(false) {
+    , tilemap_panel_(new TilemapPanel())
+    , scanlines_(new ScanlineTimeline())
+    , scanline_panel_(new ScanlinePanel(*scanlines_))
+    , screen_panel_(new ScreenPanel())
+    , breakpoints_(new BreakpointManager())
+    , watchpoints_(new WatchpointManager())
+    , breakpoints_panel_(new BreakpointsPanel(*breakpoints_, *watchpoints_))
+    , disassembly_panel_(new DisassemblyPanel(*breakpoints_))
+    , trace_(new TraceBuffer())
+    , trace_file_(new TraceFileWriter())
+    , trace_panel_(new TracePanel(*trace_, *trace_file_))
+    , history_(new StateHistory())
+    , history_panel_(new HistoryPanel(*history_))
+    , showing_history_(false)
+    , breakpoint_bits_(breakpoints_->GetHotBits())
+    , watch_pages_(watchpoints_->GetPageFlags())
+    , break_suppressed_(false)
+    , break_pc_(0)
+    , break_cycle_(0)
+    , break_has_cycle_(false)
+    , shown_watch_hit_(0)
+    , snapshots_(new SnapshotChannel<DebugSnapshot>())
+    , publish_generation_(0)
+    , is_open_(false)
+    , target_ui_rate_(0.0f)
+    , skip_frame_(false)
+    , state_generation_(1)
+    , rendered_generation_(0) {
 }
 
 GBDebugger::~GBDebugger() {
@@ -55,30 +107,104 @@ bool GBDebugger::ShouldClose() const {
 
 void GBDebugger::ProcessSDLEvent(SDL_Event* event) {
     backend_->ProcessEvent(event);
+    last_input_time_ = Clock::now();
 }
 
 void GBDebugger::BeginFrame() {
-    if (is_open_) {
+    if (is_open_ && !skip_frame_) {
         backend_->BeginFrame();
     }
 }
 
 void GBDebugger::Render() {
-    if (!is_open_) {
+    if (!is_open_ || skip_frame_) {
         return;
     }
     
+    ApplyLatestSnapshot();
+    
+    uint64_t seekCycle;
+    if (history_panel_->ConsumeSeekRequest(seekCycle)) {
+        SeekToCycle(seekCycle);
+    }
+    rendered_generation_ = state_generation_.load(std::memory_order_relaxed);
+    
+    // Point the memory viewer at a new watchpoint hit
+    uint32_t watchHit = watchpoints_->GetHitSequence();
+    if (watchHit != shown_watch_hit_) {
+        WatchHit hit;
+        shown_watch_hit_ = watchpoints_->GetLastHit(hit);
+        memory_panel_->HighlightAddress(hit.address);
+    }
+    
     cpu_panel_->Render();
     flags_panel_->Render();
     memory_panel_->Render();
     control_panel_->Render();
+    if (memory_panel_->GetMemory() != nullptr) {
+        vram_panel_->SetLCDC(memory_panel_->GetMemory()[0xFF40]);
+    }
     vram_panel_->Render();
+    tilemap_panel_->Update(memory_panel_->GetMemory(), vram_panel_->GetVRAMBank(1),
+                           vram_panel_->GetBGPalettes(), vram_panel_->GetEmulationMode(),
+                           scanlines_.get());
+    tilemap_panel_->Render();
+    scanline_panel_->Render();
+    screen_panel_->Update(memory_panel_->GetMemory(), vram_panel_->GetVRAMBank(1),
+                          vram_panel_->GetBGPalettes(), vram_panel_->GetSpritePalettes(),
+                          vram_panel_->GetEmulationMode(), scanlines_.get(), rendered_generation_);
+    screen_panel_->Render();
+    breakpoints_panel_->SetMemory(memory_panel_->GetMemory());
+    breakpoints_panel_->Render();
+    
+    disassembly_panel_->Update(memory_panel_->GetMemory(), cpu_panel_->GetState().pc);
+    disassembly_panel_->Render();
+    trace_panel_->Render();
+    history_panel_->Render();
 }
 
 void GBDebugger::EndFrame() {
-    if (is_open_) {
+    if (is_open_ && !skip_frame_) {
         backend_->EndFrame();
     }
+    
+    // A skip decision only covers the frame it was made for
+    skip_frame_ = false;
+}
+
+void GBDebugger::SetTargetUIRate(float hz) {
+    target_ui_rate_ = hz > 0.0f ? hz : 0.0f;
+    backend_->SetVSync(target_ui_rate_ == 0.0f);
+}
+
+float GBDebugger::GetTargetUIRate() const {
+    return target_ui_rate_;
+}
+
+bool GBDebugger::ShouldRender() {
+    skip_frame_ = true;
+    if (!is_open_) {
+        return false;
+    }
+    
+    Clock::time_point now = Clock::now();
+    if (target_ui_rate_ > 0.0f) {
+        std::chrono::duration<float> interval(1.0f / target_ui_rate_);
+        if (now - last_render_time_ < interval) {
+            return false;
+        }
+    }
+    
+    bool stateChanged = state_generation_.load(std::memory_order_relaxed) != rendered_generation_ ||
+                        snapshots_->HasPending();
+    bool inputActive = now - last_input_time_ < INPUT_SETTLE_TIME;
+    if (!stateChanged && !inputActive) {
+        return false;
+    }
+    
+    skip_frame_ = false;
+    last_render_time_ = now;
+    return true;
 }
 
 void GBDebugger::UpdateCPU(
@@ -103,6 +229,19 @@ void GBDebugger::UpdateCPU(
     
     cpu_panel_->Update(state);
     flags_panel_->Update(state);
+    scanlines_->Latch();
+    showing_history_ = false;
+    MarkStateChanged();
+}
+
+void GBDebugger::DetectEmulationMode(uint8_t cgbFlag) {
+    // Auto-detect CGB mode from cartridge header (0x0143)
+    // 0x80 = CGB compatible, 0xC0 = CGB only
+    if (cgbFlag == 0x80 || cgbFlag == 0xC0) {
+        vram_panel_->SetEmulationMode(EmulationMode::CGB);
+    } else {
+        vram_panel_->SetEmulationMode(EmulationMode::DMG);
+    }
 }
 
 bool GBDebugger::UpdateMemory(const uint8_t* buffer, size_t size) {
@@ -111,25 +250,307 @@ bool GBDebugger::UpdateMemory(const uint8_t* buffer, size_t size) {
     // Also update VRAM panel with the same memory buffer
     // VRAM panel will extract VRAM (0x8000-0x9FFF) and OAM (0xFE00-0xFE9F) from it
     if (result && buffer != nullptr && size == 65536) {
-        // Auto-detect CGB mode from cartridge header (0x0143)
-        // 0x80 = CGB compatible, 0xC0 = CGB only
-        uint8_t cgbFlag = buffer[0x0143];
-        if (cgbFlag == 0x80 || cgbFlag == 0xC0) {
-            vram_panel_->SetEmulationMode(EmulationMode::CGB);
-        } else {
-            vram_panel_->SetEmulationMode(EmulationMode::DMG);
-        }
+        vram_panel_->ReleaseMemory();
+        DetectEmulationMode(buffer[CGB_FLAG_ADDRESS]);
         
         // Extract VRAM (0x8000-0x9FFF = 8KB)
         vram_panel_->UpdateVRAM(buffer + 0x8000, 8192, 0);
         
         // Extract OAM (0xFE00-0xFE9F = 160 bytes)
         vram_panel_->UpdateOAM(buffer + 0xFE00, 160);
+        MarkStateChanged();
     }
     
     return result;
 }
 
+void GBDebugger::RouteRangeToVRAMPanel(uint16_t address, const uint8_t* data, size_t length) {
+    uint32_t start = address;
+    uint32_t end = start + static_cast<uint32_t>(length);
+    
+    if (start <= CGB_FLAG_ADDRESS && end > CGB_FLAG_ADDRESS) {
+        DetectEmulationMode(data[CGB_FLAG_ADDRESS - start]);
+    }
+    
+    // Clip the range against VRAM and OAM; most writes hit neither
+    uint32_t lo = start > VRAM_START ? start : VRAM_START;
+    uint32_t hi = end < VRAM_END ? end : VRAM_END;
+    if (lo < hi) {
+        vram_panel_->UpdateVRAMRange(lo - VRAM_START, data + (lo - start), hi - lo, 0);
+    }
+    
+    lo = start > OAM_START ? start : OAM_START;
+    hi = end < OAM_END ? end : OAM_END;
+    if (lo < hi) {
+        vram_panel_->UpdateOAMRange(lo - OAM_START, data + (lo - start), hi - lo);
+    }
+}
+
+bool GBDebugger::UpdateMemoryRange(uint16_t address, const uint8_t* data, size_t length) {
+    // Ranges patch the owned copies, so stop reading borrowed memory first
+    if (memory_panel_->IsBorrowed()) {
+        ReleaseMemory();
+    }
+    
+    if (!memory_panel_->UpdateRange(address, data, length)) {
+        return false;
+    }
+    
+    RouteRangeToVRAMPanel(address, data, length);
+    MarkStateChanged();
+    return true;
+}
+
+bool GBDebugger::ApplyWriteLog(const WriteRecord* records, size_t count) {
+    if (records == nullptr) {
+        return count == 0;
+    }
+    
+    if (memory_panel_->IsBorrowed()) {
+        ReleaseMemory();
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        const WriteRecord& record = records[i];
+        memory_panel_->UpdateRange(record.address, &record.value, 1);
+        RouteRangeToVRAMPanel(record.address, &record.value, 1);
+    }
+    if (count > 0) {
+        MarkStateChanged();
+    }
+    return true;
+}
+
+const uint8_t* GBDebugger::GetMemory() const {
+    return memory_panel_->GetMemory();
+}
+
+const uint8_t* GBDebugger::GetVRAMBank(int bank) const {
+    return vram_panel_->GetVRAMBank(bank == 1 ? 1 : 0);
+}
+
+const uint8_t* GBDebugger::GetOAM() const {
+    return vram_panel_->GetOAM();
+}
+
+bool GBDebugger::IsCGBMode() const {
+    return vram_panel_->GetEmulationMode() == EmulationMode::CGB;
+}
+
+bool GBDebugger::UpdateFramebuffer(const uint16_t* pixels, size_t count) {
+    if (pixels == nullptr || count != FrameCompositor::PIXEL_COUNT) {
+        return false;
+    }
+    screen_panel_->SetReference(pixels);
+    MarkStateChanged();
+    return true;
+}
+
+DebugSnapshot& GBDebugger::BeginPublish() {
+    return snapshots_->GetBack();
+}
+
+void GBDebugger::EndPublish() {
+    // Scanlines are recorded on this thread; hand them over with the snapshot
+    DebugSnapshot& snapshot = snapshots_->GetBack();
+    snapshot.hasScanlines = scanlines_->HasPending();
+    if (snapshot.hasScanlines) {
+        snapshot.scanlines = scanlines_->GetRecording();
+        scanlines_->ClearPending();
+    }
+    snapshot.generation = ++publish_generation_;
+    snapshots_->Publish();
+}
+
+void GBDebugger::ApplyLatestSnapshot() {
+    if (!snapshots_->Acquire()) {
+        return;
+    }
+    
+    // The front slot stays untouched until the next Acquire(), so panels
+    // can borrow it instead of copying
+    const DebugSnapshot& snapshot = snapshots_->GetFront();
+    cpu_panel_->Update(snapshot.cpu);
+    flags_panel_->Update(snapshot.cpu);
+    showing_history_ = false;
+    BorrowMemory(snapshot.memory.data(), snapshot.memory.size(), snapshot.generation);
+    SetROMBank(snapshot.romBank);
+    
+    const uint8_t* vramBank1 = snapshot.hasVRAMBank1 ? snapshot.vramBank1.data() : nullptr;
+    if (vramBank1 != nullptr) {
+        vram_panel_->UpdateVRAM(vramBank1, snapshot.vramBank1.size(), 1);
+    }
+    if (snapshot.hasCGBPalettes) {
+        vram_panel_->UpdatePalettes(snapshot.bgPalettes.data(), snapshot.spritePalettes.data());
+    }
+    if (snapshot.hasScanlines) {
+        scanlines_->SetFrame(snapshot.scanlines);
+    }
+    if (snapshot.hasFramebuffer) {
+        screen_panel_->SetReference(snapshot.framebuffer.data());
+    }
+    
+    if (history_->IsEnabled()) {
+        history_->Capture(snapshot.cpu, snapshot.memory.data(), vramBank1,
+                          snapshot.hasCGBPalettes ? snapshot.bgPalettes.data() : nullptr,
+                          snapshot.hasCGBPalettes ? snapshot.spritePalettes.data() : nullptr);
+    }
+}
+
+void GBDebugger::SetROMBank(int bank) {
+    disassembly_panel_->SetROMBank(bank);
+}
+
+bool GBDebugger::BorrowMemory(const uint8_t* buffer, size_t size, uint64_t generation) {
+    uint64_t previousGeneration = memory_panel_->GetGeneration();
+    bool wasBorrowed = memory_panel_->IsBorrowed();
+    if (!memory_panel_->Borrow(buffer, size, generation)) {
+        return false;
+    }
+    if (!wasBorrowed || generation != previousGeneration) {
+        MarkStateChanged();
+    }
+    
+    DetectEmulationMode(buffer[CGB_FLAG_ADDRESS]);
+    vram_panel_->BorrowMemory(buffer + 0x8000, buffer + 0xFE00, generation);
+    return true;
+}
+
+void GBDebugger::ReleaseMemory() {
+    memory_panel_->Release();
+    vram_panel_->ReleaseMemory();
+}
+
+bool GBDebugger::HandleBreakpoint(uint16_t pc, int bank, const CPUState* cpu, const uint8_t* memory) {
+    // Resuming from a breakpoint executes the instruction it stopped on.
+    // The pass is spent by the first check after the stop, so coming back
+    // to the address later breaks again
+    bool live = cpu != nullptr;
+    if (break_suppressed_.exchange(false, std::memory_order_relaxed) && break_pc_ == pc &&
+        (!live || !break_has_cycle_ || break_cycle_ == cpu->cycle)) {
+        return false;
+    }
+    
+    // Conditions need live registers and memory. The panels belong to the
+    // UI thread and show an older state, so without both a conditional
+    // breakpoint does not fire
+    const CPUState* conditionCpu = memory != nullptr ? cpu : nullptr;
+    if (!breakpoints_->Check(pc, bank, conditionCpu, memory)) {
+        return false;
+    }
+    
+    break_pc_ = pc;
+    break_cycle_ = live ? cpu->cycle : 0;
+    break_has_cycle_ = live;
+    break_suppressed_.store(true, std::memory_order_relaxed);
+    SetRunning(false);
+    return true;
+}
+
+bool GBDebugger::HandleWatchAccess(uint16_t address, uint8_t value, bool isWrite) {
+    if (!watchpoints_->Check(address, value, isWrite)) {
+        return false;
+    }
+    
+    SetRunning(false);
+    return true;
+}
+
+void GBDebugger::AddWatchpoint(const Watchpoint& watch) {
+    watchpoints_->Add(watch, memory_panel_->GetMemory());
+    MarkStateChanged();
+}
+
+bool GBDebugger::AddBreakpoint(uint16_t address, int bank, const char* condition) {
+    bool added = breakpoints_->Add(address, bank);
+    MarkStateChanged();
+    if (condition == nullptr) {
+        return added;
+    }
+    
+    std::string error;
+    int index = breakpoints_->Find(address, bank);
+    if (index < 0 || !breakpoints_->SetCondition(index, condition, error)) {
+        if (added) {
+            breakpoints_->Remove(address, bank);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool GBDebugger::RemoveBreakpoint(uint16_t address, int bank) {
+    bool removed = breakpoints_->Remove(address, bank);
+    MarkStateChanged();
+    return removed;
+}
+
+void GBDebugger::SetTraceCapacity(size_t records) {
+    trace_->SetCapacity(records);
+    MarkStateChanged();
+}
+
+bool GBDebugger::StartTraceFile(const char* path) {
+    std::string error;
+    bool opened = trace_file_->Open(path, error);
+    MarkStateChanged();
+    return opened;
+}
+
+bool GBDebugger::StopTraceFile() {
+    bool ok = trace_file_->Close();
+    MarkStateChanged();
+    return ok;
+}
+
+void GBDebugger::SetHistoryBudget(size_t bytes) {
+    history_->SetBudget(bytes);
+    MarkStateChanged();
+}
+
+bool GBDebugger::CaptureHistory() {
+    // A seek put a recorded step on display; recording it again would
+    // append an old cycle after newer ones
+    const uint8_t* memory = memory_panel_->GetMemory();
+    if (memory == nullptr || showing_history_) {
+        return false;
+    }
+    
+    bool captured = history_->Capture(cpu_panel_->GetState(), memory, vram_panel_->GetVRAMBank(1),
+                                      vram_panel_->GetBGPalettes(), vram_panel_->GetSpritePalettes());
+    if (captured) {
+        MarkStateChanged();
+    }
+    return captured;
+}
+
+bool GBDebugger::SeekToCycle(uint64_t cycle) {
+    if (!history_->SeekToCycle(cycle)) {
+        return false;
+    }
+    ShowHistoryState();
+    return true;
+}
+
+void GBDebugger::ShowHistoryState() {
+    const CPUState& cpu = history_->GetCPU();
+    cpu_panel_->Update(cpu);
+    flags_panel_->Update(cpu);
+    
+    UpdateMemory(history_->GetMemory(), StateHistory::MEMORY_SIZE);
+    vram_panel_->UpdateVRAM(history_->GetVRAMBank1(), StateHistory::VRAM_BANK_SIZE, 1);
+    
+    CGBPalette bgPalettes[8];
+    CGBPalette spritePalettes[8];
+    history_->CopyPalettes(bgPalettes, spritePalettes);
+    vram_panel_->UpdatePalettes(bgPalettes, spritePalettes);
+    
+    // History keeps no scanlines; fall back to the registers in memory
+    scanlines_->Clear();
+    showing_history_ = true;
+    MarkStateChanged();
+}
+
 SDL_Window* GBDebugger::GetWindow() const {
     return backend_->GetWindow();
 }
@@ -140,10 +561,12 @@ bool GBDebugger::IsRunning() const {
 
 void GBDebugger::SetRunning(bool running) {
     control_panel_->SetRunning(running);
+    MarkStateChanged();
 }
 
 void GBDebugger::ToggleRunning() {
     control_panel_->ToggleRunning();
+    MarkStateChanged();
 }
 
 bool GBDebugger::IsStepRequested() const {
@@ -152,6 +575,17 @@ bool GBDebugger::IsStepRequested() const {
 
 void GBDebugger::ClearStepRequest() {
     control_panel_->ClearStepRequest();
+    
+    // The step executed the instruction a breakpoint stopped on
+    break_suppressed_.store(false, std::memory_order_relaxed);
+}
+
+bool GBDebugger::ConsumeStepRequest() {
+    if (!control_panel_->ConsumeStepRequest()) {
+        return false;
+    }
+    break_suppressed_.store(false, std::memory_order_relaxed);
+    return true;
 }
 
 bool GBDebugger::IsExitRequested() const {
@@ -164,10 +598,12 @@ float GBDebugger::GetSpeedMultiplier() const {
 
 void GBDebugger::CycleSpeedUp() {
     control_panel_->CycleSpeedUp();
+    MarkStateChanged();
 }
 
 void GBDebugger::CycleSpeedDown() {
     control_panel_->CycleSpeedDown();
+    MarkStateChanged();
 }
 
 } // namespace GBDebug
@@ -0,0 +1,188 @@
+#include "MemoryHeatmap.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GBDEBUG_HEATMAP_SSE2 1
+#endif
+
+namespace GBDebug {
+
+constexpr size_t MemoryHeatmap::MEMORY_SIZE;
+constexpr size_t MemoryHeatmap::PAGE_SIZE;
+constexpr size_t MemoryHeatmap::PAGE_COUNT;
+constexpr uint32_t MemoryHeatmap::NEVER_CHANGED;
+
+namespace {
+
+const uint8_t MIXED_PAGE = 0xFF;
+
+/**
+ * Region index of every page, or MIXED_PAGE where regions split a page
+ */
+struct PageRegionTable {
+    uint8_t region[MemoryHeatmap::PAGE_COUNT];
+    
+    PageRegionTable() {
+        for (size_t page = 0; page < MemoryHeatmap::PAGE_COUNT; page++) {
+            region[page] = MIXED_PAGE;
+            for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+                if (MEMORY_REGIONS[i].start <= page * 256 && MEMORY_REGIONS[i].end >= page * 256 + 255) {
+                    region[page] = static_cast<uint8_t>(i);
+                }
+            }
+        }
+    }
+};
+
+const PageRegionTable PAGE_REGIONS;
+
+size_t FindRegionIndex(uint32_t address) {
+    for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+        if (address >= MEMORY_REGIONS[i].start && address <= MEMORY_REGIONS[i].end) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+bool PagesEqual(const uint8_t* a, const uint8_t* b) {
+#ifdef GBDEBUG_HEATMAP_SSE2
+    __m128i diff = _mm_setzero_si128();
+    for (size_t i = 0; i < MemoryHeatmap::PAGE_SIZE; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        diff = _mm_or_si128(diff, _mm_xor_si128(x, y));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF;
+#else
+    uint64_t diff = 0;
+    for (size_t i = 0; i < MemoryHeatmap::PAGE_SIZE; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        diff |= x ^ y;
+    }
+    return diff == 0;
+#endif
+}
+
+/**
+ * Bit i set = byte i of a 16-byte chunk differs
+ */
+unsigned DiffMask16(const uint8_t* a, const uint8_t* b) {
+#ifdef GBDEBUG_HEATMAP_SSE2
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+    return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFF;
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < 16; i++) {
+        mask |= static_cast<unsigned>(a[i] != b[i]) << i;
+    }
+    return mask;
+#endif
+}
+
+} // namespace
+
+MemoryHeatmap::MemoryHeatmap() {
+    Reset();
+}
+
+void MemoryHeatmap::Reset() {
+    previous_.fill(0);
+    lastChanged_.fill(0);
+    changeCount_.fill(0);
+    pageLastChanged_.fill(0);
+    changedPages_.reset();
+    everChanged_.reset();
+    regionChanges_.fill(0);
+    regionTotals_.fill(0);
+    frame_ = 0;
+    hasBaseline_ = false;
+    pagesScanned_ = 0;
+}
+
+void MemoryHeatmap::Observe(const uint8_t* memory) {
+    if (!hasBaseline_) {
+        std::memcpy(previous_.data(), memory, MEMORY_SIZE);
+        hasBaseline_ = true;
+        return;
+    }
+    
+    frame_++;
+    changedPages_.reset();
+    regionChanges_.fill(0);
+    
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        size_t offset = page * PAGE_SIZE;
+        if (!PagesEqual(previous_.data() + offset, memory + offset)) {
+            ScanPage(page, memory);
+        }
+    }
+    
+    for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+        regionTotals_[i] += regionChanges_[i];
+    }
+}
+
+void MemoryHeatmap::ScanPage(size_t page, const uint8_t* memory) {
+    size_t offset = page * PAGE_SIZE;
+    const uint8_t* before = previous_.data() + offset;
+    const uint8_t* after = memory + offset;
+    uint8_t region = PAGE_REGIONS.region[page];
+    
+    uint32_t changed = 0;
+    for (size_t chunk = 0; chunk < PAGE_SIZE; chunk += 16) {
+        unsigned mask = DiffMask16(before + chunk, after + chunk);
+        for (size_t i = chunk; mask != 0; i++, mask >>= 1) {
+            if ((mask & 1) == 0) {
+                continue;
+            }
+            lastChanged_[offset + i] = frame_;
+            changeCount_[offset + i]++;
+            if (region == MIXED_PAGE) {
+                regionChanges_[FindRegionIndex(static_cast<uint32_t>(offset + i))]++;
+            }
+            changed++;
+        }
+    }
+    if (region != MIXED_PAGE) {
+        regionChanges_[region] += changed;
+    }
+    
+    std::memcpy(previous_.data() + offset, after, PAGE_SIZE);
+    pageLastChanged_[page] = frame_;
+    changedPages_.set(page);
+    everChanged_.set(page);
+    pagesScanned_++;
+}
+
+void MemoryHeatmap::GetHottest(std::vector<uint16_t>& out, size_t count) const {
+    out.clear();
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        if (!everChanged_[page]) {
+            continue;
+        }
+        for (size_t i = page * PAGE_SIZE; i < (page + 1) * PAGE_SIZE; i++) {
+            if (changeCount_[i] > 0) {
+                out.push_back(static_cast<uint16_t>(i));
+            }
+        }
+    }
+    
+    // Most changes first, lower address on ties
+    auto hotter = [this](uint16_t a, uint16_t b) {
+        return changeCount_[a] != changeCount_[b] ? changeCount_[a] > changeCount_[b] : a < b;
+    };
+    if (out.size() > count) {
+        std::partial_sort(out.begin(), out.begin() + count, out.end(), hotter);
+        out.resize(count);
+    } else {
+        std::sort(out.begin(), out.end(), hotter);
+    }
+}
+
+} // namespace GBDebug
@@ -0,0 +1,303 @@
+#include "MemorySearch.h"
+#include <bitset>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GBDEBUG_SEARCH_SSE2 1
+#endif
+
+namespace GBDebug {
+
+constexpr size_t MemorySearch::MEMORY_SIZE;
+constexpr size_t MemorySearch::MAX_PATTERN;
+constexpr size_t MemorySearch::CANDIDATE_WORDS;
+
+namespace {
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Parse a number: decimal, or hex with a $ or 0x prefix
+ */
+bool ParseNumber(const std::string& text, unsigned long maxValue, unsigned long& value) {
+    size_t start = text.find_first_not_of(" \t");
+    size_t end = text.find_last_not_of(" \t");
+    if (start == std::string::npos) {
+        return false;
+    }
+    std::string number = text.substr(start, end - start + 1);
+    
+    int base = 10;
+    if (number[0] == '$') {
+        number = number.substr(1);
+        base = 16;
+    } else if (number.size() > 2 && number[0] == '0' && (number[1] == 'x' || number[1] == 'X')) {
+        number = number.substr(2);
+        base = 16;
+    }
+    if (number.empty()) {
+        return false;
+    }
+    
+    char* parseEnd = nullptr;
+    value = std::strtoul(number.c_str(), &parseEnd, base);
+    return *parseEnd == '\0' && value <= maxValue;
+}
+
+/**
+ * Bit i set = byte i of a 16-byte chunk equals value
+ */
+unsigned EqualMask16(const uint8_t* bytes, uint8_t value) {
+#ifdef GBDEBUG_SEARCH_SSE2
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < 16; i++) {
+        mask |= static_cast<unsigned>(bytes[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Per-byte comparison of a 16-byte chunk of memory with its snapshot
+ */
+unsigned CompareMask16(const uint8_t* now, const uint8_t* before, NarrowMode mode) {
+#ifdef GBDEBUG_SEARCH_SSE2
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(now));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(before));
+    unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    switch (mode) {
+        case NarrowMode::Unchanged:
+            return equal;
+        case NarrowMode::Changed:
+            return ~equal & 0xFFFF;
+        case NarrowMode::Increased:
+            // Unsigned a > b: max(a, b) == a and a != b
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(a, b), a))) & ~equal & 0xFFFF;
+        case NarrowMode::Decreased:
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(a, b), a))) & ~equal & 0xFFFF;
+    }
+    return 0;
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < 16; i++) {
+        bool keep = false;
+        switch (mode) {
+            case NarrowMode::Unchanged: keep = now[i] == before[i]; break;
+            case NarrowMode::Changed:   keep = now[i] != before[i]; break;
+            case NarrowMode::Increased: keep = now[i] > before[i]; break;
+            case NarrowMode::Decreased: keep = now[i] < before[i]; break;
+        }
+        mask |= static_cast<unsigned>(keep) << i;
+    }
+    return mask;
+#endif
+}
+
+size_t PopCount64(uint64_t word) {
+    return std::bitset<64>(word).count();
+}
+
+} // namespace
+
+MemorySearch::MemorySearch()
+    : anchor_(0)
+    , candidateCount_(0)
+    , narrowing_(false) {
+    candidates_.fill(0);
+    snapshot_.fill(0);
+}
+
+bool MemorySearch::SetPattern(SearchMode mode, const std::string& text, std::string& error) {
+    std::vector<uint8_t> pattern;
+    std::vector<uint8_t> wildcard;
+    unsigned long value = 0;
+    
+    switch (mode) {
+        case SearchMode::Bytes:
+            for (size_t i = 0; i < text.size();) {
+                if (text[i] == ' ' || text[i] == '\t' || text[i] == ',') {
+                    i++;
+                    continue;
+                }
+                if (text.compare(i, 2, "??") == 0) {
+                    pattern.push_back(0);
+                    wildcard.push_back(1);
+                    i += 2;
+                    continue;
+                }
+                int hi = HexDigit(text[i]);
+                int lo = i + 1 < text.size() ? HexDigit(text[i + 1]) : -1;
+                if (hi < 0 || lo < 0) {
+                    error = "Expected hex byte or ?? at position " + std::to_string(i + 1);
+                    return false;
+                }
+                pattern.push_back(static_cast<uint8_t>(hi * 16 + lo));
+                wildcard.push_back(0);
+                i += 2;
+            }
+            break;
+        case SearchMode::Value8:
+            if (!ParseNumber(text, 0xFF, value)) {
+                error = "Expected a value from 0 to 255";
+                return false;
+            }
+            pattern.push_back(static_cast<uint8_t>(value));
+            wildcard.push_back(0);
+            break;
+        case SearchMode::Value16:
+            if (!ParseNumber(text, 0xFFFF, value)) {
+                error = "Expected a value from 0 to 65535";
+                return false;
+            }
+            pattern.push_back(static_cast<uint8_t>(value));
+            pattern.push_back(static_cast<uint8_t>(value >> 8));
+            wildcard.assign(2, 0);
+            break;
+        case SearchMode::Text:
+            pattern.assign(text.begin(), text.end());
+            wildcard.assign(text.size(), 0);
+            break;
+    }
+    
+    if (pattern.empty()) {
+        error = "Empty pattern";
+        return false;
+    }
+    if (pattern.size() > MAX_PATTERN) {
+        error = "Pattern longer than 64 bytes";
+        return false;
+    }
+    
+    size_t anchor = 0;
+    while (anchor < wildcard.size() && wildcard[anchor]) {
+        anchor++;
+    }
+    if (anchor == wildcard.size()) {
+        error = "Pattern needs at least one fixed byte";
+        return false;
+    }
+    
+    pattern_.swap(pattern);
+    wildcard_.swap(wildcard);
+    anchor_ = anchor;
+    error.clear();
+    return true;
+}
+
+void MemorySearch::Find(const uint8_t* memory, std::vector<uint16_t>& results) const {
+    results.clear();
+    if (pattern_.empty()) {
+        return;
+    }
+    
+    size_t length = pattern_.size();
+    uint8_t first = pattern_[anchor_];
+    
+    // Candidate anchor positions run from anchor_ to the last start + anchor_
+    size_t lastStart = MEMORY_SIZE - length;
+    size_t scanEnd = lastStart + anchor_ + 1;
+    for (size_t chunk = anchor_ & ~size_t(15); chunk < scanEnd; chunk += 16) {
+        unsigned mask = EqualMask16(memory + chunk, first);
+        for (size_t i = chunk; mask != 0; i++, mask >>= 1) {
+            if ((mask & 1) == 0 || i < anchor_ || i >= scanEnd) {
+                continue;
+            }
+            
+            size_t start = i - anchor_;
+            bool match = true;
+            for (size_t k = 0; k < length && match; k++) {
+                match = wildcard_[k] || memory[start + k] == pattern_[k];
+            }
+            if (match) {
+                results.push_back(static_cast<uint16_t>(start));
+            }
+        }
+    }
+}
+
+void MemorySearch::StartNarrowing(const uint8_t* memory) {
+    candidates_.fill(~uint64_t(0));
+    candidateCount_ = MEMORY_SIZE;
+    std::memcpy(snapshot_.data(), memory, MEMORY_SIZE);
+    narrowing_ = true;
+}
+
+void MemorySearch::ResetNarrowing() {
+    candidates_.fill(0);
+    candidateCount_ = 0;
+    narrowing_ = false;
+}
+
+template <typename KeepFn>
+size_t MemorySearch::Filter(KeepFn keep) {
+    size_t count = 0;
+    for (size_t word = 0; word < CANDIDATE_WORDS; word++) {
+        uint64_t bits = candidates_[word];
+        if (bits == 0) {
+            continue;
+        }
+        
+        size_t base = word * 64;
+        uint64_t kept = 0;
+        for (size_t chunk = 0; chunk < 64; chunk += 16) {
+            // Only compare chunks that still hold candidates
+            if (((bits >> chunk) & 0xFFFF) != 0) {
+                kept |= static_cast<uint64_t>(keep(base + chunk)) << chunk;
+            }
+        }
+        bits &= kept;
+        candidates_[word] = bits;
+        count += PopCount64(bits);
+    }
+    candidateCount_ = count;
+    return count;
+}
+
+size_t MemorySearch::Narrow(const uint8_t* memory, NarrowMode mode) {
+    if (!narrowing_) {
+        return 0;
+    }
+    
+    const uint8_t* before = snapshot_.data();
+    size_t count = Filter([memory, before, mode](size_t offset) {
+        return CompareMask16(memory + offset, before + offset, mode);
+    });
+    std::memcpy(snapshot_.data(), memory, MEMORY_SIZE);
+    return count;
+}
+
+size_t MemorySearch::NarrowToValue(const uint8_t* memory, uint8_t value) {
+    if (!narrowing_) {
+        return 0;
+    }
+    
+    size_t count = Filter([memory, value](size_t offset) {
+        return EqualMask16(memory + offset, value);
+    });
+    std::memcpy(snapshot_.data(), memory, MEMORY_SIZE);
+    return count;
+}
+
+void MemorySearch::GetCandidates(std::vector<uint16_t>& out, size_t limit) const {
+    out.clear();
+    for (size_t word = 0; word < CANDIDATE_WORDS && out.size() < limit; word++) {
+        uint64_t bits = candidates_[word];
+        for (size_t bit = 0; bits != 0 && out.size() < limit; bit++, bits >>= 1) {
+            if (bits & 1) {
+                out.push_back(static_cast<uint16_t>(word * 64 + bit));
+            }
+        }
+    }
+}
+
+} // namespace GBDebug
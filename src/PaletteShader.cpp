@@ -0,0 +1,359 @@
+#include "PaletteShader.h"
+#include "imgui.h"
+#include <SDL.h>
+#include <cstring>
+
+// Silence OpenGL deprecation warnings on macOS
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// OpenGL 2.0 enums (not present in every platform's gl.h)
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0 0x84C0
+#endif
+#ifndef GL_TEXTURE1
+#define GL_TEXTURE1 0x84C1
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_CURRENT_PROGRAM
+#define GL_CURRENT_PROGRAM 0x8B8D
+#endif
+
+namespace GBDebug {
+
+namespace {
+
+// OpenGL 2.0 entry points, resolved at runtime through SDL
+typedef GLuint (APIENTRY* CreateShaderFn)(GLenum type);
+typedef void (APIENTRY* ShaderSourceFn)(GLuint shader, GLsizei count, const char* const* source, const GLint* length);
+typedef void (APIENTRY* CompileShaderFn)(GLuint shader);
+typedef void (APIENTRY* GetShaderivFn)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* DeleteShaderFn)(GLuint shader);
+typedef GLuint (APIENTRY* CreateProgramFn)(void);
+typedef void (APIENTRY* AttachShaderFn)(GLuint program, GLuint shader);
+typedef void (APIENTRY* BindAttribLocationFn)(GLuint program, GLuint index, const char* name);
+typedef void (APIENTRY* LinkProgramFn)(GLuint program);
+typedef void (APIENTRY* GetProgramivFn)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* DeleteProgramFn)(GLuint program);
+typedef void (APIENTRY* UseProgramFn)(GLuint program);
+typedef GLint (APIENTRY* GetUniformLocationFn)(GLuint program, const char* name);
+typedef GLint (APIENTRY* GetAttribLocationFn)(GLuint program, const char* name);
+typedef void (APIENTRY* Uniform1iFn)(GLint location, GLint v0);
+typedef void (APIENTRY* Uniform1fFn)(GLint location, GLfloat v0);
+typedef void (APIENTRY* UniformMatrix4fvFn)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+typedef void (APIENTRY* GetUniformfvFn)(GLuint program, GLint location, GLfloat* params);
+typedef void (APIENTRY* ActiveTextureFn)(GLenum texture);
+
+struct GLFunctions {
+    CreateShaderFn CreateShader;
+    ShaderSourceFn ShaderSource;
+    CompileShaderFn CompileShader;
+    GetShaderivFn GetShaderiv;
+    DeleteShaderFn DeleteShader;
+    CreateProgramFn CreateProgram;
+    AttachShaderFn AttachShader;
+    BindAttribLocationFn BindAttribLocation;
+    LinkProgramFn LinkProgram;
+    GetProgramivFn GetProgramiv;
+    DeleteProgramFn DeleteProgram;
+    UseProgramFn UseProgram;
+    GetUniformLocationFn GetUniformLocation;
+    GetAttribLocationFn GetAttribLocation;
+    Uniform1iFn Uniform1i;
+    Uniform1fFn Uniform1f;
+    UniformMatrix4fvFn UniformMatrix4fv;
+    GetUniformfvFn GetUniformfv;
+    ActiveTextureFn ActiveTexture;
+};
+
+GLFunctions gl;
+
+template <typename T>
+bool LoadFunction(T& fn, const char* name) {
+    fn = reinterpret_cast<T>(SDL_GL_GetProcAddress(name));
+    return fn != nullptr;
+}
+
+bool LoadGLFunctions() {
+    bool ok = true;
+    ok &= LoadFunction(gl.CreateShader, "glCreateShader");
+    ok &= LoadFunction(gl.ShaderSource, "glShaderSource");
+    ok &= LoadFunction(gl.CompileShader, "glCompileShader");
+    ok &= LoadFunction(gl.GetShaderiv, "glGetShaderiv");
+    ok &= LoadFunction(gl.DeleteShader, "glDeleteShader");
+    ok &= LoadFunction(gl.CreateProgram, "glCreateProgram");
+    ok &= LoadFunction(gl.AttachShader, "glAttachShader");
+    ok &= LoadFunction(gl.BindAttribLocation, "glBindAttribLocation");
+    ok &= LoadFunction(gl.LinkProgram, "glLinkProgram");
+    ok &= LoadFunction(gl.GetProgramiv, "glGetProgramiv");
+    ok &= LoadFunction(gl.DeleteProgram, "glDeleteProgram");
+    ok &= LoadFunction(gl.UseProgram, "glUseProgram");
+    ok &= LoadFunction(gl.GetUniformLocation, "glGetUniformLocation");
+    ok &= LoadFunction(gl.GetAttribLocation, "glGetAttribLocation");
+    ok &= LoadFunction(gl.Uniform1i, "glUniform1i");
+    ok &= LoadFunction(gl.Uniform1f, "glUniform1f");
+    ok &= LoadFunction(gl.UniformMatrix4fv, "glUniformMatrix4fv");
+    ok &= LoadFunction(gl.GetUniformfv, "glGetUniformfv");
+    ok &= LoadFunction(gl.ActiveTexture, "glActiveTexture");
+    return ok;
+}
+
+// GLSL 120 to match the OpenGL 2.1 context created by DebuggerBackend.
+// Attribute and uniform names match the ImGui OpenGL3 backend's shader.
+const char* VERTEX_SHADER_SOURCE =
+    "#version 120\n"
+    "uniform mat4 ProjMtx;\n"
+    "attribute vec2 Position;\n"
+    "attribute vec2 UV;\n"
+    "attribute vec4 Color;\n"
+    "varying vec2 Frag_UV;\n"
+    "varying vec4 Frag_Color;\n"
+    "void main() {\n"
+    "    Frag_UV = UV;\n"
+    "    Frag_Color = Color;\n"
+    "    gl_Position = ProjMtx * vec4(Position.xy, 0.0, 1.0);\n"
+    "}\n";
+
+// Index texels hold 0-3 as raw bytes; the palette texture is 4 texels wide
+const char* FRAGMENT_SHADER_SOURCE =
+    "#version 120\n"
+    "uniform sampler2D IndexTexture;\n"
+    "uniform sampler2D PaletteTexture;\n"
+    "uniform float PaletteV;\n"
+    "varying vec2 Frag_UV;\n"
+    "varying vec4 Frag_Color;\n"
+    "void main() {\n"
+    "    float index = floor(texture2D(IndexTexture, Frag_UV).r * 255.0 + 0.5);\n"
+    "    vec4 color = texture2D(PaletteTexture, vec2((index + 0.5) / 4.0, PaletteV));\n"
+    "    gl_FragColor = Frag_Color * color;\n"
+    "}\n";
+
+GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = gl.CreateShader(type);
+    if (shader == 0) {
+        return 0;
+    }
+    gl.ShaderSource(shader, 1, &source, nullptr);
+    gl.CompileShader(shader);
+
+    GLint status = 0;
+    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        gl.DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+} // namespace
+
+PaletteShader::PaletteShader()
+    : vertexShader_(0), fragmentShader_(0), program_(0), linkedFor_(0),
+      paletteTexture_(0),
+      projLocation_(-1), indexLocation_(-1), paletteLocation_(-1),
+      paletteVLocation_(-1), imguiProjLocation_(-1),
+      initialized_(false), available_(false), palettesValid_(false)
+{
+    std::memset(projMatrix_, 0, sizeof(projMatrix_));
+    for (int i = 0; i < PALETTE_ROWS; i++) {
+        drawStates_[i].shader = this;
+        drawStates_[i].paletteV = (i + 0.5f) / PALETTE_ROWS;
+    }
+}
+
+PaletteShader::~PaletteShader() {
+    Shutdown();
+}
+
+bool PaletteShader::Initialize() {
+    if (initialized_) {
+        return available_;
+    }
+    initialized_ = true;
+
+    if (!LoadGLFunctions()) {
+        return false;
+    }
+
+    vertexShader_ = CompileShader(GL_VERTEX_SHADER, VERTEX_SHADER_SOURCE);
+    fragmentShader_ = CompileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER_SOURCE);
+    if (vertexShader_ == 0 || fragmentShader_ == 0) {
+        Shutdown();
+        initialized_ = true;  // Don't retry every frame
+        return false;
+    }
+
+    program_ = gl.CreateProgram();
+    gl.AttachShader(program_, vertexShader_);
+    gl.AttachShader(program_, fragmentShader_);
+
+    // Palette texture: 4 colors wide, one row per palette
+    GLuint textureId = 0;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 4, PALETTE_ROWS, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    paletteTexture_ = static_cast<unsigned int>(textureId);
+
+    available_ = true;
+    return true;
+}
+
+bool PaletteShader::UpdatePalettes(const Palette* bgPalettes, const Palette* spritePalettes) {
+    if (!available_ || bgPalettes == nullptr || spritePalettes == nullptr) {
+        return false;
+    }
+
+    TileColor colors[PALETTE_ROWS * 4];
+    for (int i = 0; i < 8; i++) {
+        for (int c = 0; c < 4; c++) {
+            colors[i * 4 + c] = bgPalettes[i].colors[c];
+            colors[(8 + i) * 4 + c] = spritePalettes[i].colors[c];
+        }
+    }
+
+    if (palettesValid_ && std::memcmp(colors, uploaded_, sizeof(colors)) == 0) {
+        return false;
+    }
+
+    std::memcpy(uploaded_, colors, sizeof(colors));
+    palettesValid_ = true;
+
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(paletteTexture_));
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 4, PALETTE_ROWS,
+                    GL_RGBA, GL_UNSIGNED_BYTE, colors);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+void PaletteShader::Begin(int paletteRow) {
+    if (!available_) {
+        return;
+    }
+    if (paletteRow < 0) paletteRow = 0;
+    if (paletteRow >= PALETTE_ROWS) paletteRow = PALETTE_ROWS - 1;
+
+    ImGui::GetWindowDrawList()->AddCallback(&PaletteShader::DrawCallback, &drawStates_[paletteRow]);
+}
+
+void PaletteShader::End() {
+    if (!available_) {
+        return;
+    }
+    ImGui::GetWindowDrawList()->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void PaletteShader::DrawCallback(const ImDrawList* parentList, const ImDrawCmd* cmd) {
+    (void)parentList;
+    const DrawState* state = static_cast<const DrawState*>(cmd->UserCallbackData);
+    state->shader->Apply(state->paletteV);
+}
+
+void PaletteShader::Apply(float paletteV) {
+    GLint current = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+    GLuint currentProgram = static_cast<GLuint>(current);
+
+    // Normally ImGui's program is bound here; pick up its projection matrix
+    if (currentProgram != program_) {
+        if (currentProgram == 0 || !LinkAgainst(currentProgram)) {
+            return;  // Leave ImGui's program bound
+        }
+        gl.GetUniformfv(currentProgram, imguiProjLocation_, projMatrix_);
+    }
+
+    gl.UseProgram(program_);
+    gl.UniformMatrix4fv(projLocation_, 1, GL_FALSE, projMatrix_);
+    gl.Uniform1i(indexLocation_, 0);
+    gl.Uniform1i(paletteLocation_, 1);
+    gl.Uniform1f(paletteVLocation_, paletteV);
+
+    // Index texture is bound by ImGui on unit 0; palette goes on unit 1
+    gl.ActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(paletteTexture_));
+    gl.ActiveTexture(GL_TEXTURE0);
+}
+
+bool PaletteShader::LinkAgainst(unsigned int imguiProgram) {
+    if (linkedFor_ == imguiProgram) {
+        return true;
+    }
+
+    // Bind our attributes to the locations ImGui's vertex setup uses
+    GLint posLocation = gl.GetAttribLocation(imguiProgram, "Position");
+    GLint uvLocation = gl.GetAttribLocation(imguiProgram, "UV");
+    GLint colorLocation = gl.GetAttribLocation(imguiProgram, "Color");
+    imguiProjLocation_ = gl.GetUniformLocation(imguiProgram, "ProjMtx");
+    if (posLocation < 0 || uvLocation < 0 || colorLocation < 0 || imguiProjLocation_ < 0) {
+        return false;
+    }
+
+    gl.BindAttribLocation(program_, static_cast<GLuint>(posLocation), "Position");
+    gl.BindAttribLocation(program_, static_cast<GLuint>(uvLocation), "UV");
+    gl.BindAttribLocation(program_, static_cast<GLuint>(colorLocation), "Color");
+    gl.LinkProgram(program_);
+
+    GLint status = 0;
+    gl.GetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        available_ = false;
+        return false;
+    }
+
+    projLocation_ = gl.GetUniformLocation(program_, "ProjMtx");
+    indexLocation_ = gl.GetUniformLocation(program_, "IndexTexture");
+    paletteLocation_ = gl.GetUniformLocation(program_, "PaletteTexture");
+    paletteVLocation_ = gl.GetUniformLocation(program_, "PaletteV");
+    linkedFor_ = imguiProgram;
+    return true;
+}
+
+void PaletteShader::Shutdown() {
+    if (program_ != 0) {
+        gl.DeleteProgram(program_);
+        program_ = 0;
+    }
+    if (vertexShader_ != 0) {
+        gl.DeleteShader(vertexShader_);
+        vertexShader_ = 0;
+    }
+    if (fragmentShader_ != 0) {
+        gl.DeleteShader(fragmentShader_);
+        fragmentShader_ = 0;
+    }
+    if (paletteTexture_ != 0) {
+        GLuint glId = static_cast<GLuint>(paletteTexture_);
+        glDeleteTextures(1, &glId);
+        paletteTexture_ = 0;
+    }
+    linkedFor_ = 0;
+    initialized_ = false;
+    available_ = false;
+    palettesValid_ = false;
+}
+
+} // namespace GBDebug
@@ -0,0 +1,101 @@
+#include "ScanlineTimeline.h"
+
+namespace GBDebug {
+
+constexpr size_t ScanlineTimeline::LINE_COUNT;
+constexpr size_t ScanlineTimeline::VISIBLE_LINES;
+constexpr size_t ScanlineTimeline::REGISTER_COUNT;
+
+namespace {
+
+const char* const REGISTER_NAMES[ScanlineTimeline::REGISTER_COUNT] = {
+    "LCDC", "STAT", "SCY", "SCX", "BGP", "OBP0", "OBP1", "WY", "WX"
+};
+
+const uint16_t REGISTER_ADDRESSES[ScanlineTimeline::REGISTER_COUNT] = {
+    0xFF40, 0xFF41, 0xFF42, 0xFF43, 0xFF47, 0xFF48, 0xFF49, 0xFF4A, 0xFF4B
+};
+
+// Every register except STAT
+bool SameRegisters(const ScanlineRegisters& a, const ScanlineRegisters& b) {
+    return a.lcdc == b.lcdc && a.scy == b.scy && a.scx == b.scx && a.bgp == b.bgp &&
+           a.obp0 == b.obp0 && a.obp1 == b.obp1 && a.wy == b.wy && a.wx == b.wx;
+}
+
+} // namespace
+
+ScanlineTimeline::ScanlineTimeline()
+    : pending_(false)
+    , hasFrame_(false)
+    , uniform_(true)
+    , generation_(0) {
+}
+
+bool ScanlineTimeline::Latch() {
+    if (!pending_) {
+        return false;
+    }
+    pending_ = false;
+    frame_ = recording_;
+    FrameChanged();
+    return true;
+}
+
+void ScanlineTimeline::SetFrame(const Frame& frame) {
+    frame_ = frame;
+    FrameChanged();
+}
+
+void ScanlineTimeline::Clear() {
+    if (hasFrame_) {
+        hasFrame_ = false;
+        uniform_ = true;
+        generation_++;
+    }
+}
+
+void ScanlineTimeline::FrameChanged() {
+    hasFrame_ = true;
+    uniform_ = true;
+    for (size_t ly = 1; ly < VISIBLE_LINES; ly++) {
+        if (!SameRegisters(frame_[ly], frame_[0])) {
+            uniform_ = false;
+            break;
+        }
+    }
+    generation_++;
+}
+
+uint8_t ScanlineTimeline::GetRegister(const ScanlineRegisters& registers, size_t index) {
+    switch (index) {
+        case 0:  return registers.lcdc;
+        case 1:  return registers.stat;
+        case 2:  return registers.scy;
+        case 3:  return registers.scx;
+        case 4:  return registers.bgp;
+        case 5:  return registers.obp0;
+        case 6:  return registers.obp1;
+        case 7:  return registers.wy;
+        default: return registers.wx;
+    }
+}
+
+const char* ScanlineTimeline::GetRegisterName(size_t index) {
+    return index < REGISTER_COUNT ? REGISTER_NAMES[index] : "";
+}
+
+ScanlineRegisters ScanlineTimeline::ReadRegisters(const uint8_t* memory) {
+    ScanlineRegisters registers;
+    registers.lcdc = memory[REGISTER_ADDRESSES[0]];
+    registers.stat = memory[REGISTER_ADDRESSES[1]];
+    registers.scy = memory[REGISTER_ADDRESSES[2]];
+    registers.scx = memory[REGISTER_ADDRESSES[3]];
+    registers.bgp = memory[REGISTER_ADDRESSES[4]];
+    registers.obp0 = memory[REGISTER_ADDRESSES[5]];
+    registers.obp1 = memory[REGISTER_ADDRESSES[6]];
+    registers.wy = memory[REGISTER_ADDRESSES[7]];
+    registers.wx = memory[REGISTER_ADDRESSES[8]];
+    return registers;
+}
+
+} // namespace GBDebug
@@ -0,0 +1,86 @@
+#include "SpriteOccupancy.h"
+#include <cstring>
+
+namespace GBDebug {
+
+constexpr int SpriteLine::MAX_DRAWN;
+constexpr int SpriteOccupancy::LINE_COUNT;
+constexpr int SpriteOccupancy::OAM_ENTRIES;
+constexpr size_t SpriteOccupancy::OAM_SIZE;
+
+SpriteOccupancy::SpriteOccupancy()
+    : droppedSprites_(0)
+    , overflowLines_(0)
+    , peakCount_(0)
+    , height_(8)
+    , cgb_(false)
+    , valid_(false) {
+    oam_.fill(0);
+}
+
+bool SpriteOccupancy::Analyze(const uint8_t* oam, uint8_t lcdc, bool cgb) {
+    const int height = (lcdc & 0x04) ? 16 : 8;
+    if (valid_ && height == height_ && cgb == cgb_ && std::memcmp(oam_.data(), oam, OAM_SIZE) == 0) {
+        return false;
+    }
+    std::memcpy(oam_.data(), oam, OAM_SIZE);
+    height_ = height;
+    cgb_ = cgb;
+    valid_ = true;
+
+    droppedSprites_ = 0;
+    overflowLines_ = 0;
+    peakCount_ = 0;
+    for (int ly = 0; ly < LINE_COUNT; ly++) {
+        SpriteLine& line = lines_[ly];
+        SelectLine(oam_.data(), ly, height, cgb, line);
+
+        if (line.dropped != 0) {
+            droppedSprites_ |= line.dropped;
+            overflowLines_++;
+        }
+        if (line.coveringCount > peakCount_) {
+            peakCount_ = line.coveringCount;
+        }
+    }
+    return true;
+}
+
+void SpriteOccupancy::SelectLine(const uint8_t* oam, int ly, int height, bool cgb, SpriteLine& line) {
+    line.covering = 0;
+    line.dropped = 0;
+    line.coveringCount = 0;
+    line.drawnCount = 0;
+
+    // OAM scan: the first 10 covering entries in index order are selected,
+    // whatever their X
+    for (int entry = 0; entry < OAM_ENTRIES; entry++) {
+        int top = oam[entry * 4] - 16;
+        if (ly < top || ly >= top + height) {
+            continue;
+        }
+        uint64_t bit = uint64_t(1) << entry;
+        line.covering |= bit;
+        if (line.drawnCount < SpriteLine::MAX_DRAWN) {
+            line.order[line.drawnCount++] = static_cast<uint8_t>(entry);
+        } else {
+            line.dropped |= bit;
+        }
+        line.coveringCount++;
+    }
+
+    // DMG priority: lower X first, stable so ties keep OAM order
+    if (!cgb) {
+        for (int i = 1; i < line.drawnCount; i++) {
+            uint8_t entry = line.order[i];
+            int j = i;
+            while (j > 0 && oam[line.order[j - 1] * 4 + 1] > oam[entry * 4 + 1]) {
+                line.order[j] = line.order[j - 1];
+                j--;
+            }
+            line.order[j] = entry;
+        }
+    }
+}
+
+} // namespace GBDebug
@@ -2,24 +2,30 @@
 
 namespace GBDebug {
 
-std::vector<SpriteAttributes> SpriteParser::ParseOAM(const uint8_t* oam, size_t size) {
-    std::vector<SpriteAttributes> sprites;
-    
+constexpr size_t SpriteParser::MAX_SPRITES;
+constexpr size_t SpriteParser::SPRITE_ENTRY_SIZE;
+constexpr size_t SpriteParser::OAM_SIZE;
+
+size_t SpriteParser::ParseOAM(const uint8_t* oam, size_t size, SpriteTable& sprites) {
     // Validate input
     if (oam == nullptr || size < OAM_SIZE) {
-        return sprites;  // Return empty vector on error
+        return 0;
     }
     
-    // Reserve space for all 40 sprites
-    sprites.reserve(MAX_SPRITES);
-    
     // Parse each sprite entry (4 bytes each)
     for (size_t i = 0; i < MAX_SPRITES; i++) {
-        const uint8_t* entry = oam + (i * SPRITE_ENTRY_SIZE);
-        sprites.push_back(ParseSprite(entry));
+        sprites[i] = ParseSprite(oam + (i * SPRITE_ENTRY_SIZE));
     }
     
-    return sprites;
+    return MAX_SPRITES;
+}
+
+std::vector<SpriteAttributes> SpriteParser::ParseOAM(const uint8_t* oam, size_t size) {
+    SpriteTable table;
+    size_t count = ParseOAM(oam, size, table);
+    
+    // Empty vector on error
+    return std::vector<SpriteAttributes>(table.begin(), table.begin() + count);
 }
 
 SpriteAttributes SpriteParser::ParseSprite(const uint8_t* entry) {
@@ -0,0 +1,337 @@
+#include "StateHistory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace GBDebug {
+
+constexpr size_t StateHistory::PAGE_SIZE;
+constexpr size_t StateHistory::MEMORY_SIZE;
+constexpr size_t StateHistory::VRAM_BANK_SIZE;
+constexpr size_t StateHistory::PALETTE_BYTES;
+constexpr size_t StateHistory::IMAGE_SIZE;
+constexpr size_t StateHistory::PAGE_COUNT;
+constexpr size_t StateHistory::DEFAULT_KEYFRAME_INTERVAL;
+
+namespace {
+
+const uint16_t END_OF_STEP = 0xFFFF;
+const size_t PALETTE_OFFSET = StateHistory::MEMORY_SIZE + StateHistory::VRAM_BANK_SIZE;
+
+// A page stored as plain literals: a control byte per 128 XOR bytes
+const size_t RAW_PAGE_BYTES = StateHistory::PAGE_SIZE + StateHistory::PAGE_SIZE / 128;
+
+// Worst case per page: index, length and a raw page
+const size_t MAX_PAGE_BYTES = 4 + RAW_PAGE_BYTES;
+
+const uint8_t ZERO_PAGE[StateHistory::PAGE_SIZE] = {};
+
+/**
+ * Store a XOR b as 128-byte literals
+ * @return Bytes written (RAW_PAGE_BYTES)
+ */
+size_t EncodeRawXorPage(const uint8_t* a, const uint8_t* b, uint8_t* out) {
+    uint8_t* start = out;
+    for (size_t i = 0; i < StateHistory::PAGE_SIZE; i++) {
+        if (i % 128 == 0) {
+            *out++ = 127;
+        }
+        *out++ = a[i] ^ b[i];
+    }
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * Run-length encode a XOR b, falling back to a raw page when runs and
+ * literals alternate so often that the encoding would be larger
+ * @return Bytes written, at most RAW_PAGE_BYTES
+ */
+size_t EncodeXorPage(const uint8_t* a, const uint8_t* b, uint8_t* out) {
+    uint8_t* start = out;
+    uint8_t* limit = out + RAW_PAGE_BYTES;
+    size_t i = 0;
+    while (i < StateHistory::PAGE_SIZE) {
+        size_t run = 0;
+        while (i + run < StateHistory::PAGE_SIZE && run < 128 && a[i + run] == b[i + run]) {
+            run++;
+        }
+        if (run > 0) {
+            if (out == limit) {
+                return EncodeRawXorPage(a, b, start);
+            }
+            *out++ = static_cast<uint8_t>(0x7F + run);
+            i += run;
+            continue;
+        }
+        
+        if (out == limit) {
+            return EncodeRawXorPage(a, b, start);
+        }
+        uint8_t* control = out++;
+        size_t literal = 0;
+        while (i < StateHistory::PAGE_SIZE && literal < 128 && a[i] != b[i]) {
+            if (out == limit) {
+                return EncodeRawXorPage(a, b, start);
+            }
+            *out++ = a[i] ^ b[i];
+            i++;
+            literal++;
+        }
+        *control = static_cast<uint8_t>(literal - 1);
+    }
+    return static_cast<size_t>(out - start);
+}
+
+} // namespace
+
+StateHistory::StateHistory()
+    : head_(0)
+    , bytesUsed_(0)
+    , firstSeq_(0)
+    , keyframeCount_(0)
+    , keyframeInterval_(DEFAULT_KEYFRAME_INTERVAL)
+    , sinceKeyframe_(0)
+    , scratch_(PAGE_COUNT * MAX_PAGE_BYTES + 2)
+    , scratchSize_(0)
+    , cursorSeq_(0)
+    , cursorValid_(false) {
+    last_.fill(0);
+    next_.fill(0);
+    cursor_.fill(0);
+}
+
+void StateHistory::SetBudget(size_t bytes) {
+    std::vector<uint8_t> arena(bytes);
+    arena_.swap(arena);
+    Clear();
+}
+
+void StateHistory::Clear() {
+    steps_.clear();
+    head_ = 0;
+    bytesUsed_ = 0;
+    keyframeCount_ = 0;
+    sinceKeyframe_ = 0;
+    last_.fill(0);
+    cursorValid_ = false;
+}
+
+bool StateHistory::Capture(const CPUState& cpu, const uint8_t* memory, const uint8_t* vramBank1,
+                           const CGBPalette* bgPalettes, const CGBPalette* spritePalettes) {
+    if (arena_.empty() || memory == nullptr) {
+        return false;
+    }
+    
+    // Steps stay in cycle order so SeekToCycle() can binary search them
+    if (!steps_.empty() && cpu.cycle < steps_.back().cpu.cycle) {
+        return false;
+    }
+    
+    std::memcpy(next_.data(), memory, MEMORY_SIZE);
+    if (vramBank1 != nullptr) {
+        std::memcpy(next_.data() + MEMORY_SIZE, vramBank1, VRAM_BANK_SIZE);
+    } else {
+        std::memset(next_.data() + MEMORY_SIZE, 0, VRAM_BANK_SIZE);
+    }
+    std::memset(next_.data() + PALETTE_OFFSET, 0, PAGE_SIZE);
+    if (bgPalettes != nullptr) {
+        std::memcpy(next_.data() + PALETTE_OFFSET, bgPalettes, PALETTE_BYTES);
+    }
+    if (spritePalettes != nullptr) {
+        std::memcpy(next_.data() + PALETTE_OFFSET + PALETTE_BYTES, spritePalettes, PALETTE_BYTES);
+    }
+    
+    bool keyframe = steps_.empty() || sinceKeyframe_ + 1 >= keyframeInterval_;
+    EncodeStep(last_, next_, keyframe);
+    size_t offset = Allocate(scratchSize_);
+    
+    // Making room evicted every step, so this one has no base any more
+    if (offset != SIZE_MAX && steps_.empty() && !keyframe) {
+        keyframe = true;
+        EncodeStep(last_, next_, true);
+        offset = Allocate(scratchSize_);
+    }
+    if (offset == SIZE_MAX) {
+        return false;
+    }
+    
+    std::memcpy(&arena_[offset], scratch_.data(), scratchSize_);
+    head_ = offset + scratchSize_;
+    bytesUsed_ += scratchSize_;
+    
+    Step step;
+    step.cpu = cpu;
+    step.offset = offset;
+    step.size = scratchSize_;
+    step.keyframe = keyframe;
+    steps_.push_back(step);
+    
+    if (keyframe) {
+        keyframeCount_++;
+        sinceKeyframe_ = 0;
+    } else {
+        sinceKeyframe_++;
+    }
+    last_.swap(next_);
+    return true;
+}
+
+void StateHistory::EncodeStep(const Image& previous, const Image& next, bool keyframe) {
+    uint8_t* out = scratch_.data();
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        const uint8_t* before = keyframe ? ZERO_PAGE : previous.data() + page * PAGE_SIZE;
+        const uint8_t* after = next.data() + page * PAGE_SIZE;
+        if (std::memcmp(before, after, PAGE_SIZE) == 0) {
+            continue;
+        }
+        
+        size_t length = EncodeXorPage(before, after, out + 4);
+        out[0] = static_cast<uint8_t>(page);
+        out[1] = static_cast<uint8_t>(page >> 8);
+        out[2] = static_cast<uint8_t>(length);
+        out[3] = static_cast<uint8_t>(length >> 8);
+        out += 4 + length;
+    }
+    out[0] = static_cast<uint8_t>(END_OF_STEP);
+    out[1] = static_cast<uint8_t>(END_OF_STEP >> 8);
+    scratchSize_ = static_cast<size_t>(out + 2 - scratch_.data());
+}
+
+void StateHistory::ApplyStep(const uint8_t* data, Image& image) {
+    for (;;) {
+        uint16_t page = static_cast<uint16_t>(data[0] | (data[1] << 8));
+        if (page == END_OF_STEP) {
+            return;
+        }
+        size_t length = static_cast<size_t>(data[2] | (data[3] << 8));
+        const uint8_t* in = data + 4;
+        const uint8_t* end = in + length;
+        uint8_t* out = image.data() + page * PAGE_SIZE;
+        
+        while (in < end) {
+            uint8_t control = *in++;
+            if (control >= 0x80) {
+                out += control - 0x7F;
+            } else {
+                for (int i = 0; i <= control; i++) {
+                    *out++ ^= *in++;
+                }
+            }
+        }
+        data = end;
+    }
+}
+
+size_t StateHistory::Allocate(size_t size) {
+    size_t capacity = arena_.size();
+    if (size > capacity) {
+        return SIZE_MAX;
+    }
+    
+    for (;;) {
+        if (steps_.empty()) {
+            head_ = 0;
+            return 0;
+        }
+        
+        size_t tail = steps_.front().offset;
+        if (head_ > tail) {
+            // Live data in [tail, head_): use the end, else wrap to the start
+            if (capacity - head_ >= size) {
+                return head_;
+            }
+            if (tail >= size) {
+                return 0;
+            }
+        } else if (tail - head_ >= size) {
+            // Wrapped: live data in [tail, end) and [0, head_)
+            return head_;
+        }
+        EvictFront();
+    }
+}
+
+void StateHistory::EvictFront() {
+    // A keyframe's deltas are useless without it, so they go together
+    do {
+        bytesUsed_ -= steps_.front().size;
+        if (steps_.front().keyframe) {
+            keyframeCount_--;
+        }
+        steps_.pop_front();
+        firstSeq_++;
+    } while (!steps_.empty() && !steps_.front().keyframe);
+    
+    if (cursorSeq_ < firstSeq_) {
+        cursorValid_ = false;
+    }
+}
+
+bool StateHistory::SeekToCycle(uint64_t cycle) {
+    std::deque<Step>::const_iterator step = std::upper_bound(
+        steps_.begin(), steps_.end(), cycle,
+        [](uint64_t value, const Step& s) { return value < s.cpu.cycle; });
+    if (step == steps_.begin()) {
+        return false;
+    }
+    return SeekToStep(static_cast<size_t>(step - steps_.begin()) - 1);
+}
+
+bool StateHistory::SeekToStep(size_t step) {
+    if (step >= steps_.size()) {
+        return false;
+    }
+    MoveCursor(firstSeq_ + step);
+    return true;
+}
+
+void StateHistory::MoveCursor(uint64_t seq) {
+    size_t target = static_cast<size_t>(seq - firstSeq_);
+    size_t keyframe = target;
+    while (!steps_[keyframe].keyframe) {
+        keyframe--;
+    }
+    
+    // Candidates: replay from the keyframe, or walk from the cursor when it
+    // is in the same keyframe group (XOR deltas undo themselves)
+    size_t replayCost = target - keyframe + 1;
+    if (cursorValid_) {
+        size_t cursor = static_cast<size_t>(cursorSeq_ - firstSeq_);
+        if (cursor >= keyframe && cursor <= target && target - cursor < replayCost) {
+            for (size_t i = cursor + 1; i <= target; i++) {
+                ApplyStep(&arena_[steps_[i].offset], cursor_);
+            }
+            cursorSeq_ = seq;
+            cursorCPU_ = steps_[target].cpu;
+            return;
+        }
+        if (cursor > target && cursor - target < replayCost) {
+            bool sameGroup = true;
+            for (size_t i = target + 1; i <= cursor && sameGroup; i++) {
+                sameGroup = !steps_[i].keyframe;
+            }
+            if (sameGroup) {
+                for (size_t i = cursor; i > target; i--) {
+                    ApplyStep(&arena_[steps_[i].offset], cursor_);
+                }
+                cursorSeq_ = seq;
+                cursorCPU_ = steps_[target].cpu;
+                return;
+            }
+        }
+    }
+    
+    cursor_.fill(0);
+    for (size_t i = keyframe; i <= target; i++) {
+        ApplyStep(&arena_[steps_[i].offset], cursor_);
+    }
+    cursorSeq_ = seq;
+    cursorCPU_ = steps_[target].cpu;
+    cursorValid_ = true;
+}
+
+void StateHistory::CopyPalettes(CGBPalette* bgPalettes, CGBPalette* spritePalettes) const {
+    std::memcpy(bgPalettes, cursor_.data() + PALETTE_OFFSET, PALETTE_BYTES);
+    std::memcpy(spritePalettes, cursor_.data() + PALETTE_OFFSET + PALETTE_BYTES, PALETTE_BYTES);
+}
+
+} // namespace GBDebug
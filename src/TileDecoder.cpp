@@ -1,7 +1,59 @@
 #include "TileDecoder.h"
+#include <cstring>
 
 namespace GBDebug {
 
+namespace {
+
+/**
+ * Bit-spread table: entry b holds 8 bytes, byte i = bit (7 - i) of b.
+ * 
+ * Stored as uint64_t in host byte order so that writing an entry to memory
+ * yields the leftmost pixel first on any endianness.
+ */
+struct BitSpreadTable {
+    uint64_t entries[256];
+    
+    BitSpreadTable() {
+        for (int b = 0; b < 256; b++) {
+            uint8_t bytes[8];
+            for (int i = 0; i < 8; i++) {
+                bytes[i] = static_cast<uint8_t>((b >> (7 - i)) & 0x01);
+            }
+            std::memcpy(&entries[b], bytes, sizeof(bytes));
+        }
+    }
+};
+
+const BitSpreadTable& GetBitSpreadTable() {
+    static const BitSpreadTable table;
+    return table;
+}
+
+/**
+ * Bit-reverse table: entry b holds b with bit i moved to bit (7 - i).
+ */
+struct BitReverseTable {
+    uint8_t entries[256];
+    
+    BitReverseTable() {
+        for (int b = 0; b < 256; b++) {
+            uint8_t reversed = 0;
+            for (int i = 0; i < 8; i++) {
+                reversed |= static_cast<uint8_t>(((b >> i) & 0x01) << (7 - i));
+            }
+            entries[b] = reversed;
+        }
+    }
+};
+
+const BitReverseTable& GetBitReverseTable() {
+    static const BitReverseTable table;
+    return table;
+}
+
+} // namespace
+
 uint16_t TileDecoder::GetTileAddress(uint16_t tileIndex) {
     // Each tile is 16 bytes, VRAM starts at 0x8000
     // Address = 0x8000 + (tileIndex * 16)
@@ -39,19 +91,92 @@ uint8_t TileDecoder::DecodePixel(
     return (msb << 1) | lsb;
 }
 
+void TileDecoder::DecodeTileRow(uint8_t lsb, uint8_t msb, uint8_t* out) {
+    const BitSpreadTable& table = GetBitSpreadTable();
+    
+    // Each spread byte is 0 or 1, so shifting the MSB plane left by one
+    // moves it into bit 1 of every pixel without carrying between bytes
+    uint64_t row = table.entries[lsb] | (table.entries[msb] << 1);
+    std::memcpy(out, &row, sizeof(row));
+}
+
+uint8_t TileDecoder::ReverseBits(uint8_t value) {
+    return GetBitReverseTable().entries[value];
+}
+
+std::array<std::array<uint8_t, 8>, 8> TileDecoder::DecodeTileFlipped(
+    const uint8_t* vram,
+    uint16_t tileIndex,
+    bool hFlip,
+    bool vFlip
+) {
+    std::array<std::array<uint8_t, 8>, 8> pixelData;
+    
+    const uint8_t* tileData = vram + tileIndex * 16;
+    const BitReverseTable& reverse = GetBitReverseTable();
+    
+    for (int y = 0; y < 8; y++) {
+        const uint8_t* row = tileData + (vFlip ? 7 - y : y) * 2;
+        uint8_t lsb = row[0];
+        uint8_t msb = row[1];
+        if (hFlip) {
+            lsb = reverse.entries[lsb];
+            msb = reverse.entries[msb];
+        }
+        DecodeTileRow(lsb, msb, pixelData[y].data());
+    }
+    
+    return pixelData;
+}
+
 std::array<std::array<uint8_t, 8>, 8> TileDecoder::DecodeTile(
     const uint8_t* vram,
     uint16_t tileIndex,
     uint8_t bank
 ) {
+    (void)bank;  // Caller selects the bank by passing the matching buffer
+    
     std::array<std::array<uint8_t, 8>, 8> pixelData;
     
     // Calculate offset within VRAM buffer (not absolute address)
     // Each tile is 16 bytes
-    uint16_t offset = tileIndex * 16;
+    const uint8_t* tileData = vram + tileIndex * 16;
+    
+    // Decode one row (2 bytes) at a time
+    for (int y = 0; y < 8; y++) {
+        DecodeTileRow(tileData[y * 2], tileData[y * 2 + 1], pixelData[y].data());
+    }
+    
+    return pixelData;
+}
+
+void TileDecoder::DecodeTiles(
+    const uint8_t* vram,
+    uint16_t firstTile,
+    uint16_t count,
+    uint8_t* out
+) {
+    if (vram == nullptr || out == nullptr) {
+        return;
+    }
+    
+    // Tile rows are stored back to back, so the whole run is one linear
+    // walk over 2-byte row pairs producing 8 pixels each
+    const uint8_t* src = vram + static_cast<size_t>(firstTile) * 16;
+    size_t rowCount = static_cast<size_t>(count) * 8;
+    
+    for (size_t row = 0; row < rowCount; row++) {
+        DecodeTileRow(src[row * 2], src[row * 2 + 1], out + row * 8);
+    }
+}
+
+std::array<std::array<uint8_t, 8>, 8> TileDecoder::DecodeTileReference(
+    const uint8_t* vram,
+    uint16_t tileIndex
+) {
+    std::array<std::array<uint8_t, 8>, 8> pixelData;
     
-    // Get pointer to tile data within VRAM
-    const uint8_t* tileData = vram + offset;
+    const uint8_t* tileData = vram + tileIndex * 16;
     
     // Decode each pixel in the 8x8 tile
     for (int y = 0; y < 8; y++) {
@@ -1,4 +1,5 @@
 #include "TileRenderer.h"
+#include <cstring>
 
 // Silence OpenGL deprecation warnings on macOS
 #ifdef __APPLE__
@@ -114,6 +115,174 @@ bool TexturePool::ReinitializeIfNeeded(int rows, int cols, int scale) {
     return true;
 }
 
+// ============================================================================
+// TileAtlas Implementation
+// ============================================================================
+
+TileAtlas::TileAtlas()
+    : texture_(0), tileCols_(0), tileRows_(0),
+      dirtyMinRow_(0), dirtyMaxRow_(-1), indexed_(false), initialized_(false)
+{
+}
+
+TileAtlas::~TileAtlas() {
+    Clear();
+}
+
+void TileAtlas::Initialize(int tileCols, int tileRows, bool indexed) {
+    Clear();
+    
+    tileCols_ = tileCols;
+    tileRows_ = tileRows;
+    indexed_ = indexed;
+    
+    int width = tileCols * 8;
+    int height = tileRows * 8;
+    int bytesPerPixel = indexed ? 1 : 4;
+    pixels_.assign(static_cast<size_t>(width) * height * bytesPerPixel, 0);
+    
+    GLuint textureId = 0;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    
+    // Nearest filtering so tiles stay pixel-perfect when ImGui scales them up
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    // Indexed atlases keep the raw 0-3 value in a single channel
+    // (rows are tileCols * 8 bytes, always a multiple of 4, so the default
+    // unpack alignment is fine)
+    GLenum format = indexed ? GL_LUMINANCE : GL_RGBA;
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0,
+                 format, GL_UNSIGNED_BYTE, pixels_.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    texture_ = static_cast<unsigned int>(textureId);
+    dirtyMinRow_ = 0;
+    dirtyMaxRow_ = -1;
+    initialized_ = true;
+}
+
+bool TileAtlas::ReinitializeIfNeeded(int tileCols, int tileRows, bool indexed) {
+    if (initialized_ && tileCols_ == tileCols && tileRows_ == tileRows && indexed_ == indexed) {
+        return false;  // No change needed
+    }
+    Initialize(tileCols, tileRows, indexed);
+    return true;
+}
+
+void TileAtlas::WriteTile(
+    int slot,
+    const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+    const Palette& palette
+) {
+    if (!initialized_ || slot < 0 || slot >= GetTileCount()) {
+        return;
+    }
+    
+    int tileRow = slot / tileCols_;
+    int tileCol = slot % tileCols_;
+    int bytesPerPixel = indexed_ ? 1 : 4;
+    size_t stride = static_cast<size_t>(tileCols_) * 8 * bytesPerPixel;
+    uint8_t* dst = pixels_.data() + (tileRow * 8) * stride + tileCol * 8 * bytesPerPixel;
+    
+    if (indexed_) {
+        // Store color indices directly; the palette is applied on the GPU
+        for (int y = 0; y < 8; y++) {
+            std::memcpy(dst + y * stride, pixelData[y].data(), 8);
+        }
+    } else {
+        uint32_t packed[4];
+        std::memcpy(packed, palette.colors, sizeof(packed));
+        for (int y = 0; y < 8; y++) {
+            uint8_t* out = dst + y * stride;
+            for (int x = 0; x < 8; x++) {
+                uint8_t colorIndex = pixelData[y][x];
+                if (colorIndex > 3) {
+                    colorIndex = 3;
+                }
+                std::memcpy(out + x * 4, &packed[colorIndex], 4);
+            }
+        }
+    }
+    
+    // Grow the dirty band to include this tile row
+    if (dirtyMaxRow_ < 0) {
+        dirtyMinRow_ = tileRow;
+        dirtyMaxRow_ = tileRow;
+    } else {
+        if (tileRow < dirtyMinRow_) dirtyMinRow_ = tileRow;
+        if (tileRow > dirtyMaxRow_) dirtyMaxRow_ = tileRow;
+    }
+}
+
+void TileAtlas::WriteImage(const uint8_t* rgba) {
+    if (!initialized_ || indexed_) {
+        return;
+    }
+    
+    std::memcpy(pixels_.data(), rgba, pixels_.size());
+    dirtyMinRow_ = 0;
+    dirtyMaxRow_ = tileRows_ - 1;
+}
+
+unsigned int TileAtlas::Upload() {
+    if (!initialized_) {
+        return 0;
+    }
+    
+    if (dirtyMaxRow_ >= 0) {
+        int width = tileCols_ * 8;
+        int y = dirtyMinRow_ * 8;
+        int height = (dirtyMaxRow_ - dirtyMinRow_ + 1) * 8;
+        int bytesPerPixel = indexed_ ? 1 : 4;
+        const uint8_t* src = pixels_.data() + static_cast<size_t>(y) * width * bytesPerPixel;
+        GLenum format = indexed_ ? GL_LUMINANCE : GL_RGBA;
+        
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(texture_));
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, height,
+                        format, GL_UNSIGNED_BYTE, src);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        
+        dirtyMaxRow_ = -1;
+    }
+    
+    return texture_;
+}
+
+void TileAtlas::GetTileUV(int slot, float& u0, float& v0, float& u1, float& v1) const {
+    if (!initialized_ || slot < 0 || slot >= GetTileCount()) {
+        u0 = v0 = u1 = v1 = 0.0f;
+        return;
+    }
+    
+    int tileRow = slot / tileCols_;
+    int tileCol = slot % tileCols_;
+    float du = 1.0f / static_cast<float>(tileCols_);
+    float dv = 1.0f / static_cast<float>(tileRows_);
+    
+    u0 = tileCol * du;
+    v0 = tileRow * dv;
+    u1 = u0 + du;
+    v1 = v0 + dv;
+}
+
+void TileAtlas::Clear() {
+    if (texture_ != 0) {
+        GLuint glId = static_cast<GLuint>(texture_);
+        glDeleteTextures(1, &glId);
+        texture_ = 0;
+    }
+    pixels_.clear();
+    tileCols_ = 0;
+    tileRows_ = 0;
+    dirtyMaxRow_ = -1;
+    indexed_ = false;
+    initialized_ = false;
+}
+
 // ============================================================================
 // TileRenderer Implementation
 // ============================================================================
@@ -121,7 +290,8 @@ bool TexturePool::ReinitializeIfNeeded(int rows, int cols, int scale) {
 TileRenderer::TileRenderer()
     : currentScale_(2)
 {
-    // Pre-allocate texture buffer for common case (32x32 RGBA = 4096 bytes)
+    // Pre-allocate scratch buffer for the largest common case
+    // (inspector: 8x scale = 64x64 RGBA = 16384 bytes)
     textureBuffer_.reserve(64 * 64 * 4);
 }
 
@@ -134,9 +304,9 @@ void TileRenderer::InitializeTileGridPool(int rows, int cols, int scale) {
     currentScale_ = scale;
 }
 
-void TileRenderer::InitializeSpritePool(int maxSprites, int scale) {
+bool TileRenderer::InitializeSpritePool(int maxSprites, int scale) {
     // Each sprite needs 2 textures for 8x16 mode (top and bottom halves)
-    spritePool_.ReinitializeIfNeeded(maxSprites, 2, scale);
+    return spritePool_.ReinitializeIfNeeded(maxSprites, 2, scale);
 }
 
 void TileRenderer::InitializeInspectorPool(int scale) {
@@ -144,6 +314,42 @@ void TileRenderer::InitializeInspectorPool(int scale) {
     inspectorPool_.ReinitializeIfNeeded(1, 1, scale);
 }
 
+bool TileRenderer::InitializeTileAtlas(int tileCols, int tileRows, bool indexed) {
+    return tileAtlas_.ReinitializeIfNeeded(tileCols, tileRows, indexed);
+}
+
+bool TileRenderer::IsPaletteLookupAvailable() {
+    return paletteShader_.Initialize();
+}
+
+void TileRenderer::RenderTileToAtlas(
+    int slot,
+    const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+    const Palette& palette
+) {
+    tileAtlas_.WriteTile(slot, pixelData, palette);
+}
+
+unsigned int TileRenderer::UploadTileAtlas() {
+    return tileAtlas_.Upload();
+}
+
+void TileRenderer::GetAtlasTileUV(int slot, float& u0, float& v0, float& u1, float& v1) const {
+    tileAtlas_.GetTileUV(slot, u0, v0, u1, v1);
+}
+
+void TileRenderer::UpdateLookupPalettes(const Palette* bgPalettes, const Palette* spritePalettes) {
+    paletteShader_.UpdatePalettes(bgPalettes, spritePalettes);
+}
+
+void TileRenderer::BeginPaletteLookup(int paletteRow) {
+    paletteShader_.Begin(paletteRow);
+}
+
+void TileRenderer::EndPaletteLookup() {
+    paletteShader_.End();
+}
+
 unsigned int TileRenderer::RenderTileAt(
     int row, int col,
     const std::array<std::array<uint8_t, 8>, 8>& pixelData,
@@ -156,10 +362,10 @@ unsigned int TileRenderer::RenderTileAt(
     int scale = tileGridPool_.GetScale();
     
     // Convert pixel data to RGBA
-    std::vector<uint8_t> rgbaData = ConvertToRGBA(pixelData, palette, scale);
+    const uint8_t* rgbaData = ConvertToScratch(pixelData, palette, scale);
     
     // Update the texture at this grid position
-    tileGridPool_.UpdateTexture(row, col, rgbaData.data());
+    tileGridPool_.UpdateTexture(row, col, rgbaData);
     
     // Return the texture ID for ImGui::Image()
     return tileGridPool_.GetTexture(row, col);
@@ -179,10 +385,10 @@ unsigned int TileRenderer::RenderSpriteAt(
     int col = isBottomHalf ? 1 : 0;  // Column 0 = top/single, Column 1 = bottom
     
     // Convert pixel data to RGBA
-    std::vector<uint8_t> rgbaData = ConvertToRGBA(pixelData, palette, scale);
+    const uint8_t* rgbaData = ConvertToScratch(pixelData, palette, scale);
     
     // Update the texture at this sprite position
-    spritePool_.UpdateTexture(spriteIndex, col, rgbaData.data());
+    spritePool_.UpdateTexture(spriteIndex, col, rgbaData);
     
     // Return the texture ID for ImGui::Image()
     return spritePool_.GetTexture(spriteIndex, col);
@@ -199,10 +405,10 @@ unsigned int TileRenderer::RenderInspectorTile(
     int scale = inspectorPool_.GetScale();
     
     // Convert pixel data to RGBA
-    std::vector<uint8_t> rgbaData = ConvertToRGBA(pixelData, palette, scale);
+    const uint8_t* rgbaData = ConvertToScratch(pixelData, palette, scale);
     
     // Update the single inspector texture
-    inspectorPool_.UpdateTexture(0, 0, rgbaData.data());
+    inspectorPool_.UpdateTexture(0, 0, rgbaData);
     
     // Return the texture ID for ImGui::Image()
     return inspectorPool_.GetTexture(0, 0);
@@ -241,17 +447,26 @@ void TileRenderer::UpdateTexture(unsigned int texture, const uint8_t* data, int
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-std::vector<uint8_t> TileRenderer::ConvertToRGBA(
+void TileRenderer::ConvertToRGBA(
     const std::array<std::array<uint8_t, 8>, 8>& pixelData,
     const Palette& palette,
-    int scale
+    int scale,
+    uint8_t* out
 ) {
-    int outputSize = 8 * scale;
-    std::vector<uint8_t> rgba(outputSize * outputSize * 4);
+    static_assert(sizeof(TileColor) == 4, "TileColor must be packed RGBA");
+    
+    // Pack the 4 palette colors once; each output pixel is then one 32-bit store
+    uint32_t packed[4];
+    std::memcpy(packed, palette.colors, sizeof(packed));
+    
+    size_t rowBytes = static_cast<size_t>(8 * scale) * 4;
     
     for (int y = 0; y < 8; y++) {
+        uint8_t* row = out + static_cast<size_t>(y * scale) * rowBytes;
+        uint8_t* dst = row;
+        
+        // Build one scaled output row
         for (int x = 0; x < 8; x++) {
-            // Get color index (0-3) from pixel data
             uint8_t colorIndex = pixelData[y][x];
             
             // Clamp to valid range
@@ -259,26 +474,31 @@ std::vector<uint8_t> TileRenderer::ConvertToRGBA(
                 colorIndex = 3;
             }
             
-            // Get color from palette
-            const TileColor& color = palette.colors[colorIndex];
-            
-            // Fill scaled pixels
-            for (int sy = 0; sy < scale; sy++) {
-                for (int sx = 0; sx < scale; sx++) {
-                    int outX = x * scale + sx;
-                    int outY = y * scale + sy;
-                    int offset = (outY * outputSize + outX) * 4;
-                    
-                    rgba[offset + 0] = color.r;
-                    rgba[offset + 1] = color.g;
-                    rgba[offset + 2] = color.b;
-                    rgba[offset + 3] = color.a;
-                }
+            for (int sx = 0; sx < scale; sx++) {
+                std::memcpy(dst, &packed[colorIndex], 4);
+                dst += 4;
             }
         }
+        
+        // Replicate it for the remaining scaled rows
+        for (int sy = 1; sy < scale; sy++) {
+            std::memcpy(row + sy * rowBytes, row, rowBytes);
+        }
+    }
+}
+
+const uint8_t* TileRenderer::ConvertToScratch(
+    const std::array<std::array<uint8_t, 8>, 8>& pixelData,
+    const Palette& palette,
+    int scale
+) {
+    size_t outputSize = static_cast<size_t>(8 * scale) * (8 * scale) * 4;
+    if (textureBuffer_.size() < outputSize) {
+        textureBuffer_.resize(outputSize);
     }
     
-    return rgba;
+    ConvertToRGBA(pixelData, palette, scale, textureBuffer_.data());
+    return textureBuffer_.data();
 }
 
 unsigned int TileRenderer::RenderTile(
@@ -293,7 +513,7 @@ unsigned int TileRenderer::RenderTile(
     int textureSize = 8 * scale;
     
     // Convert pixel data to RGBA
-    std::vector<uint8_t> rgbaData = ConvertToRGBA(pixelData, palette, scale);
+    const uint8_t* rgbaData = ConvertToScratch(pixelData, palette, scale);
     
     // Create a new texture for this render (LEGACY behavior - causes memory leak if called repeatedly)
     unsigned int texture = CreateTexture(textureSize, textureSize);
@@ -302,7 +522,7 @@ unsigned int TileRenderer::RenderTile(
         // Upload the pixel data
         glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(texture));
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureSize, textureSize, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, rgbaData.data());
+                     GL_RGBA, GL_UNSIGNED_BYTE, rgbaData);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
     
@@ -329,11 +549,11 @@ void TileRenderer::UpdateTiles(
         } else if (IsTileDirty(tileIndex)) {
             // Update existing texture
             int textureSize = 8 * currentScale_;
-            std::vector<uint8_t> rgbaData = ConvertToRGBA(tile.pixels, palette, currentScale_);
+            const uint8_t* rgbaData = ConvertToScratch(tile.pixels, palette, currentScale_);
             
             glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(it->second));
             glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureSize, textureSize,
-                           GL_RGBA, GL_UNSIGNED_BYTE, rgbaData.data());
+                           GL_RGBA, GL_UNSIGNED_BYTE, rgbaData);
             glBindTexture(GL_TEXTURE_2D, 0);
             
             dirtyFlags_[tileIndex] = false;
@@ -371,7 +591,9 @@ bool TileRenderer::IsTileDirty(int tileIndex) const {
 }
 
 void TileRenderer::ClearTextures() {
-    // Clear texture pools
+    // Clear atlas, palette lookup and texture pools
+    tileAtlas_.Clear();
+    paletteShader_.Shutdown();
     tileGridPool_.Clear();
     spritePool_.Clear();
     inspectorPool_.Clear();
@@ -390,6 +612,7 @@ void TileRenderer::ClearTextures() {
 
 size_t TileRenderer::GetCacheSize() const {
     return tileTextures_.size() + 
+           (tileAtlas_.IsInitialized() ? 1 : 0) +
            (tileGridPool_.IsInitialized() ? tileGridPool_.GetRows() * tileGridPool_.GetCols() : 0) +
            (spritePool_.IsInitialized() ? spritePool_.GetRows() * spritePool_.GetCols() : 0) +
            (inspectorPool_.IsInitialized() ? 1 : 0);
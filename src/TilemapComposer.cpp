@@ -0,0 +1,106 @@
+#include "TilemapComposer.h"
+#include "TileDecoder.h"
+#include <cstring>
+
+namespace GBDebug {
+
+constexpr int TilemapComposer::MAP_SIZE;
+constexpr int TilemapComposer::CELL_COUNT;
+constexpr int TilemapComposer::TILES_PER_BANK;
+constexpr size_t TilemapComposer::TILE_DATA_SIZE;
+constexpr size_t TilemapComposer::MAP_9800;
+constexpr size_t TilemapComposer::MAP_9C00;
+
+TilemapComposer::TilemapComposer()
+    : hasShadow_(false)
+    , unsignedMode_(true)
+    , highMap_(false)
+    , hasAttributes_(false) {
+    for (auto& bank : tiles_) {
+        bank.fill(0);
+    }
+    map_.fill(0);
+    attributes_.fill(0);
+}
+
+void TilemapComposer::Invalidate() {
+    dirty_.set();
+}
+
+size_t TilemapComposer::Update(const uint8_t* vram0, const uint8_t* vram1, uint8_t lcdc, bool highMap) {
+    bool unsignedMode = (lcdc & 0x10) != 0;
+    bool hasAttributes = vram1 != nullptr;
+    size_t mapOffset = highMap ? MAP_9C00 : MAP_9800;
+    
+    // A different map or addressing mode changes what every cell shows
+    bool redrawAll = !hasShadow_ || unsignedMode != unsignedMode_ || highMap != highMap_ ||
+                     hasAttributes != hasAttributes_;
+    
+    // Tiles whose 16 bytes changed, per bank
+    std::bitset<TILES_PER_BANK> changedTiles[2];
+    const uint8_t* banks[2] = {vram0, vram1};
+    for (int bank = 0; bank < (hasAttributes ? 2 : 1); bank++) {
+        const uint8_t* source = banks[bank];
+        uint8_t* shadow = tiles_[bank].data();
+        if (!redrawAll && std::memcmp(shadow, source, TILE_DATA_SIZE) == 0) {
+            continue;
+        }
+        for (int tile = 0; tile < TILES_PER_BANK; tile++) {
+            if (std::memcmp(shadow + tile * 16, source + tile * 16, 16) != 0) {
+                std::memcpy(shadow + tile * 16, source + tile * 16, 16);
+                changedTiles[bank].set(tile);
+            }
+        }
+    }
+    
+    const uint8_t* map = vram0 + mapOffset;
+    const uint8_t* attributes = hasAttributes ? vram1 + mapOffset : nullptr;
+    size_t marked = 0;
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        uint8_t mapByte = map[cell];
+        uint8_t attribute = attributes != nullptr ? attributes[cell] : 0;
+        bool changed = redrawAll || mapByte != map_[cell] || attribute != attributes_[cell];
+        
+        if (changed) {
+            map_[cell] = mapByte;
+            attributes_[cell] = attribute;
+            
+            TilemapCell& resolved = cells_[cell];
+            resolved.tile = ResolveTile(mapByte, unsignedMode);
+            resolved.bank = (attribute >> 3) & 1;
+            resolved.palette = attribute & 0x07;
+            resolved.hFlip = (attribute & 0x20) != 0;
+            resolved.vFlip = (attribute & 0x40) != 0;
+            resolved.priority = (attribute & 0x80) != 0;
+        } else {
+            changed = changedTiles[cells_[cell].bank][cells_[cell].tile];
+        }
+        
+        if (changed && !dirty_[cell]) {
+            dirty_.set(cell);
+            marked++;
+        }
+    }
+    
+    hasShadow_ = true;
+    unsignedMode_ = unsignedMode;
+    highMap_ = highMap;
+    hasAttributes_ = hasAttributes;
+    return marked;
+}
+
+void TilemapComposer::DecodeCell(int cell, CellPixels& out) const {
+    const TilemapCell& resolved = cells_[cell];
+    const uint8_t* tile = tiles_[resolved.bank].data() + resolved.tile * 16;
+    
+    for (int y = 0; y < 8; y++) {
+        const uint8_t* data = tile + (resolved.vFlip ? 7 - y : y) * 2;
+        if (resolved.hFlip) {
+            TileDecoder::DecodeTileRow(TileDecoder::ReverseBits(data[0]), TileDecoder::ReverseBits(data[1]), out[y].data());
+        } else {
+            TileDecoder::DecodeTileRow(data[0], data[1], out[y].data());
+        }
+    }
+}
+
+} // namespace GBDebug
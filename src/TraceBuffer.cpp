@@ -0,0 +1,50 @@
+#include "TraceBuffer.h"
+
+namespace GBDebug {
+
+TraceBuffer::TraceBuffer()
+    : ring_(&scratch_)
+    , mask_(0)
+    , capacity_(0)
+    , scratch_()
+    , head_(0) {
+}
+
+void TraceBuffer::SetCapacity(size_t records) {
+    if (records == 0) {
+        storage_.reset();
+        ring_ = &scratch_;
+        mask_ = 0;
+        capacity_ = 0;
+    } else {
+        size_t capacity = 1;
+        while (capacity < records) {
+            capacity <<= 1;
+        }
+        storage_.reset(new TraceRecord[capacity]());
+        ring_ = storage_.get();
+        mask_ = capacity - 1;
+        capacity_ = capacity;
+    }
+    Clear();
+}
+
+bool TraceBuffer::Read(uint64_t index, TraceRecord& out) const {
+    // While index + capacity is being written, head equals index + capacity,
+    // so a record is safe to copy only while head - index < capacity
+    uint64_t head = head_.load(std::memory_order_acquire);
+    if (index >= head || head - index >= capacity_) {
+        return false;
+    }
+    
+    out = ring_[index & mask_];
+    
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return head_.load(std::memory_order_relaxed) - index < capacity_;
+}
+
+void TraceBuffer::Clear() {
+    head_.store(0, std::memory_order_release);
+}
+
+} // namespace GBDebug
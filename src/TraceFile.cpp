@@ -0,0 +1,511 @@
+#include "TraceFile.h"
+#include "Disassembler.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GBDebug {
+
+constexpr size_t TraceFileWriter::BLOCK_RECORDS;
+constexpr size_t TraceFileWriter::POOL_BLOCKS;
+
+namespace {
+
+const char FILE_MAGIC[8] = {'G', 'B', 'T', 'R', 'A', 'C', 'E', '\0'};
+const uint32_t FILE_VERSION = 1;
+const size_t FILE_HEADER_SIZE = 16;
+
+const uint32_t BLOCK_MAGIC = 0x4B4C4254;   // "TBLK"
+const size_t BLOCK_HEADER_SIZE = 48;
+
+// Record tag bits
+const uint8_t TAG_AF = 1 << 0;
+const uint8_t TAG_BC = 1 << 1;
+const uint8_t TAG_DE = 1 << 2;
+const uint8_t TAG_HL = 1 << 3;
+const uint8_t TAG_SP = 1 << 4;
+const uint8_t TAG_IME = 1 << 5;
+const uint8_t TAG_JUMP = 1 << 6;
+
+// Longest encoded record: tag, opcode, two 10-byte varints, five registers
+const size_t MAX_RECORD_BYTES = 2 + 10 + 10 + 5 * 2;
+
+uint8_t* Put16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    return out + 2;
+}
+
+void Put32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+void Put64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+uint16_t Get16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t Get32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+uint64_t Get64(const uint8_t* in) {
+    return static_cast<uint64_t>(Get32(in)) | (static_cast<uint64_t>(Get32(in + 4)) << 32);
+}
+
+uint8_t* PutVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+bool GetVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in == end) {
+            return false;
+        }
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t FallThrough(const TraceFileRecord& record) {
+    return static_cast<uint16_t>(record.state.pc + Disassembler::GetLength(record.opcode));
+}
+
+} // namespace
+
+// ========== TraceFileWriter ==========
+
+TraceFileWriter::TraceFileWriter()
+    : file_(nullptr)
+    , open_(false)
+    , appending_(false)
+    , current_(nullptr)
+    , stopping_(false)
+    , recordsWritten_(0)
+    , bytesWritten_(0)
+    , failed_(false) {
+}
+
+TraceFileWriter::~TraceFileWriter() {
+    Close();
+}
+
+bool TraceFileWriter::Open(const std::string& path, std::string& error) {
+    Close();
+    
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        error = "Cannot create " + path;
+        return false;
+    }
+    
+    uint8_t header[FILE_HEADER_SIZE] = {};
+    std::memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    Put32(header + 8, FILE_VERSION);
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        error = "Cannot write to " + path;
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    
+    if (pool_.empty()) {
+        for (size_t i = 0; i < POOL_BLOCKS; i++) {
+            pool_.push_back(std::unique_ptr<RawBlock>(new RawBlock()));
+        }
+    }
+    free_.clear();
+    full_.clear();
+    for (size_t i = 1; i < POOL_BLOCKS; i++) {
+        pool_[i]->count = 0;
+        free_.push_back(pool_[i].get());
+    }
+    current_ = pool_[0].get();
+    current_->count = 0;
+    
+    recordsWritten_.store(0, std::memory_order_relaxed);
+    bytesWritten_.store(FILE_HEADER_SIZE, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    stopping_ = false;
+    thread_ = std::thread(&TraceFileWriter::WriterLoop, this);
+    
+    // Publish the block to the producer last
+    open_.store(true, std::memory_order_release);
+    return true;
+}
+
+bool TraceFileWriter::Close() {
+    if (file_ == nullptr) {
+        return true;
+    }
+    
+    // Once the producer has left Append() it will not touch current_ again
+    open_.store(false, std::memory_order_seq_cst);
+    while (appending_.load(std::memory_order_seq_cst)) {
+        std::this_thread::yield();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (current_->count > 0) {
+            full_.push_back(current_);
+        }
+        current_ = nullptr;
+        stopping_ = true;
+    }
+    fullReady_.notify_one();
+    thread_.join();
+    
+    if (std::fclose(file_) != 0) {
+        failed_.store(true, std::memory_order_relaxed);
+    }
+    file_ = nullptr;
+    return !HasError();
+}
+
+void TraceFileWriter::SubmitBlock() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_.push_back(current_);
+    fullReady_.notify_one();
+    
+    // Only waits when the disk falls POOL_BLOCKS - 1 blocks behind
+    freeReady_.wait(lock, [this]() { return !free_.empty(); });
+    current_ = free_.front();
+    free_.pop_front();
+    current_->count = 0;
+}
+
+void TraceFileWriter::WriterLoop() {
+    for (;;) {
+        RawBlock* block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            fullReady_.wait(lock, [this]() { return stopping_ || !full_.empty(); });
+            if (full_.empty()) {
+                return;
+            }
+            block = full_.front();
+            full_.pop_front();
+        }
+        
+        if (!failed_.load(std::memory_order_relaxed) && !WriteBlock(*block)) {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(block);
+        }
+        freeReady_.notify_one();
+    }
+}
+
+bool TraceFileWriter::WriteBlock(const RawBlock& block) {
+    const TraceFileRecord& first = block.records[0];
+    const TraceFileRecord& last = block.records[block.count - 1];
+    
+    // Encode through a raw pointer into a buffer sized for the worst case
+    encoded_.resize(block.count * MAX_RECORD_BYTES);
+    uint8_t* out = encoded_.data();
+    for (size_t i = 1; i < block.count; i++) {
+        const TraceFileRecord& prev = block.records[i - 1];
+        const TraceFileRecord& record = block.records[i];
+        
+        uint8_t tag = 0;
+        if (record.state.af != prev.state.af) tag |= TAG_AF;
+        if (record.state.bc != prev.state.bc) tag |= TAG_BC;
+        if (record.state.de != prev.state.de) tag |= TAG_DE;
+        if (record.state.hl != prev.state.hl) tag |= TAG_HL;
+        if (record.state.sp != prev.state.sp) tag |= TAG_SP;
+        if (record.state.ime != prev.state.ime) tag |= TAG_IME;
+        int32_t jump = static_cast<int16_t>(record.state.pc - FallThrough(prev));
+        if (jump != 0) tag |= TAG_JUMP;
+        
+        *out++ = tag;
+        *out++ = record.opcode;
+        out = PutVarint(out, record.state.cycle - prev.state.cycle);
+        if (tag & TAG_JUMP) {
+            out = PutVarint(out, (static_cast<uint32_t>(jump) << 1) ^ static_cast<uint32_t>(jump >> 31));
+        }
+        if (tag & TAG_AF) out = Put16(out, record.state.af);
+        if (tag & TAG_BC) out = Put16(out, record.state.bc);
+        if (tag & TAG_DE) out = Put16(out, record.state.de);
+        if (tag & TAG_HL) out = Put16(out, record.state.hl);
+        if (tag & TAG_SP) out = Put16(out, record.state.sp);
+    }
+    size_t payload = static_cast<size_t>(out - encoded_.data());
+    
+    uint8_t header[BLOCK_HEADER_SIZE] = {};
+    Put32(header, BLOCK_MAGIC);
+    Put32(header + 4, static_cast<uint32_t>(payload));
+    Put32(header + 8, static_cast<uint32_t>(block.count));
+    Put64(header + 12, first.state.cycle);
+    Put64(header + 20, last.state.cycle);
+    const uint16_t registers[6] = {
+        first.state.pc, first.state.sp, first.state.af, first.state.bc, first.state.de, first.state.hl
+    };
+    for (int i = 0; i < 6; i++) {
+        header[28 + i * 2] = static_cast<uint8_t>(registers[i]);
+        header[29 + i * 2] = static_cast<uint8_t>(registers[i] >> 8);
+    }
+    header[40] = first.opcode;
+    header[41] = first.state.ime ? 1 : 0;
+    
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header) ||
+        std::fwrite(encoded_.data(), 1, payload, file_) != payload) {
+        return false;
+    }
+    
+    recordsWritten_.fetch_add(block.count, std::memory_order_relaxed);
+    bytesWritten_.fetch_add(sizeof(header) + payload, std::memory_order_relaxed);
+    return true;
+}
+
+// ========== TraceFileReader ==========
+
+TraceFileReader::TraceFileReader()
+    : data_(nullptr)
+    , size_(0)
+    , mapped_(false)
+    , recordCount_(0)
+    , decodedBlock_(SIZE_MAX) {
+}
+
+TraceFileReader::~TraceFileReader() {
+    Close();
+}
+
+bool TraceFileReader::Open(const std::string& path, std::string& error) {
+    Close();
+    
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* map = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            data_ = static_cast<const uint8_t*>(map);
+            size_ = static_cast<size_t>(info.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+#endif
+    
+    if (!mapped_) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            error = "Cannot open " + path;
+            return false;
+        }
+        uint8_t chunk[65536];
+        size_t read;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            buffer_.insert(buffer_.end(), chunk, chunk + read);
+        }
+        std::fclose(file);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+    
+    if (size_ < FILE_HEADER_SIZE || std::memcmp(data_, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        error = path + " is not a trace file";
+        Close();
+        return false;
+    }
+    if (Get32(data_ + 8) != FILE_VERSION) {
+        error = path + " has an unsupported trace version";
+        Close();
+        return false;
+    }
+    
+    // Index block headers; payloads are decoded on demand
+    size_t offset = FILE_HEADER_SIZE;
+    while (size_ - offset >= BLOCK_HEADER_SIZE) {
+        const uint8_t* header = data_ + offset;
+        uint32_t payload = Get32(header + 4);
+        uint32_t count = Get32(header + 8);
+        if (Get32(header) != BLOCK_MAGIC || count == 0 || size_ - offset - BLOCK_HEADER_SIZE < payload) {
+            break;
+        }
+        
+        BlockInfo block;
+        block.offset = offset;
+        block.firstRecord = recordCount_;
+        block.count = count;
+        block.firstCycle = Get64(header + 12);
+        block.lastCycle = Get64(header + 20);
+        blocks_.push_back(block);
+        
+        recordCount_ += count;
+        offset += BLOCK_HEADER_SIZE + payload;
+    }
+    return true;
+}
+
+void TraceFileReader::Close() {
+#ifndef _WIN32
+    if (mapped_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+    blocks_.clear();
+    recordCount_ = 0;
+    decoded_.clear();
+    decodedBlock_ = SIZE_MAX;
+}
+
+uint64_t TraceFileReader::FindCycle(uint64_t cycle) {
+    // First block whose last cycle reaches the target
+    std::vector<BlockInfo>::const_iterator block = std::lower_bound(
+        blocks_.begin(), blocks_.end(), cycle,
+        [](const BlockInfo& info, uint64_t value) { return info.lastCycle < value; });
+    if (block == blocks_.end()) {
+        return recordCount_;
+    }
+    if (block->firstCycle >= cycle) {
+        return block->firstRecord;
+    }
+    
+    size_t index = static_cast<size_t>(block - blocks_.begin());
+    if (!LoadBlock(index)) {
+        return recordCount_;
+    }
+    std::vector<TraceFileRecord>::const_iterator record = std::lower_bound(
+        decoded_.begin(), decoded_.end(), cycle,
+        [](const TraceFileRecord& r, uint64_t value) { return r.state.cycle < value; });
+    return block->firstRecord + static_cast<uint64_t>(record - decoded_.begin());
+}
+
+bool TraceFileReader::ReadRecord(uint64_t index, TraceFileRecord& out) {
+    if (index >= recordCount_) {
+        return false;
+    }
+    size_t block = FindBlock(index);
+    if (!LoadBlock(block)) {
+        return false;
+    }
+    out = decoded_[static_cast<size_t>(index - blocks_[block].firstRecord)];
+    return true;
+}
+
+bool TraceFileReader::ReadBlock(size_t block, std::vector<TraceFileRecord>& out) {
+    if (block >= blocks_.size() || !LoadBlock(block)) {
+        return false;
+    }
+    out = decoded_;
+    return true;
+}
+
+size_t TraceFileReader::FindBlock(uint64_t index) const {
+    std::vector<BlockInfo>::const_iterator block = std::upper_bound(
+        blocks_.begin(), blocks_.end(), index,
+        [](uint64_t value, const BlockInfo& info) { return value < info.firstRecord; });
+    return static_cast<size_t>(block - blocks_.begin()) - 1;
+}
+
+bool TraceFileReader::LoadBlock(size_t block) {
+    if (block == decodedBlock_) {
+        return true;
+    }
+    
+    const BlockInfo& info = blocks_[block];
+    const uint8_t* header = data_ + info.offset;
+    const uint8_t* in = header + BLOCK_HEADER_SIZE;
+    const uint8_t* end = in + Get32(header + 4);
+    
+    decodedBlock_ = SIZE_MAX;
+    decoded_.resize(info.count);
+    
+    TraceFileRecord& first = decoded_[0];
+    first.state.cycle = info.firstCycle;
+    first.state.pc = Get16(header + 28);
+    first.state.sp = Get16(header + 30);
+    first.state.af = Get16(header + 32);
+    first.state.bc = Get16(header + 34);
+    first.state.de = Get16(header + 36);
+    first.state.hl = Get16(header + 38);
+    first.opcode = header[40];
+    first.state.ime = header[41] != 0;
+    
+    for (uint32_t i = 1; i < info.count; i++) {
+        const TraceFileRecord& prev = decoded_[i - 1];
+        TraceFileRecord& record = decoded_[i];
+        record = prev;
+        
+        if (end - in < 2) {
+            return false;
+        }
+        uint8_t tag = *in++;
+        record.opcode = *in++;
+        
+        uint64_t delta;
+        if (!GetVarint(in, end, delta)) {
+            return false;
+        }
+        record.state.cycle = prev.state.cycle + delta;
+        
+        record.state.pc = FallThrough(prev);
+        if (tag & TAG_JUMP) {
+            uint64_t zigzag;
+            if (!GetVarint(in, end, zigzag)) {
+                return false;
+            }
+            int32_t jump = static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            record.state.pc = static_cast<uint16_t>(record.state.pc + jump);
+        }
+        if (tag & TAG_IME) {
+            record.state.ime = !prev.state.ime;
+        }
+        
+        uint16_t* registers[5] = {
+            &record.state.af, &record.state.bc, &record.state.de, &record.state.hl, &record.state.sp
+        };
+        for (int bit = 0; bit < 5; bit++) {
+            if (tag & (1 << bit)) {
+                if (end - in < 2) {
+                    return false;
+                }
+                *registers[bit] = Get16(in);
+                in += 2;
+            }
+        }
+    }
+    
+    decodedBlock_ = block;
+    return true;
+}
+
+} // namespace GBDebug
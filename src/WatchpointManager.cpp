@@ -0,0 +1,153 @@
+#include "WatchpointManager.h"
+
+namespace GBDebug {
+
+constexpr size_t WatchpointManager::PAGE_COUNT;
+constexpr uint8_t WatchpointManager::PAGE_READ;
+constexpr uint8_t WatchpointManager::PAGE_WRITE;
+
+WatchpointManager::WatchpointManager()
+    : hitSequence_(0) {
+    for (auto& flags : pageFlags_) {
+        flags.store(0, std::memory_order_relaxed);
+    }
+    lastValues_.fill(0);
+    lastHit_.address = 0;
+    lastHit_.value = 0;
+    lastHit_.isWrite = false;
+}
+
+bool WatchpointManager::Check(uint16_t address, uint8_t value, bool isWrite) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint8_t accessBit = isWrite ? static_cast<uint8_t>(WatchType::Write)
+                                : static_cast<uint8_t>(WatchType::Read);
+    bool known = lastKnown_[address];
+    bool changed = known && lastValues_[address] != value;
+    bool hit = false;
+
+    for (auto& watch : entries_) {
+        if (!watch.enabled || address < watch.start || address > watch.end ||
+            (static_cast<uint8_t>(watch.type) & accessBit) == 0) {
+            continue;
+        }
+
+        bool matches = true;
+        switch (watch.condition) {
+            case WatchCondition::Always:
+                break;
+            case WatchCondition::ValueEquals:
+                matches = (value == watch.value);
+                break;
+            case WatchCondition::ValueChanged:
+                matches = changed;
+                break;
+        }
+
+        if (matches) {
+            watch.hitCount++;
+            hit = true;
+        }
+    }
+
+    lastValues_[address] = value;
+    lastKnown_.set(address);
+
+    if (hit) {
+        lastHit_.address = address;
+        lastHit_.value = value;
+        lastHit_.isWrite = isWrite;
+        hitSequence_.fetch_add(1, std::memory_order_release);
+    }
+    return hit;
+}
+
+void WatchpointManager::Add(const Watchpoint& watch, const uint8_t* memory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Watchpoint entry = watch;
+    if (entry.start > entry.end) {
+        uint16_t tmp = entry.start;
+        entry.start = entry.end;
+        entry.end = tmp;
+    }
+
+    // Values recorded for earlier watches may be long out of date
+    for (uint32_t address = entry.start; address <= entry.end; address++) {
+        if (memory != nullptr) {
+            lastValues_[address] = memory[address];
+            lastKnown_.set(address);
+        } else {
+            lastKnown_.reset(address);
+        }
+    }
+
+    entries_.push_back(entry);
+    RebuildPageFlags();
+}
+
+void WatchpointManager::SetEnabled(size_t index, bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index < entries_.size() && entries_[index].enabled != enabled) {
+        entries_[index].enabled = enabled;
+        RebuildPageFlags();
+    }
+}
+
+void WatchpointManager::RemoveAt(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index < entries_.size()) {
+        entries_.erase(entries_.begin() + index);
+        RebuildPageFlags();
+    }
+}
+
+void WatchpointManager::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    entries_.clear();
+    lastKnown_.reset();
+    RebuildPageFlags();
+}
+
+void WatchpointManager::CopyWatchpoints(std::vector<Watchpoint>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.assign(entries_.begin(), entries_.end());
+}
+
+uint32_t WatchpointManager::GetLastHit(WatchHit& hit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    hit = lastHit_;
+    return hitSequence_.load(std::memory_order_relaxed);
+}
+
+void WatchpointManager::RebuildPageFlags() {
+    std::array<uint8_t, PAGE_COUNT> flags;
+    flags.fill(0);
+
+    for (const auto& watch : entries_) {
+        if (!watch.enabled) {
+            continue;
+        }
+
+        uint8_t bits = 0;
+        if (static_cast<uint8_t>(watch.type) & static_cast<uint8_t>(WatchType::Read)) {
+            bits |= PAGE_READ;
+        }
+        if (static_cast<uint8_t>(watch.type) & static_cast<uint8_t>(WatchType::Write)) {
+            bits |= PAGE_WRITE;
+        }
+        for (int page = watch.start >> 8; page <= (watch.end >> 8); page++) {
+            flags[page] |= bits;
+        }
+    }
+
+    for (size_t i = 0; i < PAGE_COUNT; i++) {
+        pageFlags_[i].store(flags[i], std::memory_order_relaxed);
+    }
+}
+
+} // namespace GBDebug
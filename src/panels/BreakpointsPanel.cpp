@@ -0,0 +1,346 @@
+#include "panels/BreakpointsPanel.h"
+#include "imgui.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace GBDebug {
+
+namespace {
+
+const char* const WATCH_TYPE_LABELS[] = {"Read", "Write", "Read/Write"};
+const WatchType WATCH_TYPES[] = {WatchType::Read, WatchType::Write, WatchType::Access};
+
+const char* const WATCH_CONDITION_LABELS[] = {"Any value", "Value ==", "Value changed"};
+const WatchCondition WATCH_CONDITIONS[] = {
+    WatchCondition::Always, WatchCondition::ValueEquals, WatchCondition::ValueChanged
+};
+
+const char* WatchTypeLabel(WatchType type) {
+    switch (type) {
+        case WatchType::Read:  return "R";
+        case WatchType::Write: return "W";
+        default:               return "RW";
+    }
+}
+
+} // namespace
+
+BreakpointsPanel::BreakpointsPanel(BreakpointManager& breakpoints, WatchpointManager& watchpoints)
+    : breakpoints_(breakpoints)
+    , watchpoints_(watchpoints)
+    , watchType_(1)
+    , watchCondition_(0)
+    , bankInput_(1)
+    , anyBank_(true)
+    , editIndex_(-1)
+    , memory_(nullptr)
+    , visible_(true) {
+    addressInput_[0] = '\0';
+    conditionInput_[0] = '\0';
+    editInput_[0] = '\0';
+    watchStartInput_[0] = '\0';
+    watchEndInput_[0] = '\0';
+    watchValueInput_[0] = '\0';
+}
+
+void BreakpointsPanel::RenderAddForm() {
+    ImGui::Text("Address:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(60);
+    bool submitted = ImGui::InputText("##bpaddr", addressInput_, sizeof(addressInput_),
+                                      ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue);
+    
+    ImGui::SameLine();
+    ImGui::Checkbox("Any bank", &anyBank_);
+    if (!anyBank_) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(80);
+        ImGui::InputInt("Bank", &bankInput_);
+        if (bankInput_ < 0) {
+            bankInput_ = 0;
+        } else if (bankInput_ > Breakpoint::MAX_BANK) {
+            bankInput_ = Breakpoint::MAX_BANK;
+        }
+    }
+    
+    ImGui::Text("Condition:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(-50);
+    if (ImGui::InputText("##bpcond", conditionInput_, sizeof(conditionInput_))) {
+        ValidateCondition(conditionInput_, conditionError_);
+    }
+    
+    ImGui::SameLine();
+    if ((ImGui::Button("Add") || submitted) && addressInput_[0] != '\0' && conditionError_.empty()) {
+        unsigned long address = std::strtoul(addressInput_, nullptr, 16);
+        if (address <= 0xFFFF) {
+            int bank = anyBank_ ? Breakpoint::ANY_BANK : bankInput_;
+            breakpoints_.Add(static_cast<uint16_t>(address), bank);
+            if (conditionInput_[0] != '\0') {
+                int index = breakpoints_.Find(static_cast<uint16_t>(address), bank);
+                if (index >= 0) {
+                    breakpoints_.SetCondition(index, conditionInput_, conditionError_);
+                }
+            }
+            addressInput_[0] = '\0';
+            conditionInput_[0] = '\0';
+        }
+    }
+    RenderConditionStatus(conditionInput_, conditionError_);
+}
+
+void BreakpointsPanel::ValidateCondition(const char* text, std::string& error) {
+    error.clear();
+    if (text[0] != '\0') {
+        scratch_.Compile(text, error);
+    }
+}
+
+void BreakpointsPanel::RenderConditionStatus(const char* text, const std::string& error) {
+    if (!error.empty()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", error.c_str());
+    } else if (text[0] != '\0') {
+        ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Condition OK");
+    }
+}
+
+void BreakpointsPanel::RenderConditionEditor() {
+    if (editIndex_ < 0 || static_cast<size_t>(editIndex_) >= entries_.size()) {
+        editIndex_ = -1;
+        return;
+    }
+    
+    const Breakpoint& entry = entries_[editIndex_];
+    ImGui::Text("Condition for $%04X:", entry.address);
+    ImGui::SetNextItemWidth(-50);
+    bool submitted = ImGui::InputText("##bpedit", editInput_, sizeof(editInput_),
+                                      ImGuiInputTextFlags_EnterReturnsTrue);
+    // EnterReturnsTrue hides edits, so revalidate every frame; it is cheap
+    ValidateCondition(editInput_, editError_);
+    
+    ImGui::SameLine();
+    if ((ImGui::Button("Set") || submitted) && editError_.empty()) {
+        breakpoints_.SetCondition(editIndex_, editInput_, editError_);
+        editIndex_ = -1;
+        return;
+    }
+    RenderConditionStatus(editInput_, editError_);
+}
+
+void BreakpointsPanel::Render() {
+    if (!visible_) {
+        return;
+    }
+    
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(790, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 240), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin(GetName());
+    
+    uint16_t hitAddress;
+    int hitBank;
+    if (breakpoints_.GetLastHit(hitAddress, hitBank)) {
+        if (hitBank == Breakpoint::ANY_BANK) {
+            ImGui::Text("Last hit: $%04X", hitAddress);
+        } else {
+            ImGui::Text("Last hit: %02X:$%04X", hitBank, hitAddress);
+        }
+    } else {
+        ImGui::TextDisabled("No breakpoint hit yet");
+    }
+    
+    RenderAddForm();
+    ImGui::Separator();
+    
+    breakpoints_.CopyBreakpoints(entries_);
+    if (entries_.empty()) {
+        ImGui::TextDisabled("No breakpoints");
+        RenderWatchpoints();
+        ImGui::End();
+        return;
+    }
+    
+    // Edits are applied after the table so indices stay valid while drawing
+    int toggleIndex = -1;
+    int removeIndex = -1;
+    
+    if (ImGui::BeginTable("BreakpointTable", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("On");
+        ImGui::TableSetupColumn("Address");
+        ImGui::TableSetupColumn("Condition", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Hits");
+        ImGui::TableSetupColumn("");
+        ImGui::TableHeadersRow();
+        
+        for (size_t i = 0; i < entries_.size(); i++) {
+            const Breakpoint& entry = entries_[i];
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextRow();
+            
+            ImGui::TableNextColumn();
+            bool enabled = entry.enabled;
+            if (ImGui::Checkbox("##on", &enabled)) {
+                toggleIndex = static_cast<int>(i);
+            }
+            
+            ImGui::TableNextColumn();
+            if (entry.bank == Breakpoint::ANY_BANK) {
+                ImGui::Text("$%04X", entry.address);
+            } else {
+                ImGui::Text("%02X:$%04X", entry.bank, entry.address);
+            }
+            
+            // Clicking the condition selects the row for editing below
+            ImGui::TableNextColumn();
+            const char* source = entry.condition ? entry.condition->GetSource().c_str() : "";
+            if (ImGui::Selectable(source[0] != '\0' ? source : "(always)", editIndex_ == static_cast<int>(i))) {
+                editIndex_ = static_cast<int>(i);
+                std::strncpy(editInput_, source, sizeof(editInput_) - 1);
+                editInput_[sizeof(editInput_) - 1] = '\0';
+                editError_.clear();
+            }
+            
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", entry.hitCount);
+            
+            ImGui::TableNextColumn();
+            if (ImGui::SmallButton("X")) {
+                removeIndex = static_cast<int>(i);
+            }
+            
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    
+    RenderConditionEditor();
+    
+    if (toggleIndex >= 0) {
+        breakpoints_.SetEnabled(toggleIndex, !entries_[toggleIndex].enabled);
+    }
+    if (removeIndex >= 0) {
+        breakpoints_.RemoveAt(removeIndex);
+        editIndex_ = -1;
+    }
+    
+    if (ImGui::Button("Clear all")) {
+        breakpoints_.Clear();
+        editIndex_ = -1;
+    }
+    
+    RenderWatchpoints();
+    
+    ImGui::End();
+}
+
+void BreakpointsPanel::RenderWatchpoints() {
+    if (!ImGui::CollapsingHeader("Watchpoints", ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+    
+    WatchHit hit;
+    if (watchpoints_.GetLastHit(hit) != 0) {
+        ImGui::Text("Last hit: %s $%04X = %02X", hit.isWrite ? "write" : "read", hit.address, hit.value);
+    }
+    
+    // Add form: start [end] type condition [value]
+    ImGui::SetNextItemWidth(50);
+    ImGui::InputText("##wstart", watchStartInput_, sizeof(watchStartInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    ImGui::SameLine();
+    ImGui::Text("-");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(50);
+    ImGui::InputText("##wend", watchEndInput_, sizeof(watchEndInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(90);
+    ImGui::Combo("##wtype", &watchType_, WATCH_TYPE_LABELS, 3);
+    
+    ImGui::SetNextItemWidth(120);
+    ImGui::Combo("##wcond", &watchCondition_, WATCH_CONDITION_LABELS, 3);
+    if (WATCH_CONDITIONS[watchCondition_] == WatchCondition::ValueEquals) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(30);
+        ImGui::InputText("##wvalue", watchValueInput_, sizeof(watchValueInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Add watch") && watchStartInput_[0] != '\0') {
+        unsigned long start = std::strtoul(watchStartInput_, nullptr, 16);
+        unsigned long end = watchEndInput_[0] != '\0' ? std::strtoul(watchEndInput_, nullptr, 16) : start;
+        if (start <= 0xFFFF && end <= 0xFFFF) {
+            Watchpoint watch;
+            watch.start = static_cast<uint16_t>(start);
+            watch.end = static_cast<uint16_t>(end);
+            watch.type = WATCH_TYPES[watchType_];
+            watch.condition = WATCH_CONDITIONS[watchCondition_];
+            watch.value = static_cast<uint8_t>(std::strtoul(watchValueInput_, nullptr, 16));
+            watchpoints_.Add(watch, memory_);
+            watchStartInput_[0] = '\0';
+            watchEndInput_[0] = '\0';
+        }
+    }
+    
+    watchpoints_.CopyWatchpoints(watchEntries_);
+    if (watchEntries_.empty()) {
+        ImGui::TextDisabled("No watchpoints");
+        return;
+    }
+    
+    int toggleIndex = -1;
+    int removeIndex = -1;
+    
+    if (ImGui::BeginTable("WatchpointTable", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("On");
+        ImGui::TableSetupColumn("Range");
+        ImGui::TableSetupColumn("Condition");
+        ImGui::TableSetupColumn("Hits");
+        ImGui::TableSetupColumn("");
+        ImGui::TableHeadersRow();
+        
+        for (size_t i = 0; i < watchEntries_.size(); i++) {
+            const Watchpoint& watch = watchEntries_[i];
+            ImGui::PushID(static_cast<int>(i) + 0x10000);
+            ImGui::TableNextRow();
+            
+            ImGui::TableNextColumn();
+            bool enabled = watch.enabled;
+            if (ImGui::Checkbox("##on", &enabled)) {
+                toggleIndex = static_cast<int>(i);
+            }
+            
+            ImGui::TableNextColumn();
+            if (watch.start == watch.end) {
+                ImGui::Text("%-2s $%04X", WatchTypeLabel(watch.type), watch.start);
+            } else {
+                ImGui::Text("%-2s $%04X-$%04X", WatchTypeLabel(watch.type), watch.start, watch.end);
+            }
+            
+            ImGui::TableNextColumn();
+            switch (watch.condition) {
+                case WatchCondition::Always:       ImGui::TextUnformatted("any"); break;
+                case WatchCondition::ValueEquals:  ImGui::Text("== %02X", watch.value); break;
+                case WatchCondition::ValueChanged: ImGui::TextUnformatted("changed"); break;
+            }
+            
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", watch.hitCount);
+            
+            ImGui::TableNextColumn();
+            if (ImGui::SmallButton("X")) {
+                removeIndex = static_cast<int>(i);
+            }
+            
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    
+    if (toggleIndex >= 0) {
+        watchpoints_.SetEnabled(toggleIndex, !watchEntries_[toggleIndex].enabled);
+    }
+    if (removeIndex >= 0) {
+        watchpoints_.RemoveAt(removeIndex);
+    }
+}
+
+} // namespace GBDebug
@@ -14,24 +14,32 @@ ControlPanel::ControlPanel()
 float ControlPanel::GetSpeedMultiplier() const {
     // Index: 0=1/8x, 1=1/4x, 2=1/2x, 3=1x, 4=2x, 5=4x, 6=8x
     static const float multipliers[] = {0.125f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
-    return multipliers[speed_index_];
+    return multipliers[GetSpeedIndex()];
+}
+
+void ControlPanel::ToggleRunning() {
+    bool running = running_.load(std::memory_order_relaxed);
+    while (!running_.compare_exchange_weak(running, !running, std::memory_order_relaxed)) {
+    }
 }
 
 void ControlPanel::CycleSpeedUp() {
-    if (speed_index_ < SPEED_COUNT - 1) {
-        speed_index_++;
+    int index = speed_index_.load(std::memory_order_relaxed);
+    while (index < SPEED_COUNT - 1 &&
+           !speed_index_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
     }
 }
 
 void ControlPanel::CycleSpeedDown() {
-    if (speed_index_ > 0) {
-        speed_index_--;
+    int index = speed_index_.load(std::memory_order_relaxed);
+    while (index > 0 &&
+           !speed_index_.compare_exchange_weak(index, index - 1, std::memory_order_relaxed)) {
     }
 }
 
 void ControlPanel::SetSpeedIndex(int index) {
     if (index >= 0 && index < SPEED_COUNT) {
-        speed_index_ = index;
+        speed_index_.store(index, std::memory_order_relaxed);
     }
 }
 
@@ -47,35 +55,37 @@ void ControlPanel::Render() {
     ImGui::Begin(GetName());
     
     // Run/Stop button
-    if (running_) {
+    bool running = IsRunning();
+    if (running) {
         if (ImGui::Button("Stop (R)", ImVec2(180, 0))) {
-            running_ = false;
+            SetRunning(false);
         }
     } else {
         if (ImGui::Button("Run (R)", ImVec2(180, 0))) {
-            running_ = true;
+            SetRunning(true);
         }
     }
     
     // Step button (only enabled when not running)
-    if (running_) {
+    if (running) {
         ImGui::BeginDisabled();
     }
     if (ImGui::Button("Step (S)", ImVec2(180, 0))) {
-        step_requested_ = true;
+        step_requested_.store(true, std::memory_order_relaxed);
     }
-    if (running_) {
+    if (running) {
         ImGui::EndDisabled();
     }
     
     // Speed dropdown with fractional and multiplied speeds
     static const char* speed_labels[] = {"1/8x", "1/4x", "1/2x", "1x", "2x", "4x", "8x"};
     ImGui::SetNextItemWidth(130);
-    if (ImGui::BeginCombo("Speed", speed_labels[speed_index_])) {
+    int speed_index = GetSpeedIndex();
+    if (ImGui::BeginCombo("Speed", speed_labels[speed_index])) {
         for (int i = 0; i < SPEED_COUNT; i++) {
-            bool is_selected = (speed_index_ == i);
+            bool is_selected = (speed_index == i);
             if (ImGui::Selectable(speed_labels[i], is_selected)) {
-                speed_index_ = i;
+                SetSpeedIndex(i);
             }
             if (is_selected) {
                 ImGui::SetItemDefaultFocus();
@@ -88,7 +98,7 @@ void ControlPanel::Render() {
     
     // Exit button
     if (ImGui::Button("Exit (ESC)", ImVec2(180, 0))) {
-        exit_requested_ = true;
+        exit_requested_.store(true, std::memory_order_relaxed);
     }
     
     ImGui::End();
@@ -0,0 +1,120 @@
+#include "panels/DisassemblyPanel.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace GBDebug {
+
+DisassemblyPanel::DisassemblyPanel(const BreakpointManager& breakpoints)
+    : breakpoints_(breakpoints)
+    , memory_(nullptr)
+    , pc_(0)
+    , bank_(1)
+    , followPC_(true)
+    , viewAddress_(0)
+    , scrollPending_(true)
+    , visible_(true) {
+    gotoInput_[0] = '\0';
+}
+
+void DisassemblyPanel::Update(const uint8_t* memory, uint16_t pc) {
+    memory_ = memory;
+    if (pc != pc_) {
+        pc_ = pc;
+        scrollPending_ = followPC_;
+    }
+}
+
+void DisassemblyPanel::RenderRow(uint16_t address) {
+    const DisassembledInstruction& insn = disassembler_.Get(memory_, address, bank_);
+    
+    char bytes[12];
+    switch (insn.length) {
+        case 1:  std::snprintf(bytes, sizeof(bytes), "%02X", insn.bytes[0]); break;
+        case 2:  std::snprintf(bytes, sizeof(bytes), "%02X %02X", insn.bytes[0], insn.bytes[1]); break;
+        default: std::snprintf(bytes, sizeof(bytes), "%02X %02X %02X", insn.bytes[0], insn.bytes[1], insn.bytes[2]); break;
+    }
+    
+    char line[64];
+    char marker = breakpoints_.MayBreak(address) ? '*' : ' ';
+    char current = address == pc_ ? '>' : ' ';
+    if (address >= 0x4000 && address <= 0x7FFF) {
+        std::snprintf(line, sizeof(line), "%c%c%02X:%04X  %-9s %s", marker, current, bank_, address, bytes, insn.text);
+    } else {
+        std::snprintf(line, sizeof(line), "%c%c   %04X  %-9s %s", marker, current, address, bytes, insn.text);
+    }
+    
+    if (address == pc_) {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.4f, 1.0f), "%s", line);
+    } else if (marker == '*') {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", line);
+    } else {
+        ImGui::TextUnformatted(line);
+    }
+}
+
+void DisassemblyPanel::Render() {
+    if (!visible_) {
+        return;
+    }
+    
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(790, 260), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 400), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin(GetName());
+    
+    if (ImGui::Checkbox("Follow PC", &followPC_) && followPC_) {
+        scrollPending_ = true;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(60);
+    if (ImGui::InputText("Go to", gotoInput_, sizeof(gotoInput_),
+                         ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue)) {
+        unsigned long address = std::strtoul(gotoInput_, nullptr, 16);
+        if (address <= 0xFFFF) {
+            viewAddress_ = static_cast<uint16_t>(address);
+            followPC_ = false;
+            scrollPending_ = true;
+        }
+    }
+    
+    if (memory_ == nullptr) {
+        ImGui::TextDisabled("No memory data");
+        ImGui::End();
+        return;
+    }
+    
+    uint16_t focus = followPC_ ? pc_ : viewAddress_;
+    const std::vector<uint16_t>& lines = disassembler_.GetLines(memory_, focus, bank_);
+    int focusRow = static_cast<int>(std::lower_bound(lines.begin(), lines.end(), focus) - lines.begin());
+    
+    ImGui::BeginChild("##disassembly", ImVec2(0, 0), true);
+    
+    float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+    if (scrollPending_) {
+        // Only scroll when the focus row is near or past the visible edge
+        float viewHeight = ImGui::GetContentRegionAvail().y;
+        float rowTop = focusRow * lineHeight;
+        float scroll = ImGui::GetScrollY();
+        if (rowTop < scroll + lineHeight || rowTop > scroll + viewHeight - 2 * lineHeight) {
+            ImGui::SetScrollY(std::max(0.0f, rowTop - viewHeight * 0.3f));
+        }
+        scrollPending_ = false;
+    }
+    
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(lines.size()), lineHeight);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            RenderRow(lines[row]);
+        }
+    }
+    clipper.End();
+    
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+} // namespace GBDebug
@@ -0,0 +1,96 @@
+#include "panels/HistoryPanel.h"
+#include "imgui.h"
+#include <cstdio>
+
+namespace GBDebug {
+
+HistoryPanel::HistoryPanel(const StateHistory& history)
+    : history_(history)
+    , selectedStep_(0)
+    , seekRequested_(false)
+    , seekCycle_(0)
+    , visible_(true) {
+}
+
+bool HistoryPanel::ConsumeSeekRequest(uint64_t& cycle) {
+    if (!seekRequested_) {
+        return false;
+    }
+    seekRequested_ = false;
+    cycle = seekCycle_;
+    return true;
+}
+
+void HistoryPanel::RequestStep(int step) {
+    int count = static_cast<int>(history_.GetStepCount());
+    if (step < 0 || step >= count) {
+        return;
+    }
+    selectedStep_ = step;
+    seekCycle_ = history_.GetStepCycle(step);
+    seekRequested_ = true;
+}
+
+void HistoryPanel::Render() {
+    if (!visible_) {
+        return;
+    }
+    
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(10, 730), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(770, 130), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin(GetName());
+    
+    if (!history_.IsEnabled()) {
+        ImGui::TextDisabled("History is off (see SetHistoryBudget)");
+        ImGui::End();
+        return;
+    }
+    
+    int count = static_cast<int>(history_.GetStepCount());
+    ImGui::Text("Steps: %d  Keyframes: %zu  Cycles %llu - %llu", count, history_.GetKeyframeCount(),
+                static_cast<unsigned long long>(history_.GetOldestCycle()),
+                static_cast<unsigned long long>(history_.GetNewestCycle()));
+    
+    char usage[48];
+    std::snprintf(usage, sizeof(usage), "%.1f / %.1f MB",
+                  history_.GetBytesUsed() / (1024.0 * 1024.0), history_.GetBudget() / (1024.0 * 1024.0));
+    ImGui::ProgressBar(static_cast<float>(history_.GetBytesUsed()) / history_.GetBudget(),
+                       ImVec2(-1, 0), usage);
+    
+    if (count == 0) {
+        ImGui::TextDisabled("Nothing captured yet");
+        ImGui::End();
+        return;
+    }
+    
+    // Eviction shifts step positions; keep the slider in range
+    if (selectedStep_ >= count) {
+        selectedStep_ = count - 1;
+    }
+    
+    if (ImGui::Button("<")) {
+        RequestStep(selectedStep_ - 1);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button(">")) {
+        RequestStep(selectedStep_ + 1);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Newest")) {
+        RequestStep(count - 1);
+    }
+    ImGui::SameLine();
+    
+    int step = selectedStep_;
+    ImGui::SetNextItemWidth(-1);
+    if (ImGui::SliderInt("##step", &step, 0, count - 1, "Step %d") && step != selectedStep_) {
+        RequestStep(step);
+    }
+    ImGui::Text("Selected cycle: %llu", static_cast<unsigned long long>(history_.GetStepCycle(selectedStep_)));
+    
+    ImGui::End();
+}
+
+} // namespace GBDebug
@@ -2,11 +2,92 @@
 #include "imgui.h"
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
 
 namespace GBDebug {
 
+namespace {
+
+constexpr int BYTES_PER_ROW = 16;
+constexpr int ROW_PREFIX_CHARS = 7;   // "XXXX:  "
+
+/**
+ * Byte-to-hex lookup: entry b holds the two uppercase hex digits of b
+ */
+struct HexByteTable {
+    char digits[256][2];
+    
+    HexByteTable() {
+        static const char HEX_CHARS[] = "0123456789ABCDEF";
+        for (int b = 0; b < 256; b++) {
+            digits[b][0] = HEX_CHARS[b >> 4];
+            digits[b][1] = HEX_CHARS[b & 0x0F];
+        }
+    }
+};
+
+const HexByteTable HEX_TABLE;
+
+/**
+ * Format "XXXX:  HH HH ... HH  | ascii" into out (at least 80 bytes)
+ * @return Pointer to the terminating null
+ */
+char* FormatHexRow(char* out, uint32_t addr, const uint8_t* bytes, int count) {
+    char* p = out;
+    
+    const char* hi = HEX_TABLE.digits[(addr >> 8) & 0xFF];
+    const char* lo = HEX_TABLE.digits[addr & 0xFF];
+    *p++ = hi[0]; *p++ = hi[1]; *p++ = lo[0]; *p++ = lo[1];
+    *p++ = ':'; *p++ = ' '; *p++ = ' ';
+    
+    for (int i = 0; i < BYTES_PER_ROW; i++) {
+        if (i < count) {
+            const char* hex = HEX_TABLE.digits[bytes[i]];
+            *p++ = hex[0];
+            *p++ = hex[1];
+        } else {
+            // Pad with spaces if row is incomplete
+            *p++ = ' ';
+            *p++ = ' ';
+        }
+        *p++ = ' ';
+    }
+    
+    *p++ = ' '; *p++ = '|'; *p++ = ' ';
+    for (int i = 0; i < count; i++) {
+        uint8_t byte = bytes[i];
+        *p++ = (byte >= 32 && byte <= 126) ? static_cast<char>(byte) : '.';
+    }
+    *p = '\0';
+    return p;
+}
+
+const MemoryRegion* FindMemoryRegion(uint32_t addr) {
+    for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+        if (addr >= MEMORY_REGIONS[i].start && addr <= MEMORY_REGIONS[i].end) {
+            return &MEMORY_REGIONS[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
 MemoryViewerPanel::MemoryViewerPanel()
-    : visible_(true) {
+    : memory_(nullptr)
+    , generation_(0)
+    , frozenGeneration_(0)
+    , visible_(true)
+    , continuousView_(false)
+    , pendingJumpRow_(-1)
+    , highlightAddress_(-1)
+    , heatmapEnabled_(false)
+    , heatmapGeneration_(0)
+    , heatmapFadeFrames_(60)
+    , searchMode_(static_cast<int>(SearchMode::Bytes))
+    , narrowValue_(0) {
+    jumpInput_[0] = '\0';
+    searchInput_[0] = '\0';
 }
 
 bool MemoryViewerPanel::Update(const uint8_t* buffer, size_t size) {
@@ -16,9 +97,62 @@ bool MemoryViewerPanel::Update(const uint8_t* buffer, size_t size) {
     
     std::memcpy(state_.buffer.data(), buffer, size);
     state_.is_valid = true;
+    memory_ = state_.buffer.data();
+    generation_++;
     return true;
 }
 
+bool MemoryViewerPanel::UpdateRange(uint16_t address, const uint8_t* data, size_t length) {
+    if (data == nullptr || address + length > state_.buffer.size()) {
+        return false;
+    }
+    
+    Release();
+    std::memcpy(state_.buffer.data() + address, data, length);
+    state_.is_valid = true;
+    memory_ = state_.buffer.data();
+    generation_++;
+    return true;
+}
+
+bool MemoryViewerPanel::Borrow(const uint8_t* buffer, size_t size, uint64_t generation) {
+    if (buffer == nullptr || size != 65536) {
+        return false;
+    }
+    
+    memory_ = buffer;
+    generation_ = generation;
+    return true;
+}
+
+void MemoryViewerPanel::Release() {
+    if (!IsBorrowed()) {
+        return;
+    }
+    
+    // The emulator may free its buffer after this, so keep the last contents
+    std::memcpy(state_.buffer.data(), memory_, state_.buffer.size());
+    state_.is_valid = true;
+    memory_ = state_.buffer.data();
+}
+
+void MemoryViewerPanel::HighlightAddress(uint16_t address) {
+    continuousView_ = true;
+    highlightAddress_ = address;
+    pendingJumpRow_ = address / BYTES_PER_ROW;
+}
+
+void MemoryViewerPanel::SetHeatmapEnabled(bool enabled) {
+    if (enabled && !heatmapEnabled_) {
+        heatmap_.Reset();
+        if (memory_ != nullptr) {
+            heatmap_.Observe(memory_);
+            heatmapGeneration_ = generation_;
+        }
+    }
+    heatmapEnabled_ = enabled;
+}
+
 void MemoryViewerPanel::RenderMemoryRegion(const MemoryRegion& region) {
     // Special handling for I/O Registers region
     if (region.start == 0xFF00 && region.end == 0xFF7F) {
@@ -26,38 +160,322 @@ void MemoryViewerPanel::RenderMemoryRegion(const MemoryRegion& region) {
         return;
     }
     
-    // Iterate through memory region, 16 bytes per row
-    for (uint32_t addr = region.start; addr <= region.end; addr += 16) {
-        // Calculate end of this row (don't go past region end)
-        uint32_t row_end = (addr + 15 > region.end) ? region.end : addr + 15;
-        int bytes_in_row = row_end - addr + 1;
-        
-        // Address
-        ImGui::Text("%04X: ", addr);
+    // Only rows inside the visible scroll area are formatted and submitted
+    uint32_t regionSize = static_cast<uint32_t>(region.end) - region.start + 1;
+    int rowCount = static_cast<int>((regionSize + BYTES_PER_ROW - 1) / BYTES_PER_ROW);
+    
+    ImGuiListClipper clipper;
+    clipper.Begin(rowCount);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            uint32_t addr = region.start + static_cast<uint32_t>(row) * BYTES_PER_ROW;
+            
+            // Calculate end of this row (don't go past region end)
+            uint32_t row_end = (addr + 15 > region.end) ? region.end : addr + 15;
+            RenderHexRow(addr, static_cast<int>(row_end - addr + 1));
+        }
+    }
+    clipper.End();
+}
+
+void MemoryViewerPanel::RenderHexRow(uint32_t addr, int count) {
+    char line[80];
+    const uint8_t* bytes = memory_ + addr;
+    char* end = FormatHexRow(line, addr, bytes, count);
+    
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    float charWidth = ImGui::CalcTextSize("0").x;
+    
+    // Color bytes by write age; quiet pages are skipped without a byte lookup
+    if (heatmapEnabled_ &&
+        heatmap_.GetPageAge(static_cast<uint8_t>(addr >> 8)) <= static_cast<uint32_t>(heatmapFadeFrames_)) {
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        for (int i = 0; i < count; i++) {
+            uint32_t age = heatmap_.GetAge(static_cast<uint16_t>(addr + i));
+            if (age > static_cast<uint32_t>(heatmapFadeFrames_)) {
+                continue;
+            }
+            ImU32 color = age == 0 ? IM_COL32(230, 50, 30, 200) :
+                IM_COL32(230, 150, 40, 40 + 120 * (heatmapFadeFrames_ - age) / heatmapFadeFrames_);
+            float x = pos.x + charWidth * (ROW_PREFIX_CHARS + i * 3);
+            drawList->AddRectFilled(
+                ImVec2(x - 1, pos.y),
+                ImVec2(x + charWidth * 2 + 1, pos.y + ImGui::GetTextLineHeight()),
+                color
+            );
+        }
+    }
+    
+    // Mark bytes that differ from the frozen snapshot
+    if (frozen_.is_valid) {
+        const uint8_t* frozen = frozen_.buffer.data() + addr;
+        if (std::memcmp(bytes, frozen, count) != 0) {
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            for (int i = 0; i < count; i++) {
+                if (bytes[i] != frozen[i]) {
+                    float x = pos.x + charWidth * (ROW_PREFIX_CHARS + i * 3);
+                    drawList->AddRectFilled(
+                        ImVec2(x - 1, pos.y),
+                        ImVec2(x + charWidth * 2 + 1, pos.y + ImGui::GetTextLineHeight()),
+                        IM_COL32(200, 60, 60, 140)
+                    );
+                }
+            }
+        }
+    }
+    
+    // Highlight the jump target byte behind the text
+    if (highlightAddress_ >= static_cast<int>(addr) &&
+        highlightAddress_ < static_cast<int>(addr) + count) {
+        float x = pos.x + charWidth * (ROW_PREFIX_CHARS + (highlightAddress_ - static_cast<int>(addr)) * 3);
+        ImGui::GetWindowDrawList()->AddRectFilled(
+            ImVec2(x - 1, pos.y),
+            ImVec2(x + charWidth * 2 + 1, pos.y + ImGui::GetTextLineHeight()),
+            IM_COL32(200, 150, 50, 160)
+        );
+    }
+    
+    ImGui::TextUnformatted(line, end);
+}
+
+void MemoryViewerPanel::RenderContinuousView() {
+    // Jump-to-address field
+    ImGui::Text("Go to:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(60);
+    if (ImGui::InputText("##jump", jumpInput_, sizeof(jumpInput_),
+                         ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue)) {
+        unsigned long target = std::strtoul(jumpInput_, nullptr, 16);
+        if (jumpInput_[0] != '\0' && target <= 0xFFFF) {
+            pendingJumpRow_ = static_cast<int>(target / BYTES_PER_ROW);
+            highlightAddress_ = static_cast<int>(target);
+        }
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("(hex, Enter)");
+    
+    ImGui::BeginChild("HexView", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    
+    float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    if (pendingJumpRow_ >= 0) {
+        ImGui::SetScrollY(pendingJumpRow_ * rowHeight);
+        pendingJumpRow_ = -1;
+    }
+    
+    // 4096 rows cover the full address space; only visible ones are built
+    ImGuiListClipper clipper;
+    clipper.Begin(65536 / BYTES_PER_ROW, rowHeight);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            uint32_t addr = static_cast<uint32_t>(row) * BYTES_PER_ROW;
+            
+            // Color rows by memory region
+            const MemoryRegion* region = FindMemoryRegion(addr);
+            if (region != nullptr) {
+                ImGui::PushStyleColor(ImGuiCol_Text,
+                    ImVec4(region->color.r, region->color.g, region->color.b, region->color.a));
+            }
+            RenderHexRow(addr, BYTES_PER_ROW);
+            if (region != nullptr) {
+                ImGui::PopStyleColor();
+            }
+        }
+    }
+    clipper.End();
+    
+    ImGui::EndChild();
+}
+
+void MemoryViewerPanel::RenderSnapshotControls() {
+    if (!frozen_.is_valid) {
+        if (ImGui::Button("Freeze")) {
+            // The only full copy made while memory is borrowed
+            std::memcpy(frozen_.buffer.data(), memory_, frozen_.buffer.size());
+            frozen_.is_valid = true;
+            frozenGeneration_ = generation_;
+        }
         ImGui::SameLine();
+        ImGui::TextDisabled("(snapshot memory to compare against)");
+    } else {
+        if (ImGui::Button("Unfreeze")) {
+            frozen_.is_valid = false;
+        }
+        ImGui::SameLine();
+        ImGui::Text("Frozen at generation %llu, changed bytes highlighted",
+                    static_cast<unsigned long long>(frozenGeneration_));
+    }
+}
+
+void MemoryViewerPanel::RenderHeatmapControls() {
+    bool enabled = heatmapEnabled_;
+    if (ImGui::Checkbox("Heatmap", &enabled)) {
+        SetHeatmapEnabled(enabled);
+    }
+    if (!heatmapEnabled_) {
+        return;
+    }
+    
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120);
+    ImGui::SliderInt("##fade", &heatmapFadeFrames_, 1, 600, "Fade %d frames");
+    ImGui::SameLine();
+    ImGui::TextColored(ImVec4(0.9f, 0.2f, 0.1f, 1.0f), "this frame");
+    ImGui::SameLine();
+    ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.15f, 1.0f), "recent");
+    RenderHeatmapSummary();
+}
+
+void MemoryViewerPanel::RenderHeatmapSummary() {
+    if (!ImGui::CollapsingHeader("Change summary")) {
+        return;
+    }
+    
+    ImGui::Text("Frames observed: %u", heatmap_.GetFrame());
+    for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
+        if (heatmap_.GetRegionRate(i) == 0.0) {
+            continue;
+        }
         
-        // Hex and ASCII representation
-        char hex_line[64] = {0};
-        char ascii_line[17] = {0};
-        
-        for (int i = 0; i < 16; i++) {
-            if (i < bytes_in_row) {
-                uint16_t byte_addr = addr + i;
-                uint8_t byte = state_.Read(byte_addr);
-                
-                snprintf(hex_line + (i * 3), 4, "%02X ", byte);
-                ascii_line[i] = (byte >= 32 && byte <= 126) ? byte : '.';
-            } else {
-                // Pad with spaces if row is incomplete
-                snprintf(hex_line + (i * 3), 4, "   ");
-                ascii_line[i] = ' ';
+        // Name the CGB WRAM bank mapped at $D000 (SVBK, 0 selects bank 1)
+        const MemoryRegion& region = MEMORY_REGIONS[i];
+        if (region.start == 0xD000) {
+            int bank = memory_[0xFF70] & 0x07;
+            ImGui::Text("WRAM bank %d: %u bytes changed last frame, %.1f/frame",
+                        bank == 0 ? 1 : bank, heatmap_.GetRegionChanges(i), heatmap_.GetRegionRate(i));
+        } else {
+            ImGui::Text("%s: %u bytes changed last frame, %.1f/frame",
+                        region.name, heatmap_.GetRegionChanges(i), heatmap_.GetRegionRate(i));
+        }
+    }
+    
+    heatmap_.GetHottest(hottest_, 8);
+    if (!hottest_.empty()) {
+        ImGui::Text("Hottest bytes:");
+        for (uint16_t address : hottest_) {
+            ImGui::SameLine();
+            ImGui::Text("$%04X (%u)", address, heatmap_.GetChangeCount(address));
+        }
+    }
+}
+
+void MemoryViewerPanel::RenderAddressList(const char* id, const std::vector<uint16_t>& addresses) {
+    float height = ImGui::GetTextLineHeightWithSpacing() * 6;
+    ImGui::BeginChild(id, ImVec2(0, height), true);
+    
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(addresses.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            uint16_t address = addresses[row];
+            char label[32];
+            std::snprintf(label, sizeof(label), "$%04X  %02X##%d", address, memory_[address], row);
+            if (ImGui::Selectable(label, highlightAddress_ == address)) {
+                HighlightAddress(address);
             }
         }
-        ascii_line[bytes_in_row] = '\0';
-        
-        ImGui::Text("%s", hex_line);
+    }
+    clipper.End();
+    
+    ImGui::EndChild();
+}
+
+void MemoryViewerPanel::RenderSearch() {
+    if (!ImGui::CollapsingHeader("Search")) {
+        return;
+    }
+    
+    static const char* const MODE_NAMES[] = {"Bytes", "8-bit", "16-bit", "Text"};
+    for (int mode = 0; mode < 4; mode++) {
+        if (mode > 0) {
+            ImGui::SameLine();
+        }
+        ImGui::RadioButton(MODE_NAMES[mode], &searchMode_, mode);
+    }
+    
+    ImGui::SetNextItemWidth(200);
+    bool submitted = ImGui::InputText("##search", searchInput_, sizeof(searchInput_),
+                                      ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    if (ImGui::Button("Find") || submitted) {
+        if (search_.SetPattern(static_cast<SearchMode>(searchMode_), searchInput_, searchError_)) {
+            search_.Find(memory_, searchResults_);
+        } else {
+            searchResults_.clear();
+        }
+    }
+    
+    if (!searchError_.empty()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", searchError_.c_str());
+    } else if (search_.GetPatternLength() > 0) {
+        ImGui::Text("%zu matches", searchResults_.size());
+        RenderAddressList("##results", searchResults_);
+    } else {
+        ImGui::TextDisabled("Bytes: 3E ?? EA   8/16-bit: 200, $C8, 0x1234");
+    }
+    
+    RenderNarrowing();
+}
+
+void MemoryViewerPanel::RenderNarrowing() {
+    ImGui::Text("Narrow:");
+    ImGui::SameLine();
+    if (ImGui::Button("Start")) {
+        search_.StartNarrowing(memory_);
+        candidates_.clear();
+    }
+    if (!search_.IsNarrowing()) {
+        return;
+    }
+    
+    struct NarrowButton {
+        const char* label;
+        NarrowMode mode;
+    };
+    static const NarrowButton BUTTONS[] = {
+        {"Unchanged", NarrowMode::Unchanged},
+        {"Changed", NarrowMode::Changed},
+        {"Increased", NarrowMode::Increased},
+        {"Decreased", NarrowMode::Decreased}
+    };
+    
+    bool narrowed = false;
+    for (const NarrowButton& button : BUTTONS) {
         ImGui::SameLine();
-        ImGui::Text(" | %s", ascii_line);
+        if (ImGui::Button(button.label)) {
+            search_.Narrow(memory_, button.mode);
+            narrowed = true;
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        search_.ResetNarrowing();
+        candidates_.clear();
+        return;
+    }
+    
+    ImGui::SetNextItemWidth(100);
+    ImGui::InputInt("##narrowValue", &narrowValue_);
+    if (narrowValue_ < 0) {
+        narrowValue_ = 0;
+    } else if (narrowValue_ > 0xFF) {
+        narrowValue_ = 0xFF;
+    }
+    ImGui::SameLine();
+    ImGui::Text("($%02X)", narrowValue_);
+    ImGui::SameLine();
+    if (ImGui::Button("Equals value")) {
+        search_.NarrowToValue(memory_, static_cast<uint8_t>(narrowValue_));
+        narrowed = true;
+    }
+    
+    // Listing all 64K candidates is pointless; show them once few are left
+    const size_t LIST_LIMIT = 4096;
+    if (narrowed) {
+        search_.GetCandidates(candidates_, LIST_LIMIT);
+    }
+    ImGui::Text("%zu candidates", search_.GetCandidateCount());
+    if (search_.GetCandidateCount() <= LIST_LIMIT) {
+        RenderAddressList("##candidates", candidates_);
     }
 }
 
@@ -66,7 +484,7 @@ void MemoryViewerPanel::RenderIORegisters() {
     auto renderRegister = [this](const IORegister& reg) {
         if (reg.start == reg.end) {
             // Single register
-            uint8_t value = state_.Read(reg.start);
+            uint8_t value = memory_[reg.start];
             ImGui::Text("$%04X  %02X  %-12s %s", 
                        reg.start, value, reg.name, reg.description);
         } else {
@@ -82,65 +500,52 @@ void MemoryViewerPanel::RenderIORegisters() {
                 ImGui::Text("%04X: ", addr);
                 ImGui::SameLine();
                 
-                char hex_line[64] = {0};
-                int pos = 0;
+                char hex_line[64];
+                char* p = hex_line;
                 for (uint16_t a = addr; a <= row_end; a++) {
-                    uint8_t byte = state_.Read(a);
-                    pos += snprintf(hex_line + pos, 4, "%02X ", byte);
+                    const char* hex = HEX_TABLE.digits[memory_[a]];
+                    *p++ = hex[0];
+                    *p++ = hex[1];
+                    *p++ = ' ';
                 }
-                ImGui::Text("%s", hex_line);
+                ImGui::TextUnformatted(hex_line, p);
             }
             ImGui::Unindent(20.0f);
         }
     };
     
-    // Render non-sound registers first (before $FF10)
-    for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
-        const IORegister& reg = IO_REGISTERS[i];
-        if (reg.start < 0xFF10) {
-            renderRegister(reg);
+    auto renderRange = [&renderRegister](const IORegisterRange& range) {
+        for (size_t i = range.first; i < range.end; i++) {
+            renderRegister(IO_REGISTERS[i]);
         }
-    }
+    };
+    
+    // Render non-sound registers first (before $FF10)
+    renderRange(IO_RANGE_GENERAL);
     
     // Sound registers in collapsible section ($FF10-$FF3F)
     if (ImGui::CollapsingHeader("Sound Registers ($FF10-$FF3F)")) {
         ImGui::Indent(10.0f);
-        for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
-            const IORegister& reg = IO_REGISTERS[i];
-            if (reg.start >= 0xFF10 && reg.end <= 0xFF3F) {
-                renderRegister(reg);
-            }
-        }
+        renderRange(IO_RANGE_SOUND);
         ImGui::Unindent(10.0f);
     }
     
     // PPU registers in collapsible section ($FF40-$FF4B)
     if (ImGui::CollapsingHeader("PPU Registers ($FF40-$FF4B)")) {
         ImGui::Indent(10.0f);
-        for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
-            const IORegister& reg = IO_REGISTERS[i];
-            if (reg.start >= 0xFF40 && reg.end <= 0xFF4B) {
-                renderRegister(reg);
-            }
-        }
+        renderRange(IO_RANGE_PPU);
         ImGui::Unindent(10.0f);
     }
     
     // Render remaining registers (after $FF4B, excluding sound and PPU)
-    for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
-        const IORegister& reg = IO_REGISTERS[i];
-        if (reg.start > 0xFF4B) {
-            renderRegister(reg);
-        }
-    }
+    renderRange(IO_RANGE_CGB);
     
     // Show unmapped/unused addresses in the I/O range (collapsed by default)
     if (ImGui::CollapsingHeader("Unmapped I/O Addresses")) {
         ImGui::Indent(10.0f);
         for (uint16_t addr = 0xFF00; addr <= 0xFF7F; addr++) {
-            const IORegister* reg = FindIORegister(addr);
-            if (reg == nullptr) {
-                uint8_t value = state_.Read(addr);
+            if (IO_REGISTER_LOOKUP.index[addr - 0xFF00] < 0) {
+                uint8_t value = memory_[addr];
                 ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), 
                                   "$%04X  %02X  (unmapped)", addr, value);
             }
@@ -160,12 +565,38 @@ void MemoryViewerPanel::Render() {
     
     ImGui::Begin(GetName(), nullptr, ImGuiWindowFlags_HorizontalScrollbar);
     
-    if (!state_.is_valid) {
+    if (memory_ == nullptr) {
         ImGui::Text("No memory data available");
         ImGui::End();
         return;
     }
     
+    // View selector: collapsible regions or one continuous 64KB view
+    if (ImGui::RadioButton("Regions", !continuousView_)) {
+        continuousView_ = false;
+    }
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Continuous", continuousView_)) {
+        continuousView_ = true;
+    }
+    ImGui::SameLine();
+    RenderSnapshotControls();
+    
+    // One heatmap frame per new memory generation
+    if (heatmapEnabled_ && generation_ != heatmapGeneration_) {
+        heatmap_.Observe(memory_);
+        heatmapGeneration_ = generation_;
+    }
+    RenderHeatmapControls();
+    RenderSearch();
+    ImGui::Separator();
+    
+    if (continuousView_) {
+        RenderContinuousView();
+        ImGui::End();
+        return;
+    }
+    
     // Render each memory region as a collapsible section (default collapsed)
     for (size_t i = 0; i < MEMORY_REGIONS_COUNT; i++) {
         const MemoryRegion& region = MEMORY_REGIONS[i];
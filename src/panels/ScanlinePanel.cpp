@@ -0,0 +1,111 @@
+#include "panels/ScanlinePanel.h"
+#include "imgui.h"
+#include <cstdio>
+
+namespace GBDebug {
+
+ScanlinePanel::ScanlinePanel(const ScanlineTimeline& timeline)
+    : timeline_(timeline)
+    , shownGeneration_(UINT64_MAX)
+    , visible_(true) {
+    // Scroll and window position are the usual raster-effect registers
+    plotted_.fill(false);
+    plotted_[2] = true;   // SCY
+    plotted_[3] = true;   // SCX
+    plotted_[7] = true;   // WY
+    plotted_[8] = true;   // WX
+}
+
+void ScanlinePanel::RefreshValues() {
+    shownGeneration_ = timeline_.GetGeneration();
+    const ScanlineTimeline::Frame& frame = timeline_.GetFrame();
+    for (size_t reg = 0; reg < ScanlineTimeline::REGISTER_COUNT; reg++) {
+        for (size_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+            values_[reg][ly] = ScanlineTimeline::GetRegister(frame[ly], reg);
+        }
+    }
+}
+
+void ScanlinePanel::RenderChanges() {
+    ImGui::BeginChild("##changes", ImVec2(0, 0), true);
+
+    const ScanlineTimeline::Frame& frame = timeline_.GetFrame();
+    char text[160];
+    bool any = false;
+    for (size_t ly = 1; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+        int length = std::snprintf(text, sizeof(text), "LY %3zu:", ly);
+        bool changed = false;
+        for (size_t reg = 0; reg < ScanlineTimeline::REGISTER_COUNT; reg++) {
+            // STAT changes mode by itself on every line
+            if (reg == 1) {
+                continue;
+            }
+            uint8_t before = ScanlineTimeline::GetRegister(frame[ly - 1], reg);
+            uint8_t after = ScanlineTimeline::GetRegister(frame[ly], reg);
+            if (before != after && length < static_cast<int>(sizeof(text))) {
+                length += std::snprintf(text + length, sizeof(text) - length, " %s %02X->%02X",
+                                        ScanlineTimeline::GetRegisterName(reg), before, after);
+                changed = true;
+            }
+        }
+        if (changed) {
+            ImGui::TextUnformatted(text);
+            any = true;
+        }
+    }
+    if (!any) {
+        ImGui::TextDisabled("No mid-frame register changes");
+    }
+
+    ImGui::EndChild();
+}
+
+void ScanlinePanel::Render() {
+    if (!visible_) {
+        return;
+    }
+
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(790, 670), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 480), ImGuiCond_FirstUseEver);
+
+    ImGui::Begin(GetName());
+
+    if (!timeline_.HasFrame()) {
+        ImGui::TextDisabled("No scanlines recorded (see RecordScanlineRegisters)");
+        ImGui::End();
+        return;
+    }
+
+    if (timeline_.GetGeneration() != shownGeneration_) {
+        RefreshValues();
+    }
+
+    for (size_t reg = 0; reg < ScanlineTimeline::REGISTER_COUNT; reg++) {
+        if (reg % 5 != 0) {
+            ImGui::SameLine();
+        }
+        bool plotted = plotted_[reg];
+        if (ImGui::Checkbox(ScanlineTimeline::GetRegisterName(reg), &plotted)) {
+            plotted_[reg] = plotted;
+        }
+    }
+    ImGui::TextUnformatted(timeline_.IsUniform() ? "Same registers on every line" : "Registers change mid-frame");
+
+    // Values are plotted on a fixed 0-255 scale so graphs line up
+    for (size_t reg = 0; reg < ScanlineTimeline::REGISTER_COUNT; reg++) {
+        if (!plotted_[reg]) {
+            continue;
+        }
+        char label[16];
+        std::snprintf(label, sizeof(label), "##plot%zu", reg);
+        ImGui::PlotLines(label, values_[reg].data(), static_cast<int>(ScanlineTimeline::LINE_COUNT), 0,
+                         ScanlineTimeline::GetRegisterName(reg), 0.0f, 255.0f, ImVec2(-1, 50));
+    }
+
+    RenderChanges();
+
+    ImGui::End();
+}
+
+} // namespace GBDebug
@@ -0,0 +1,184 @@
+#include "panels/ScreenPanel.h"
+#include "imgui.h"
+#include <cstdio>
+#include <cstring>
+
+namespace GBDebug {
+
+namespace {
+
+constexpr int TILE_COLS = FrameCompositor::WIDTH / 8;
+constexpr int TILE_ROWS = FrameCompositor::HEIGHT / 8;
+
+const TileColor MISMATCH_COLOR(255, 0, 255);
+
+} // namespace
+
+ScreenPanel::ScreenPanel()
+    : rgba_(FrameCompositor::PIXEL_COUNT * 4, 0)
+    , hasReference_(false)
+    , referenceChanged_(false)
+    , imagesDirty_(false)
+    , composed_(false)
+    , composedGeneration_(0)
+    , showDiff_(true)
+    , visible_(true) {
+    reference_.fill(0);
+}
+
+void ScreenPanel::SetReference(const uint16_t* pixels) {
+    if (pixels == nullptr) {
+        return;
+    }
+    std::memcpy(reference_.data(), pixels, sizeof(reference_));
+    hasReference_ = true;
+    referenceChanged_ = true;
+}
+
+void ScreenPanel::Update(const uint8_t* memory, const uint8_t* vramBank1,
+                         const CGBPalette* bgPalettes, const CGBPalette* spritePalettes,
+                         EmulationMode mode, const ScanlineTimeline* scanlines, uint64_t generation) {
+    if (!visible_ || memory == nullptr) {
+        return;
+    }
+
+    if (!composed_ || generation != composedGeneration_) {
+        compositor_.Compose(memory, vramBank1, bgPalettes, spritePalettes, mode, scanlines);
+        composed_ = true;
+        composedGeneration_ = generation;
+        referenceChanged_ = true;
+    }
+    if (referenceChanged_) {
+        if (hasReference_) {
+            compositor_.Compare(reference_.data());
+        }
+        referenceChanged_ = false;
+        imagesDirty_ = true;
+    }
+}
+
+void ScreenPanel::ConvertToRGBA(const uint16_t* pixels, bool markMismatches) {
+    const bool cgb = compositor_.IsCGB();
+    const Palette shades = paletteManager_.GetDMGPalette();
+    const std::bitset<FrameCompositor::PIXEL_COUNT>& mismatches = compositor_.GetMismatches();
+
+    uint8_t* out = rgba_.data();
+    for (size_t i = 0; i < FrameCompositor::PIXEL_COUNT; i++, out += 4) {
+        TileColor color;
+        if (markMismatches && mismatches[i]) {
+            color = MISMATCH_COLOR;
+        } else if (cgb) {
+            color = paletteManager_.ConvertCGBColor(pixels[i]);
+        } else {
+            color = shades.colors[pixels[i] & 0x03];
+        }
+        std::memcpy(out, &color, 4);
+    }
+}
+
+void ScreenPanel::RefreshImages() {
+    ConvertToRGBA(compositor_.GetFrame().data(), false);
+    screenAtlas_.WriteImage(rgba_.data());
+
+    if (hasReference_) {
+        ConvertToRGBA(reference_.data(), showDiff_);
+        referenceAtlas_.WriteImage(rgba_.data());
+    }
+    imagesDirty_ = false;
+}
+
+void ScreenPanel::RenderPixelTooltip(float originX, float originY, float scale) {
+    ImVec2 mouse = ImGui::GetMousePos();
+    int x = static_cast<int>((mouse.x - originX) / scale);
+    int y = static_cast<int>((mouse.y - originY) / scale);
+    if (x < 0 || x >= FrameCompositor::WIDTH || y < 0 || y >= FrameCompositor::HEIGHT) {
+        return;
+    }
+
+    const char* format = compositor_.IsCGB() ? "%04X" : "%d";
+    char rebuilt[8];
+    std::snprintf(rebuilt, sizeof(rebuilt), format, compositor_.GetPixel(x, y));
+
+    ImGui::BeginTooltip();
+    ImGui::Text("X=%d LY=%d  Sprites on line: %d", x, y, compositor_.GetSpriteCount(y));
+    if (hasReference_) {
+        char emulated[8];
+        std::snprintf(emulated, sizeof(emulated), format, reference_[y * FrameCompositor::WIDTH + x]);
+        ImGui::Text("Rebuilt %s  Emulator %s", rebuilt, emulated);
+    } else {
+        ImGui::Text("Rebuilt %s", rebuilt);
+    }
+    ImGui::EndTooltip();
+}
+
+void ScreenPanel::Render() {
+    if (!visible_) {
+        return;
+    }
+
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(1100, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(680, 400), ImGuiCond_FirstUseEver);
+
+    ImGui::Begin(GetName());
+
+    if (!composed_) {
+        ImGui::Text("No memory data available");
+        ImGui::End();
+        return;
+    }
+
+    bool reinitialized = screenAtlas_.ReinitializeIfNeeded(TILE_COLS, TILE_ROWS);
+    reinitialized |= referenceAtlas_.ReinitializeIfNeeded(TILE_COLS, TILE_ROWS);
+
+    if (hasReference_) {
+        if (ImGui::Checkbox("Mark differences", &showDiff_)) {
+            imagesDirty_ = true;
+        }
+        ImGui::SameLine();
+        size_t mismatches = compositor_.GetMismatchCount();
+        if (mismatches == 0) {
+            ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Frames match");
+        } else {
+            int first = compositor_.GetFirstMismatch();
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%zu pixels differ, first at X=%d LY=%d",
+                               mismatches, first % FrameCompositor::WIDTH, first / FrameCompositor::WIDTH);
+        }
+    } else {
+        ImGui::TextDisabled("No emulator framebuffer to compare (see UpdateFramebuffer)");
+    }
+
+    if (imagesDirty_ || reinitialized) {
+        RefreshImages();
+    }
+    unsigned int screenTexture = screenAtlas_.Upload();
+    unsigned int referenceTexture = referenceAtlas_.Upload();
+
+    const float scale = 2.0f;
+    const ImVec2 size(FrameCompositor::WIDTH * scale, FrameCompositor::HEIGHT * scale);
+
+    ImGui::BeginGroup();
+    ImGui::Text("Rebuilt");
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Image((void*)(intptr_t)screenTexture, size);
+    if (ImGui::IsItemHovered()) {
+        RenderPixelTooltip(origin.x, origin.y, scale);
+    }
+    ImGui::EndGroup();
+
+    if (hasReference_) {
+        ImGui::SameLine();
+        ImGui::BeginGroup();
+        ImGui::Text("Emulator");
+        origin = ImGui::GetCursorScreenPos();
+        ImGui::Image((void*)(intptr_t)referenceTexture, size);
+        if (ImGui::IsItemHovered()) {
+            RenderPixelTooltip(origin.x, origin.y, scale);
+        }
+        ImGui::EndGroup();
+    }
+
+    ImGui::End();
+}
+
+} // namespace GBDebug
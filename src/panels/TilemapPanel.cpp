@@ -0,0 +1,299 @@
+#include "panels/TilemapPanel.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace GBDebug {
+
+namespace {
+
+constexpr int MAP_PIXELS = 256;
+constexpr int SCREEN_WIDTH = 160;
+constexpr int SCREEN_HEIGHT = 144;
+
+// LCD registers
+constexpr uint16_t LCDC = 0xFF40;
+constexpr uint16_t SCY = 0xFF42;
+constexpr uint16_t SCX = 0xFF43;
+constexpr uint16_t BGP = 0xFF47;
+constexpr uint16_t WY = 0xFF4A;
+constexpr uint16_t WX = 0xFF4B;
+
+} // namespace
+
+TilemapPanel::TilemapPanel()
+    : memory_(nullptr)
+    , lcdc_(0)
+    , scx_(0)
+    , scy_(0)
+    , wx_(0)
+    , wy_(0)
+    , mapSelect_(0)
+    , showViewport_(true)
+    , showGrid_(false)
+    , showPriority_(false)
+    , cgb_(false)
+    , visible_(true) {
+}
+
+bool TilemapPanel::IsHighMapSelected() const {
+    switch (mapSelect_) {
+        case 0:  return (lcdc_ & 0x08) != 0;
+        case 1:  return (lcdc_ & 0x40) != 0;
+        case 2:  return false;
+        default: return true;
+    }
+}
+
+void TilemapPanel::Update(const uint8_t* memory, const uint8_t* vramBank1,
+                          const CGBPalette* bgPalettes, EmulationMode mode,
+                          const ScanlineTimeline* scanlines) {
+    if (!visible_ || memory == nullptr) {
+        return;
+    }
+    
+    memory_ = memory;
+    lcdc_ = memory[LCDC];
+    scx_ = memory[SCX];
+    scy_ = memory[SCY];
+    wx_ = memory[WX];
+    wy_ = memory[WY];
+    cgb_ = mode == EmulationMode::CGB;
+    
+    if (scanlines != nullptr && scanlines->HasFrame()) {
+        const ScanlineTimeline::Frame& frame = scanlines->GetFrame();
+        std::copy(frame.begin(), frame.begin() + lines_.size(), lines_.begin());
+    } else {
+        lines_.fill(ScanlineTimeline::ReadRegisters(memory));
+    }
+    
+    // Resolve the palettes cells are drawn with; DMG shades come from BGP
+    std::array<Palette, 8> palettes;
+    paletteManager_.SetMode(mode);
+    if (cgb_) {
+        paletteManager_.SetBGPalettes(bgPalettes, 8);
+        for (int i = 0; i < 8; i++) {
+            palettes[i] = paletteManager_.GetBGPalette(i);
+        }
+    } else {
+        Palette shades = paletteManager_.GetDMGPalette();
+        uint8_t bgp = memory[BGP];
+        for (int color = 0; color < 4; color++) {
+            palettes[0].colors[color] = shades.colors[(bgp >> (color * 2)) & 0x03];
+        }
+        for (int i = 1; i < 8; i++) {
+            palettes[i] = palettes[0];
+        }
+    }
+    if (std::memcmp(palettes.data(), palettes_.data(), sizeof(palettes)) != 0) {
+        palettes_ = palettes;
+        composer_.Invalidate();
+    }
+    
+    composer_.Update(memory + 0x8000, cgb_ ? vramBank1 : nullptr, lcdc_, IsHighMapSelected());
+}
+
+void TilemapPanel::ComposeDirtyCells() {
+    if (atlas_.ReinitializeIfNeeded(TilemapComposer::MAP_SIZE, TilemapComposer::MAP_SIZE)) {
+        composer_.Invalidate();
+    }
+    
+    const std::bitset<TilemapComposer::CELL_COUNT>& dirty = composer_.GetDirtyCells();
+    if (dirty.none()) {
+        return;
+    }
+    
+    TilemapComposer::CellPixels pixels;
+    for (int cell = 0; cell < TilemapComposer::CELL_COUNT; cell++) {
+        if (dirty[cell]) {
+            composer_.DecodeCell(cell, pixels);
+            atlas_.WriteTile(cell, pixels, palettes_[composer_.GetCell(cell).palette]);
+        }
+    }
+    composer_.ClearDirty();
+}
+
+void TilemapPanel::DrawWrappedRect(float originX, float originY, float scale, int x, int y,
+                                   int width, int height, uint32_t color) {
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    
+    // Split into up to four pieces where the rectangle crosses the map edges
+    int xParts[2][2] = {{x, x + width > MAP_PIXELS ? MAP_PIXELS : x + width}, {0, x + width - MAP_PIXELS}};
+    int yParts[2][2] = {{y, y + height > MAP_PIXELS ? MAP_PIXELS : y + height}, {0, y + height - MAP_PIXELS}};
+    for (int i = 0; i < 2; i++) {
+        if (xParts[i][1] <= xParts[i][0]) {
+            continue;
+        }
+        for (int j = 0; j < 2; j++) {
+            if (yParts[j][1] <= yParts[j][0]) {
+                continue;
+            }
+            drawList->AddRect(
+                ImVec2(originX + xParts[i][0] * scale, originY + yParts[j][0] * scale),
+                ImVec2(originX + xParts[i][1] * scale, originY + yParts[j][1] * scale),
+                color, 0.0f, 0, 2.0f
+            );
+        }
+    }
+}
+
+void TilemapPanel::RenderOverlays(float originX, float originY, float scale) {
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    
+    if (showGrid_) {
+        for (int line = 8; line < MAP_PIXELS; line += 8) {
+            float offset = line * scale;
+            drawList->AddLine(ImVec2(originX + offset, originY),
+                              ImVec2(originX + offset, originY + MAP_PIXELS * scale), IM_COL32(80, 80, 80, 120));
+            drawList->AddLine(ImVec2(originX, originY + offset),
+                              ImVec2(originX + MAP_PIXELS * scale, originY + offset), IM_COL32(80, 80, 80, 120));
+        }
+    }
+    
+    if (showPriority_ && cgb_) {
+        for (int cell = 0; cell < TilemapComposer::CELL_COUNT; cell++) {
+            if (composer_.GetCell(cell).priority) {
+                float x = originX + (cell % TilemapComposer::MAP_SIZE) * 8 * scale;
+                float y = originY + (cell / TilemapComposer::MAP_SIZE) * 8 * scale;
+                drawList->AddRectFilled(ImVec2(x, y), ImVec2(x + 8 * scale, y + 8 * scale),
+                                        IM_COL32(60, 120, 255, 90));
+            }
+        }
+    }
+    
+    if (showViewport_) {
+        RenderViewport(originX, originY, scale);
+    }
+}
+
+void TilemapPanel::RenderViewport(float originX, float originY, float scale) {
+    const bool highMap = IsHighMapSelected();
+    const ImU32 bgColor = IM_COL32(255, 60, 60, 255);
+    const ImU32 windowColor = IM_COL32(60, 220, 90, 255);
+    
+    // Strips: the BG run keeps SCX/SCY, the window run keeps WX and its rows
+    int bgStart = -1;
+    int windowStart = -1;
+    int windowRowStart = 0;
+    int windowRow = 0;           // The window's own line counter
+    for (int ly = 0; ly <= SCREEN_HEIGHT; ly++) {
+        const bool last = ly == SCREEN_HEIGHT;
+        const ScanlineRegisters* line = last ? nullptr : &lines_[ly];
+        const ScanlineRegisters* previous = ly > 0 ? &lines_[ly - 1] : nullptr;
+        
+        // Background: a new strip wherever the scroll or the BG map changes
+        bool bgHere = !last && highMap == ((line->lcdc & 0x08) != 0);
+        bool bgContinues = bgHere && bgStart >= 0 &&
+                           line->scx == previous->scx && line->scy == previous->scy &&
+                           (line->lcdc & 0x08) == (previous->lcdc & 0x08);
+        if (bgStart >= 0 && !bgContinues) {
+            const ScanlineRegisters& first = lines_[bgStart];
+            DrawWrappedRect(originX, originY, scale, first.scx, (first.scy + bgStart) & 0xFF,
+                            SCREEN_WIDTH, ly - bgStart, bgColor);
+            bgStart = -1;
+        }
+        if (bgHere && bgStart < 0) {
+            bgStart = ly;
+        }
+        
+        // Window: drawn from its map's left edge, one map row per line it covers
+        int windowX = last ? SCREEN_WIDTH : line->wx - 7;
+        bool windowHere = !last && (line->lcdc & 0x20) != 0 && ly >= line->wy && windowX < SCREEN_WIDTH;
+        bool windowShown = windowHere && highMap == ((line->lcdc & 0x40) != 0);
+        bool windowContinues = windowShown && windowStart >= 0 &&
+                               line->wx == previous->wx && (line->lcdc & 0x40) == (previous->lcdc & 0x40);
+        if (windowStart >= 0 && !windowContinues) {
+            int startX = lines_[windowStart].wx - 7;
+            DrawWrappedRect(originX, originY, scale, 0, windowRowStart,
+                            SCREEN_WIDTH - (startX > 0 ? startX : 0), windowRow - windowRowStart, windowColor);
+            windowStart = -1;
+        }
+        if (windowShown && windowStart < 0) {
+            windowStart = ly;
+            windowRowStart = windowRow;
+        }
+        if (windowHere) {
+            windowRow++;
+        }
+    }
+}
+
+void TilemapPanel::RenderCellTooltip(float originX, float originY, float scale) {
+    ImVec2 mouse = ImGui::GetMousePos();
+    int cellX = static_cast<int>((mouse.x - originX) / (8 * scale));
+    int cellY = static_cast<int>((mouse.y - originY) / (8 * scale));
+    if (cellX < 0 || cellX >= TilemapComposer::MAP_SIZE || cellY < 0 || cellY >= TilemapComposer::MAP_SIZE) {
+        return;
+    }
+    
+    int cell = cellY * TilemapComposer::MAP_SIZE + cellX;
+    const TilemapCell& resolved = composer_.GetCell(cell);
+    uint16_t mapAddress = static_cast<uint16_t>((IsHighMapSelected() ? 0x9C00 : 0x9800) + cell);
+    
+    ImGui::BeginTooltip();
+    ImGui::Text("Cell %d,%d  $%04X = %02X", cellX, cellY, mapAddress, memory_[mapAddress]);
+    ImGui::Text("Tile %d ($%04X)", resolved.tile, 0x8000 + resolved.tile * 16);
+    if (cgb_) {
+        ImGui::Text("Bank %d  Palette %d%s%s%s", resolved.bank, resolved.palette,
+                    resolved.hFlip ? "  H-flip" : "", resolved.vFlip ? "  V-flip" : "",
+                    resolved.priority ? "  Priority" : "");
+    }
+    ImGui::EndTooltip();
+}
+
+void TilemapPanel::Render() {
+    if (!visible_) {
+        return;
+    }
+    
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(220, 600), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(560, 640), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin(GetName());
+    
+    if (memory_ == nullptr) {
+        ImGui::Text("No memory data available");
+        ImGui::End();
+        return;
+    }
+    
+    // A map change is picked up by the next Update()
+    ImGui::RadioButton("BG", &mapSelect_, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("Window", &mapSelect_, 1);
+    ImGui::SameLine();
+    ImGui::RadioButton("$9800", &mapSelect_, 2);
+    ImGui::SameLine();
+    ImGui::RadioButton("$9C00", &mapSelect_, 3);
+    
+    ImGui::Checkbox("Viewport", &showViewport_);
+    ImGui::SameLine();
+    ImGui::Checkbox("Grid", &showGrid_);
+    if (cgb_) {
+        ImGui::SameLine();
+        ImGui::Checkbox("Priority", &showPriority_);
+    }
+    ImGui::Text("Map $%04X  Tiles $%s  SCX=%d SCY=%d  WX=%d WY=%d",
+                IsHighMapSelected() ? 0x9C00 : 0x9800, (lcdc_ & 0x10) ? "8000" : "8800",
+                scx_, scy_, wx_, wy_);
+    
+    ComposeDirtyCells();
+    unsigned int texture = atlas_.Upload();
+    
+    ImGui::BeginChild("##map", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    const float scale = 2.0f;
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Image((void*)(intptr_t)texture, ImVec2(MAP_PIXELS * scale, MAP_PIXELS * scale));
+    bool hovered = ImGui::IsItemHovered();
+    RenderOverlays(origin.x, origin.y, scale);
+    if (hovered) {
+        RenderCellTooltip(origin.x, origin.y, scale);
+    }
+    ImGui::EndChild();
+    
+    ImGui::End();
+}
+
+} // namespace GBDebug
@@ -0,0 +1,178 @@
+#include "panels/TracePanel.h"
+#include "Disassembler.h"
+#include "imgui.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace GBDebug {
+
+namespace {
+
+/**
+ * Copy the mnemonic (first word) of an opcode's disassembly format
+ */
+void CopyMnemonic(uint8_t opcode, char* out, size_t size) {
+    const char* format = opcode == 0xCB ? "CB" : Disassembler::GetOpcodeInfo(opcode).format;
+    size_t i = 0;
+    while (i + 1 < size && format[i] != '\0' && format[i] != ' ') {
+        out[i] = format[i];
+        i++;
+    }
+    out[i] = '\0';
+}
+
+} // namespace
+
+TracePanel::TracePanel(const TraceBuffer& trace, const TraceFileWriter& file)
+    : trace_(trace)
+    , file_(file)
+    , followTail_(true)
+    , viewTotal_(0)
+    , filterActive_(false)
+    , visible_(true) {
+    pcFromInput_[0] = '\0';
+    pcToInput_[0] = '\0';
+    opcodeInput_[0] = '\0';
+}
+
+void TracePanel::ApplyFilter() {
+    unsigned long from = std::strtoul(pcFromInput_, nullptr, 16);
+    unsigned long to = pcToInput_[0] != '\0' ? std::strtoul(pcToInput_, nullptr, 16) : from;
+    if (pcFromInput_[0] == '\0') {
+        from = 0;
+        to = 0xFFFF;
+    }
+    bool anyOpcode = opcodeInput_[0] == '\0';
+    unsigned long opcode = std::strtoul(opcodeInput_, nullptr, 16);
+    
+    matches_.clear();
+    uint64_t total = trace_.GetTotal();
+    TraceRecord record;
+    for (uint64_t index = trace_.GetOldest(total); index < total; index++) {
+        if (trace_.Read(index, record) && record.pc >= from && record.pc <= to &&
+            (anyOpcode || record.opcode == opcode)) {
+            matches_.push_back(index);
+        }
+    }
+    filterActive_ = true;
+}
+
+void TracePanel::RenderFilter() {
+    ImGui::Text("PC:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(50);
+    ImGui::InputText("##tfrom", pcFromInput_, sizeof(pcFromInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    ImGui::SameLine();
+    ImGui::Text("-");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(50);
+    ImGui::InputText("##tto", pcToInput_, sizeof(pcToInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    ImGui::SameLine();
+    ImGui::Text("Op:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(30);
+    ImGui::InputText("##top", opcodeInput_, sizeof(opcodeInput_), ImGuiInputTextFlags_CharsHexadecimal);
+    
+    ImGui::SameLine();
+    if (ImGui::Button("Filter")) {
+        ApplyFilter();
+    }
+    if (filterActive_) {
+        ImGui::SameLine();
+        if (ImGui::Button("Show all")) {
+            filterActive_ = false;
+            matches_.clear();
+        }
+        ImGui::Text("%zu matching records", matches_.size());
+    }
+}
+
+void TracePanel::RenderRow(uint64_t index) {
+    TraceRecord record;
+    if (!trace_.Read(index, record)) {
+        ImGui::TextDisabled("%10llu (overwritten)", static_cast<unsigned long long>(index));
+        return;
+    }
+    
+    char mnemonic[8];
+    CopyMnemonic(record.opcode, mnemonic, sizeof(mnemonic));
+    
+    char location[12];
+    if (record.pc >= 0x4000 && record.pc <= 0x7FFF) {
+        std::snprintf(location, sizeof(location), "%02X:%04X", record.bank, record.pc);
+    } else {
+        std::snprintf(location, sizeof(location), "   %04X", record.pc);
+    }
+    
+    ImGui::Text("%10llu %08X %s %02X %-5s AF=%04X BC=%04X DE=%04X HL=%04X",
+                static_cast<unsigned long long>(index), record.cycle, location,
+                record.opcode, mnemonic, record.af, record.bc, record.de, record.hl);
+}
+
+void TracePanel::Render() {
+    if (!visible_) {
+        return;
+    }
+    
+    // Set initial window position and size (only on first use)
+    ImGui::SetNextWindowPos(ImVec2(220, 420), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(560, 300), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin(GetName());
+    
+    if (file_.IsOpen()) {
+        ImGui::Text("Streaming to file: %llu records, %.1f MB%s",
+                    static_cast<unsigned long long>(file_.GetRecordsWritten()),
+                    file_.GetBytesWritten() / (1024.0 * 1024.0),
+                    file_.HasError() ? " (write error)" : "");
+    }
+    
+    if (trace_.GetCapacity() == 0) {
+        ImGui::TextDisabled("Tracing is off (see SetTraceCapacity)");
+        ImGui::End();
+        return;
+    }
+    
+    uint64_t total = trace_.GetTotal();
+    if (followTail_ || viewTotal_ > total) {
+        viewTotal_ = total;
+    }
+    uint64_t oldest = trace_.GetOldest(viewTotal_);
+    
+    ImGui::Text("Recorded: %llu  Held: %llu / %zu",
+                static_cast<unsigned long long>(total),
+                static_cast<unsigned long long>(viewTotal_ - oldest), trace_.GetCapacity());
+    ImGui::SameLine();
+    ImGui::Checkbox("Follow", &followTail_);
+    
+    RenderFilter();
+    
+    ImGui::BeginChild("##trace", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    
+    ImGuiListClipper clipper;
+    if (filterActive_) {
+        clipper.Begin(static_cast<int>(matches_.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                RenderRow(matches_[row]);
+            }
+        }
+    } else {
+        clipper.Begin(static_cast<int>(viewTotal_ - oldest));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                RenderRow(oldest + row);
+            }
+        }
+    }
+    clipper.End();
+    
+    if (followTail_ && !filterActive_) {
+        ImGui::SetScrollHereY(1.0f);
+    }
+    
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+} // namespace GBDebug
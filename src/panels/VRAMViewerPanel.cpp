@@ -3,6 +3,7 @@
 #include "TileRenderer.h"
 #include "PaletteManager.h"
 #include "SpriteParser.h"
+#include "SpriteOccupancy.h"
 #include "imgui.h"
 #include <cstring>
 #include <memory>
@@ -13,6 +14,7 @@ namespace GBDebug {
 static constexpr size_t VRAM_BANK_SIZE = 8192;
 static constexpr size_t OAM_SIZE = 160;
 static constexpr size_t MAX_VRAM_BANKS = 2;
+static constexpr size_t TILE_BYTES = 16;
 static constexpr int TILES_PER_ROW = 16;
 static constexpr int DMG_TILE_COUNT = 384;
 static constexpr int CGB_BANK0_TILE_COUNT = 384;
@@ -24,11 +26,22 @@ VRAMViewerPanel::VRAMViewerPanel()
     : decoder_(new TileDecoder()),
       renderer_(new TileRenderer()),
       paletteManager_(new PaletteManager()),
+      occupancy_(new SpriteOccupancy()),
+      spriteParser_(new SpriteParser()),
+      borrowedVram_(nullptr),
+      borrowedOam_(nullptr),
+      borrowedGeneration_(0),
+      syncedGeneration_(0),
+      lcdc_(0),
       visible_(true) {
     // Initialize VRAM buffers to zero
     vramBank0_.fill(0);
     vramBank1_.fill(0);
     
+    // Every tile needs an initial decode
+    dirtyTiles_[0].set();
+    dirtyTiles_[1].set();
+    
     // Initialize OAM buffer to zero
     oam_.fill(0);
     
@@ -95,14 +108,75 @@ bool VRAMViewerPanel::UpdateVRAM(const uint8_t* buffer, size_t size, uint8_t ban
     }
     
     // Copy VRAM data to appropriate bank (Requirements 1.2, 2.2, 2.3)
-    if (bank == 0) {
-        std::memcpy(vramBank0_.data(), buffer, VRAM_BANK_SIZE);
-    } else {
-        std::memcpy(vramBank1_.data(), buffer, VRAM_BANK_SIZE);
+    // Tile data is diffed one 16-byte tile at a time so only tiles whose
+    // bytes actually changed are marked for re-decode
+    uint8_t* dest = (bank == 0) ? vramBank0_.data() : vramBank1_.data();
+    std::bitset<TILE_DATA_COUNT>& dirty = dirtyTiles_[bank];
+    bool changed = false;
+    
+    for (int tile = 0; tile < TILE_DATA_COUNT; tile++) {
+        size_t offset = static_cast<size_t>(tile) * TILE_BYTES;
+        if (std::memcmp(dest + offset, buffer + offset, TILE_BYTES) != 0) {
+            std::memcpy(dest + offset, buffer + offset, TILE_BYTES);
+            dirty.set(tile);
+            changed = true;
+        }
     }
     
+    // Tile maps ($9800-$9FFF) are not part of the tile grid, copy as-is
+    size_t tileDataSize = static_cast<size_t>(TILE_DATA_COUNT) * TILE_BYTES;
+    std::memcpy(dest + tileDataSize, buffer + tileDataSize, VRAM_BANK_SIZE - tileDataSize);
+    
     // Mark display as needing refresh (Requirement 1.3)
-    state_.needsRefresh = true;
+    if (changed) {
+        state_.needsRefresh = true;
+    }
+    
+    return true;
+}
+
+bool VRAMViewerPanel::UpdateVRAMRange(size_t offset, const uint8_t* data, size_t length, uint8_t bank) {
+    if (data == nullptr || offset + length > VRAM_BANK_SIZE || bank > 1) {
+        return false;
+    }
+    
+    // In DMG mode, only bank 0 is used
+    if (state_.mode == EmulationMode::DMG && bank != 0) {
+        return true;
+    }
+    
+    uint8_t* dest = (bank == 0) ? vramBank0_.data() : vramBank1_.data();
+    std::bitset<TILE_DATA_COUNT>& dirty = dirtyTiles_[bank];
+    const size_t tileDataSize = static_cast<size_t>(TILE_DATA_COUNT) * TILE_BYTES;
+    bool changed = false;
+    
+    for (size_t i = 0; i < length; i++) {
+        size_t addr = offset + i;
+        if (dest[addr] != data[i]) {
+            dest[addr] = data[i];
+            if (addr < tileDataSize) {
+                dirty.set(addr / TILE_BYTES);
+                changed = true;
+            }
+        }
+    }
+    
+    if (changed) {
+        state_.needsRefresh = true;
+    }
+    
+    return true;
+}
+
+bool VRAMViewerPanel::UpdateOAMRange(size_t offset, const uint8_t* data, size_t length) {
+    if (data == nullptr || offset + length > OAM_SIZE) {
+        return false;
+    }
+    
+    if (std::memcmp(oam_.data() + offset, data, length) != 0) {
+        std::memcpy(oam_.data() + offset, data, length);
+        state_.needsRefresh = true;
+    }
     
     return true;
 }
@@ -160,11 +234,9 @@ bool VRAMViewerPanel::UpdatePalettes(const CGBPalette* bgPalettes, const CGBPale
     }
     
     if (updated) {
-        // Mark all tiles as dirty since palette changed
-        if (renderer_) {
-            renderer_->MarkAllDirty();
-        }
-        // Mark display as needing refresh
+        // Tiles themselves are unaffected: the GPU lookup path re-uploads
+        // only the palette texture, and the RGBA path notices the palette
+        // differs from the one the atlas was built with
         state_.needsRefresh = true;
     }
     
@@ -185,13 +257,104 @@ void VRAMViewerPanel::SetEmulationMode(EmulationMode mode) {
         state_.currentBank = 0;
         
         // Mark all tiles as dirty since palette mode changed
-        if (renderer_) {
-            renderer_->MarkAllDirty();
-        }
-        
-        // Mark display as needing refresh (Requirements 12.2, 12.3, 12.4)
-        state_.needsRefresh = true;
+        // (Requirements 12.2, 12.3, 12.4)
+        MarkAllTilesDirty();
+    }
+}
+
+void VRAMViewerPanel::BorrowMemory(const uint8_t* vram, const uint8_t* oam, uint64_t generation) {
+    if (vram != borrowedVram_ || oam != borrowedOam_) {
+        // New buffers: force a sync even if the generation happens to match
+        syncedGeneration_ = generation - 1;
+    }
+    borrowedVram_ = vram;
+    borrowedOam_ = oam;
+    borrowedGeneration_ = generation;
+}
+
+void VRAMViewerPanel::ReleaseMemory() {
+    SyncBorrowedMemory();
+    borrowedVram_ = nullptr;
+    borrowedOam_ = nullptr;
+}
+
+void VRAMViewerPanel::SyncBorrowedMemory() {
+    if (borrowedGeneration_ == syncedGeneration_) {
+        return;
+    }
+    syncedGeneration_ = borrowedGeneration_;
+    
+    // The bank 0 shadow doubles as the previous frame for tile diffing,
+    // so only changed tiles are copied and re-decoded
+    if (borrowedVram_ != nullptr) {
+        UpdateVRAM(borrowedVram_, VRAM_BANK_SIZE, 0);
+    }
+    if (borrowedOam_ != nullptr && std::memcmp(oam_.data(), borrowedOam_, OAM_SIZE) != 0) {
+        UpdateOAM(borrowedOam_, OAM_SIZE);
+    }
+}
+
+void VRAMViewerPanel::MarkAllTilesDirty() {
+    dirtyTiles_[0].set();
+    dirtyTiles_[1].set();
+    if (renderer_) {
+        renderer_->MarkAllDirty();
+    }
+    InvalidateSpriteCache();
+    state_.needsRefresh = true;
+}
+
+void VRAMViewerPanel::InvalidateSpriteCache() {
+    for (size_t i = 0; i < spriteCache_.size(); i++) {
+        spriteCache_[i].valid = false;
+    }
+}
+
+void VRAMViewerPanel::UpdateSpriteTextures(int index, const Palette& palette, bool tall) {
+    const SpriteAttributes& sprite = sprites_[index];
+    SpriteCacheEntry& cache = spriteCache_[index];
+    
+    // Get the appropriate VRAM buffer based on sprite's VRAM bank (CGB only)
+    const uint8_t* vramBuffer;
+    if (state_.mode == EmulationMode::CGB && sprite.vramBank == 1) {
+        vramBuffer = vramBank1_.data();
+    } else {
+        vramBuffer = vramBank0_.data();
+    }
+    
+    // In 8x16 mode, the LSB of tile index is ignored (Requirement 9.5)
+    uint16_t tileIndex = sprite.tileIndex;
+    if (tall) {
+        tileIndex &= 0xFE;
+    }
+    const uint8_t* tileData = vramBuffer + tileIndex * 16;
+    const size_t tileBytes = tall ? 32 : 16;
+    const uint8_t* entry = oam_.data() + index * 4;
+    
+    if (cache.valid && cache.tall == tall &&
+        std::memcmp(cache.entry.data(), entry, cache.entry.size()) == 0 &&
+        std::memcmp(cache.tiles.data(), tileData, tileBytes) == 0 &&
+        std::memcmp(&cache.palette, &palette, sizeof(Palette)) == 0) {
+        return;
+    }
+    
+    // Flips are applied while decoding; a vertical flip of an 8x16 sprite
+    // also swaps its two tiles
+    uint16_t topTile = (tall && sprite.yFlip) ? (tileIndex | 0x01) : tileIndex;
+    auto pixelData = decoder_->DecodeTileFlipped(vramBuffer, topTile, sprite.xFlip, sprite.yFlip);
+    cache.topTexture = renderer_->RenderSpriteAt(index, pixelData, palette, false);
+    
+    if (tall) {
+        uint16_t bottomTile = sprite.yFlip ? tileIndex : (tileIndex | 0x01);
+        pixelData = decoder_->DecodeTileFlipped(vramBuffer, bottomTile, sprite.xFlip, sprite.yFlip);
+        cache.bottomTexture = renderer_->RenderSpriteAt(index, pixelData, palette, true);
     }
+    
+    std::memcpy(cache.entry.data(), entry, cache.entry.size());
+    std::memcpy(cache.tiles.data(), tileData, tileBytes);
+    cache.palette = palette;
+    cache.tall = tall;
+    cache.valid = true;
 }
 
 void VRAMViewerPanel::Render() {
@@ -199,6 +362,8 @@ void VRAMViewerPanel::Render() {
         return;
     }
     
+    SyncBorrowedMemory();
+    
     // Set initial window position and size (only on first use)
     ImGui::SetNextWindowPos(ImVec2(10, 240), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(580, 450), ImGuiCond_FirstUseEver);
@@ -229,7 +394,6 @@ void VRAMViewerPanel::RenderTileGrid() {
         if (ImGui::RadioButton("0", state_.currentBank == 0)) {
             if (state_.currentBank != 0) {
                 state_.currentBank = 0;
-                renderer_->MarkAllDirty();
                 state_.needsRefresh = true;
             }
         }
@@ -237,7 +401,6 @@ void VRAMViewerPanel::RenderTileGrid() {
         if (ImGui::RadioButton("1", state_.currentBank == 1)) {
             if (state_.currentBank != 1) {
                 state_.currentBank = 1;
-                renderer_->MarkAllDirty();
                 state_.needsRefresh = true;
             }
         }
@@ -250,7 +413,6 @@ void VRAMViewerPanel::RenderTileGrid() {
         if (ImGui::Combo("##palette", &state_.selectedPalette, 
                          "0\0001\0002\0003\0004\0005\0006\0007\0")) {
             paletteManager_->SetSelectedBGPalette(state_.selectedPalette);
-            renderer_->MarkAllDirty();
             state_.needsRefresh = true;
         }
     }
@@ -272,9 +434,49 @@ void VRAMViewerPanel::RenderTileGrid() {
     // Get the palette for rendering
     Palette palette = paletteManager_->GetBGPalette(state_.selectedPalette);
     
-    // Ensure texture pool is initialized with correct parameters
+    // Ensure the tile atlas is initialized with room for every bank in this mode
+    // (128x192 for DMG, 128x384 for both CGB banks)
     int numRows = (tileCount + TILES_PER_ROW - 1) / TILES_PER_ROW;
-    renderer_->InitializeTileGridPool(numRows, TILES_PER_ROW, state_.tileScale);
+    int bankCount = (state_.mode == EmulationMode::CGB) ? static_cast<int>(MAX_VRAM_BANKS) : 1;
+    
+    // Prefer GPU palette lookup: the atlas then holds color indices and a
+    // palette change costs one small palette texture upload
+    bool indexed = renderer_->IsPaletteLookupAvailable();
+    if (renderer_->InitializeTileAtlas(TILES_PER_ROW, numRows * bankCount, indexed)) {
+        // Fresh atlas texture holds no tiles yet
+        dirtyTiles_[0].set();
+        dirtyTiles_[1].set();
+    }
+    int slotBase = state_.currentBank * numRows * TILES_PER_ROW;
+    
+    if (indexed) {
+        Palette bgPalettes[8];
+        Palette spritePalettes[8];
+        for (int i = 0; i < 8; i++) {
+            bgPalettes[i] = paletteManager_->GetBGPalette(i);
+            spritePalettes[i] = paletteManager_->GetSpritePalette(i);
+        }
+        renderer_->UpdateLookupPalettes(bgPalettes, spritePalettes);
+    } else if (std::memcmp(palette.colors, atlasPalette_.colors, sizeof(palette.colors)) != 0) {
+        // A different palette invalidates every RGBA tile already in the atlas
+        atlasPalette_ = palette;
+        dirtyTiles_[0].set();
+        dirtyTiles_[1].set();
+    }
+    
+    // Decode only tiles whose bytes changed, then upload the atlas once
+    std::bitset<TILE_DATA_COUNT>& dirty = dirtyTiles_[state_.currentBank];
+    if (dirty.any()) {
+        for (int i = 0; i < tileCount; i++) {
+            if (!dirty.test(i)) {
+                continue;
+            }
+            auto pixelData = decoder_->DecodeTile(vramBuffer, static_cast<uint16_t>(i), state_.currentBank);
+            renderer_->RenderTileToAtlas(slotBase + i, pixelData, palette);
+        }
+        dirty.reset();
+    }
+    unsigned int atlasTexture = renderer_->UploadTileAtlas();
     
     // Calculate the exact height needed for the tile grid
     // Each tile is TILE_DISPLAY_SIZE pixels + TILE_SPACING between rows
@@ -289,40 +491,36 @@ void VRAMViewerPanel::RenderTileGrid() {
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(0, 0));
     
     // Render tiles in rows of 16 (Requirement 5.6)
+    // All tiles share the atlas texture, so ImGui batches them into one draw call.
+    // Only tile images may be drawn while palette lookup is active.
+    if (indexed) {
+        renderer_->BeginPaletteLookup(state_.selectedPalette);
+    }
+    ImVec2 selectedPos;
+    bool selectedVisible = false;
+    
     for (int i = 0; i < tileCount; i++) {
-        // Calculate row and column for texture pool
-        int row = i / TILES_PER_ROW;
-        int col = i % TILES_PER_ROW;
-        
         // Start new row every TILES_PER_ROW tiles
-        if (col != 0) {
+        if (i % TILES_PER_ROW != 0) {
             ImGui::SameLine(0, TILE_SPACING);
         }
         
-        // Decode tile from VRAM
-        auto pixelData = decoder_->DecodeTile(vramBuffer, static_cast<uint16_t>(i), state_.currentBank);
-        
-        // Render tile to texture using pool-based method (no memory leak)
-        unsigned int texture = renderer_->RenderTileAt(row, col, pixelData, palette);
+        // Look up this tile's sub-rectangle in the atlas
+        float u0, v0, u1, v1;
+        renderer_->GetAtlasTileUV(slotBase + i, u0, v0, u1, v1);
         
         // Display tile using ImGui::Image with invisible button for selection
         ImGui::PushID(i);
         
-        // Get cursor position for drawing selection highlight
-        ImVec2 pos = ImGui::GetCursorScreenPos();
-        
-        // Draw selection highlight behind the tile
+        // Remember where the selected tile is for the highlight drawn below
         if (state_.selectedTile == i) {
-            ImDrawList* drawList = ImGui::GetWindowDrawList();
-            drawList->AddRectFilled(
-                ImVec2(pos.x - 1, pos.y - 1),
-                ImVec2(pos.x + TILE_DISPLAY_SIZE + 1, pos.y + TILE_DISPLAY_SIZE + 1),
-                IM_COL32(100, 150, 200, 255)
-            );
+            selectedPos = ImGui::GetCursorScreenPos();
+            selectedVisible = true;
         }
         
-        // Display tile image
-        ImGui::Image((void*)(intptr_t)texture, ImVec2(TILE_DISPLAY_SIZE, TILE_DISPLAY_SIZE));
+        // Display tile image from the atlas
+        ImGui::Image((void*)(intptr_t)atlasTexture, ImVec2(TILE_DISPLAY_SIZE, TILE_DISPLAY_SIZE),
+                     ImVec2(u0, v0), ImVec2(u1, v1));
         
         // Make the image clickable for selection
         if (ImGui::IsItemClicked()) {
@@ -341,6 +539,20 @@ void VRAMViewerPanel::RenderTileGrid() {
         ImGui::PopID();
     }
     
+    if (indexed) {
+        renderer_->EndPaletteLookup();
+    }
+    
+    // Draw selection highlight in the 1-pixel gap around the selected tile
+    if (selectedVisible) {
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRect(
+            ImVec2(selectedPos.x - 1, selectedPos.y - 1),
+            ImVec2(selectedPos.x + TILE_DISPLAY_SIZE + 1, selectedPos.y + TILE_DISPLAY_SIZE + 1),
+            IM_COL32(100, 150, 200, 255)
+        );
+    }
+    
     ImGui::PopStyleVar(2);
     ImGui::EndChild();
     
@@ -353,22 +565,22 @@ void VRAMViewerPanel::RenderSpriteView() {
     ImGui::Separator();
     
     if (ImGui::CollapsingHeader("Sprite View")) {
-        // Parse OAM data using SpriteParser (Requirement 9.2)
-        SpriteParser spriteParser;
-        auto sprites = spriteParser.ParseOAM(oam_.data(), oam_.size());
+        // Parse OAM data into the panel's sprite table (Requirement 9.2)
+        spriteParser_->ParseOAM(oam_.data(), oam_.size(), sprites_);
         
-        // Display sprite count
-        ImGui::Text("Sprites: %zu / 40", sprites.size());
-        ImGui::SameLine();
+        // Sprite height follows LCDC bit 2 (Requirement 9.5)
+        const bool sprite8x16Mode = (lcdc_ & 0x04) != 0;
+        occupancy_->Analyze(oam_.data(), lcdc_, state_.mode == EmulationMode::CGB);
         
-        // Add checkbox for 8x16 sprite mode (Requirement 9.5)
-        static bool sprite8x16Mode = false;
-        ImGui::Checkbox("8x16 Mode", &sprite8x16Mode);
+        // Display sprite count
+        ImGui::Text("Sprites: %zu / 40  Size: %s (LCDC bit 2)", sprites_.size(), sprite8x16Mode ? "8x16" : "8x8");
         
         ImGui::Separator();
         
-        // Ensure sprite pool is initialized
-        renderer_->InitializeSpritePool(40, 4);
+        // Ensure sprite pool is initialized; new textures invalidate the cache
+        if (renderer_->InitializeSpritePool(40, 4)) {
+            InvalidateSpriteCache();
+        }
         
         // Create scrollable child region for sprite list
         ImGui::BeginChild("SpriteList", ImVec2(0, 300), true, ImGuiWindowFlags_HorizontalScrollbar);
@@ -379,8 +591,8 @@ void VRAMViewerPanel::RenderSpriteView() {
         
         int visibleCount = 0;
         
-        for (size_t i = 0; i < sprites.size(); i++) {
-            const SpriteAttributes& sprite = sprites[i];
+        for (size_t i = 0; i < sprites_.size(); i++) {
+            const SpriteAttributes& sprite = sprites_[i];
             
             // Start new row every spritesPerRow sprites
             if (i % spritesPerRow != 0) {
@@ -390,14 +602,6 @@ void VRAMViewerPanel::RenderSpriteView() {
             ImGui::BeginGroup();
             ImGui::PushID(static_cast<int>(i));
             
-            // Get the appropriate VRAM buffer based on sprite's VRAM bank (CGB only)
-            const uint8_t* vramBuffer;
-            if (state_.mode == EmulationMode::CGB && sprite.vramBank == 1) {
-                vramBuffer = vramBank1_.data();
-            } else {
-                vramBuffer = vramBank0_.data();
-            }
-            
             // Get the appropriate palette for this sprite (Requirement 9.3)
             Palette palette;
             if (state_.mode == EmulationMode::CGB) {
@@ -407,61 +611,14 @@ void VRAMViewerPanel::RenderSpriteView() {
                 palette = paletteManager_->GetSpritePalette(sprite.paletteNumber);
             }
             
-            // Decode and render the sprite tile
-            uint16_t tileIndex = sprite.tileIndex;
-            
-            // In 8x16 mode, the LSB of tile index is ignored (Requirement 9.5)
-            if (sprite8x16Mode) {
-                tileIndex &= 0xFE;
-            }
-            
-            // Decode the tile with flip flags applied
-            auto pixelData = decoder_->DecodeTile(vramBuffer, tileIndex, sprite.vramBank);
-            
-            // Apply flip transformations if needed
-            if (sprite.xFlip || sprite.yFlip) {
-                std::array<std::array<uint8_t, 8>, 8> flippedData;
-                for (int y = 0; y < 8; y++) {
-                    for (int x = 0; x < 8; x++) {
-                        int srcX = sprite.xFlip ? (7 - x) : x;
-                        int srcY = sprite.yFlip ? (7 - y) : y;
-                        flippedData[y][x] = pixelData[srcY][srcX];
-                    }
-                }
-                pixelData = flippedData;
-            }
-            
-            // Render the sprite tile using pool-based method (no memory leak)
-            unsigned int texture = renderer_->RenderSpriteAt(static_cast<int>(i), pixelData, palette, false);
+            // Re-decode only if the entry, its tiles or its palette changed
+            UpdateSpriteTextures(static_cast<int>(i), palette, sprite8x16Mode);
+            const SpriteCacheEntry& cached = spriteCache_[i];
             
-            // Display the sprite tile
+            ImGui::Image((void*)(intptr_t)cached.topTexture, ImVec2(spriteDisplaySize, spriteDisplaySize));
             if (sprite8x16Mode) {
                 // 8x16 mode: render both tiles vertically (Requirement 9.5)
-                ImGui::Image((void*)(intptr_t)texture, ImVec2(spriteDisplaySize, spriteDisplaySize));
-                
-                // Decode and render the bottom tile (tileIndex + 1)
-                uint16_t bottomTileIndex = tileIndex | 0x01;
-                auto bottomPixelData = decoder_->DecodeTile(vramBuffer, bottomTileIndex, sprite.vramBank);
-                
-                // Apply flip transformations to bottom tile
-                if (sprite.xFlip || sprite.yFlip) {
-                    std::array<std::array<uint8_t, 8>, 8> flippedData;
-                    for (int y = 0; y < 8; y++) {
-                        for (int x = 0; x < 8; x++) {
-                            int srcX = sprite.xFlip ? (7 - x) : x;
-                            int srcY = sprite.yFlip ? (7 - y) : y;
-                            flippedData[y][x] = bottomPixelData[srcY][srcX];
-                        }
-                    }
-                    bottomPixelData = flippedData;
-                }
-                
-                // Render bottom tile using pool-based method
-                unsigned int bottomTexture = renderer_->RenderSpriteAt(static_cast<int>(i), bottomPixelData, palette, true);
-                ImGui::Image((void*)(intptr_t)bottomTexture, ImVec2(spriteDisplaySize, spriteDisplaySize));
-            } else {
-                // 8x8 mode: render single tile
-                ImGui::Image((void*)(intptr_t)texture, ImVec2(spriteDisplaySize, spriteDisplaySize));
+                ImGui::Image((void*)(intptr_t)cached.bottomTexture, ImVec2(spriteDisplaySize, spriteDisplaySize));
             }
             
             // Show sprite info on hover (Requirement 9.3)
@@ -489,8 +646,11 @@ void VRAMViewerPanel::RenderSpriteView() {
                     sprite.yFlip ? "V" : "-");
                 ImGui::Text("Priority: %s", sprite.priority ? "Behind BG" : "Above BG");
                 
-                bool visible = spriteParser.IsSpriteVisible(sprite);
+                bool visible = spriteParser_->IsSpriteVisible(sprite);
                 ImGui::Text("Visible: %s", visible ? "Yes" : "No");
+                if ((occupancy_->GetDroppedSprites() >> i) & 1) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Dropped by the 10-sprite limit");
+                }
                 
                 ImGui::EndTooltip();
             }
@@ -500,7 +660,7 @@ void VRAMViewerPanel::RenderSpriteView() {
             ImGui::PopID();
             ImGui::EndGroup();
             
-            if (spriteParser.IsSpriteVisible(sprite)) {
+            if (spriteParser_->IsSpriteVisible(sprite)) {
                 visibleCount++;
             }
         }
@@ -508,7 +668,65 @@ void VRAMViewerPanel::RenderSpriteView() {
         ImGui::EndChild();
         
         ImGui::Text("Visible on screen: %d / 40", visibleCount);
+        
+        RenderOccupancyStrip();
+    }
+}
+
+void VRAMViewerPanel::RenderOccupancyStrip() {
+    ImGui::Text("Sprites per line: peak %d, %d line%s over the limit",
+                occupancy_->GetPeakCount(), occupancy_->GetOverflowLines(),
+                occupancy_->GetOverflowLines() == 1 ? "" : "s");
+    
+    // One 3-pixel column per line, LY 0 on the left
+    const float cellWidth = 3.0f;
+    const float stripHeight = 24.0f;
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (int ly = 0; ly < SpriteOccupancy::LINE_COUNT; ly++) {
+        const SpriteLine& line = occupancy_->GetLine(ly);
+        ImU32 color;
+        if (line.dropped != 0) {
+            color = IM_COL32(255, 0, 255, 255);
+        } else if (line.coveringCount == 0) {
+            color = IM_COL32(40, 40, 40, 255);
+        } else {
+            // Green at one sprite through red at ten
+            int heat = (line.coveringCount - 1) * 255 / (SpriteLine::MAX_DRAWN - 1);
+            color = IM_COL32(heat, 255 - heat / 2, 40, 255);
+        }
+        float x = origin.x + ly * cellWidth;
+        drawList->AddRectFilled(ImVec2(x, origin.y), ImVec2(x + cellWidth, origin.y + stripHeight), color);
+    }
+    ImGui::InvisibleButton("##occupancy", ImVec2(SpriteOccupancy::LINE_COUNT * cellWidth, stripHeight));
+    
+    if (!ImGui::IsItemHovered()) {
+        return;
+    }
+    int ly = static_cast<int>((ImGui::GetMousePos().x - origin.x) / cellWidth);
+    if (ly < 0 || ly >= SpriteOccupancy::LINE_COUNT) {
+        return;
+    }
+    
+    const SpriteLine& line = occupancy_->GetLine(ly);
+    ImGui::BeginTooltip();
+    ImGui::Text("LY %d: %d sprite%s", ly, line.coveringCount, line.coveringCount == 1 ? "" : "s");
+    if (line.drawnCount > 0) {
+        ImGui::Text("Drawn, highest priority first:");
+        for (int i = 0; i < line.drawnCount; i++) {
+            uint8_t entry = line.order[i];
+            ImGui::Text("  #%02d  X=%d", entry, oam_[entry * 4 + 1] - 8);
+        }
+    }
+    if (line.dropped != 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Dropped:");
+        for (int entry = 0; entry < SpriteOccupancy::OAM_ENTRIES; entry++) {
+            if ((line.dropped >> entry) & 1) {
+                ImGui::Text("  #%02d  X=%d", entry, oam_[entry * 4 + 1] - 8);
+            }
+        }
     }
+    ImGui::EndTooltip();
 }
 
 void VRAMViewerPanel::RenderTileInspector() {
@@ -1,7 +1,12 @@
 #include "../include/GBDebugger.h"
+#include "../include/DebuggerTypes.h"
+#include "../include/StateHistory.h"
 #include <iostream>
 #include <cassert>
 #include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 using namespace GBDebug;
 
@@ -99,6 +104,348 @@ void testUpdateMemory() {
     std::cout << "  ✓ UpdateMemory() tests passed" << std::endl;
 }
 
+void testBorrowMemory() {
+    std::cout << "Testing BorrowMemory() method..." << std::endl;
+    
+    GBDebugger debugger;
+    
+    static uint8_t buffer[65536];
+    std::memset(buffer, 0, sizeof(buffer));
+    
+    // Invalid arguments are rejected
+    assert(debugger.BorrowMemory(nullptr, 65536, 1) == false);
+    assert(debugger.BorrowMemory(buffer, 1024, 1) == false);
+    
+    // Borrowing works before and after Open()
+    assert(debugger.BorrowMemory(buffer, 65536, 1) == true);
+    debugger.Open();
+    
+    // Repeated borrows with a moving generation, rendering in between
+    for (uint64_t generation = 2; generation < 5; generation++) {
+        buffer[0x8000] = static_cast<uint8_t>(generation);
+        assert(debugger.BorrowMemory(buffer, 65536, generation) == true);
+        debugger.BeginFrame();
+        debugger.Render();
+        debugger.EndFrame();
+    }
+    
+    // Release keeps the last contents; switching back to copies is allowed
+    debugger.ReleaseMemory();
+    debugger.ReleaseMemory();
+    assert(debugger.UpdateMemory(buffer, 65536) == true);
+    
+    debugger.Close();
+    
+    std::cout << "  ✓ BorrowMemory() tests passed" << std::endl;
+}
+
+void testIncrementalMemory() {
+    std::cout << "Testing UpdateMemoryRange() and ApplyWriteLog()..." << std::endl;
+    
+    GBDebugger debugger;
+    
+    uint8_t data[256];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    
+    // Invalid arguments are rejected
+    assert(debugger.UpdateMemoryRange(0x0000, nullptr, 16) == false);
+    assert(debugger.UpdateMemoryRange(0xFFF0, data, 32) == false);
+    
+    // Ranges inside, across and outside VRAM/OAM
+    assert(debugger.UpdateMemoryRange(0xC000, data, 256) == true);
+    assert(std::memcmp(debugger.GetMemory() + 0xC000, data, 256) == 0);
+    
+    // $7F80-$807F: the upper half lands at the start of VRAM bank 0
+    assert(debugger.UpdateMemoryRange(0x7F80, data, 256) == true);
+    assert(std::memcmp(debugger.GetMemory() + 0x7F80, data, 256) == 0);
+    assert(std::memcmp(debugger.GetVRAMBank(0), data + 0x80, 0x80) == 0);
+    assert(debugger.GetVRAMBank(0)[0x80] == 0);
+    
+    // $FE80-$FEBF: only $FE80-$FE9F is OAM
+    assert(debugger.UpdateMemoryRange(0xFE80, data, 64) == true);
+    assert(std::memcmp(debugger.GetOAM() + 0x80, data, 0x20) == 0);
+    assert(debugger.GetOAM()[0x7F] == 0);
+    
+    assert(debugger.UpdateMemoryRange(0xFF00, data, 256) == true);
+    assert(std::memcmp(debugger.GetMemory() + 0xFF00, data, 256) == 0);
+    assert(debugger.IsCGBMode() == false);
+    
+    // Write logs, including an empty one; later records win
+    WriteRecord log[] = {
+        {0x8000, 0xFF}, {0x8001, 0x00}, {0x9FFF, 0x5A}, {0xFE00, 0x10}, {0xFE9F, 0x20},
+        {0xC123, 0x42}, {0xC123, 0x43}, {0x0143, 0x80}
+    };
+    assert(debugger.ApplyWriteLog(log, sizeof(log) / sizeof(log[0])) == true);
+    assert(debugger.ApplyWriteLog(nullptr, 0) == true);
+    assert(debugger.ApplyWriteLog(nullptr, 1) == false);
+    
+    const uint8_t* memory = debugger.GetMemory();
+    assert(memory[0x8000] == 0xFF && memory[0x8001] == 0x00 && memory[0x9FFF] == 0x5A);
+    assert(memory[0xC123] == 0x43 && memory[0x0143] == 0x80);
+    assert(debugger.GetVRAMBank(0)[0x0000] == 0xFF);
+    assert(debugger.GetVRAMBank(0)[0x0001] == 0x00);
+    assert(debugger.GetVRAMBank(0)[0x1FFF] == 0x5A);
+    assert(debugger.GetOAM()[0x00] == 0x10 && debugger.GetOAM()[0x9F] == 0x20);
+    
+    // The CGB flag switches the emulation mode both ways
+    assert(debugger.IsCGBMode() == true);
+    WriteRecord dmg = {0x0143, 0x00};
+    assert(debugger.ApplyWriteLog(&dmg, 1) == true);
+    assert(debugger.IsCGBMode() == false);
+    uint8_t cgbOnly = 0xC0;
+    assert(debugger.UpdateMemoryRange(0x0143, &cgbOnly, 1) == true);
+    assert(debugger.IsCGBMode() == true);
+    
+    debugger.Open();
+    debugger.BeginFrame();
+    debugger.Render();
+    debugger.EndFrame();
+    debugger.Close();
+    
+    std::cout << "  ✓ Incremental memory update tests passed" << std::endl;
+}
+
+void testRenderGovernor() {
+    std::cout << "Testing render governor..." << std::endl;
+    
+    GBDebugger debugger;
+    
+    // Nothing to render while closed
+    assert(debugger.ShouldRender() == false);
+    debugger.EndFrame();
+    
+    debugger.Open();
+    assert(debugger.GetTargetUIRate() == 0.0f);
+    
+    // First frame always renders
+    assert(debugger.ShouldRender() == true);
+    debugger.BeginFrame();
+    debugger.Render();
+    debugger.EndFrame();
+    
+    // No new state and no input: skipped, and the frame calls are no-ops
+    assert(debugger.ShouldRender() == false);
+    debugger.BeginFrame();
+    debugger.Render();
+    debugger.EndFrame();
+    
+    // A state update makes the next frame worth drawing
+    debugger.UpdateCPU(1, 0x0100, 0xFFFE, 0, 0, 0, 0, false);
+    assert(debugger.ShouldRender() == true);
+    debugger.BeginFrame();
+    debugger.Render();
+    debugger.EndFrame();
+    
+    // A low target rate holds back even changed state until the interval passes
+    debugger.SetTargetUIRate(1.0f);
+    assert(debugger.GetTargetUIRate() == 1.0f);
+    debugger.UpdateCPU(2, 0x0101, 0xFFFE, 0, 0, 0, 0, false);
+    assert(debugger.ShouldRender() == false);
+    
+    debugger.SetTargetUIRate(0.0f);
+    debugger.Close();
+    
+    std::cout << "  ✓ Render governor tests passed" << std::endl;
+}
+
+void testBreakpoints() {
+    std::cout << "Testing ShouldBreak()..." << std::endl;
+    
+    GBDebugger debugger;
+    
+    // No breakpoints: never breaks
+    assert(debugger.ShouldBreak(0x0150) == false);
+    
+    assert(debugger.AddBreakpoint(0x0150) == true);
+    debugger.SetRunning(true);
+    
+    // Hit stops execution
+    assert(debugger.ShouldBreak(0x0150) == true);
+    assert(debugger.IsRunning() == false);
+    
+    // Resuming executes the instruction the breakpoint stopped on
+    debugger.SetRunning(true);
+    assert(debugger.ShouldBreak(0x0150) == false);
+    assert(debugger.IsRunning() == true);
+    
+    // Coming back around the loop hits again
+    assert(debugger.ShouldBreak(0x0151) == false);
+    assert(debugger.ShouldBreak(0x0150) == true);
+    
+    // Stepping past the breakpoint (no checks while stopped), then Run:
+    // the next visit is a new hit
+    debugger.ClearStepRequest();
+    debugger.SetRunning(true);
+    assert(debugger.ShouldBreak(0x0150) == true);
+    
+    // Live registers: the pass only holds at the cycle of the stop, even
+    // if the host stepped without clearing the request
+    debugger.ClearStepRequest();
+    CPUState stop;
+    stop.pc = 0x0150;
+    stop.cycle = 1000;
+    debugger.SetRunning(true);
+    assert(debugger.ShouldBreak(stop, 0) == true);
+    debugger.SetRunning(true);
+    assert(debugger.ShouldBreak(stop, 0) == false);
+    assert(debugger.ShouldBreak(stop, 0) == true);
+    debugger.SetRunning(true);
+    stop.cycle = 1004;
+    assert(debugger.ShouldBreak(stop, 0) == true);
+    
+    assert(debugger.RemoveBreakpoint(0x0150) == true);
+    assert(debugger.ShouldBreak(0x0150) == false);
+    
+    // Conditional breakpoint evaluated against live state
+    assert(debugger.AddBreakpoint(0x0200, -1, "A ==") == false);
+    assert(debugger.AddBreakpoint(0x0200, -1, "A == 0x3C && [0xC000] == 7") == true);
+    std::vector<uint8_t> memory(0x10000, 0);
+    memory[0xC000] = 7;
+    CPUState cpu;
+    cpu.pc = 0x0200;
+    cpu.af = 0x0100;
+    debugger.SetRunning(true);
+    assert(debugger.ShouldBreak(cpu, 0, memory.data()) == false);
+    cpu.af = 0x3C00;
+    
+    // Without live registers and memory the condition is never evaluated,
+    // not even against the matching state on display
+    debugger.UpdateCPU(cpu.cycle, cpu.pc, cpu.sp, cpu.af, cpu.bc, cpu.de, cpu.hl, cpu.ime);
+    debugger.UpdateMemory(memory.data(), memory.size());
+    assert(debugger.ShouldBreak(0x0200) == false);
+    assert(debugger.ShouldBreak(cpu, 0) == false);
+    assert(debugger.IsRunning() == true);
+    
+    assert(debugger.ShouldBreak(cpu, 0, memory.data()) == true);
+    assert(debugger.IsRunning() == false);
+    
+    std::cout << "  ✓ ShouldBreak() tests passed" << std::endl;
+}
+
+void testTrace() {
+    std::cout << "Testing TraceInstruction()..." << std::endl;
+    
+    GBDebugger debugger;
+    
+    // Tracing off: records are accepted and dropped
+    debugger.TraceInstruction(0x0100, 0x00, 0x01B0, 0x0013, 0x00D8, 0x014D, 0);
+    assert(debugger.GetTrace().GetCapacity() == 0);
+    
+    debugger.SetTraceCapacity(64);
+    debugger.TraceInstruction(0x0150, 0xC3, 0x01B0, 0x0013, 0x00D8, 0x014D, 1234, 2);
+    assert(debugger.GetTrace().GetTotal() == 1);
+    
+    TraceRecord record;
+    assert(debugger.GetTrace().Read(0, record));
+    assert(record.pc == 0x0150 && record.opcode == 0xC3 && record.cycle == 1234);
+    
+    // Full-state records are streamed to a file when one is open
+    assert(debugger.StartTraceFile("APILayerTest.gbtrace"));
+    CPUState state;
+    state.pc = 0x0150;
+    state.cycle = 5000;
+    debugger.TraceInstruction(state, 0x00);
+    state.pc = 0x0151;
+    state.cycle = 5004;
+    debugger.TraceInstruction(state, 0x00);
+    assert(debugger.StopTraceFile());
+    assert(debugger.GetTrace().GetTotal() == 3);
+    
+    TraceFileReader reader;
+    std::string error;
+    assert(reader.Open("APILayerTest.gbtrace", error));
+    assert(reader.GetRecordCount() == 2);
+    TraceFileRecord fileRecord;
+    assert(reader.ReadRecord(1, fileRecord) && fileRecord.state.cycle == 5004);
+    reader.Close();
+    std::remove("APILayerTest.gbtrace");
+    
+    std::cout << "  ✓ TraceInstruction() tests passed" << std::endl;
+}
+
+void testHistory() {
+    std::cout << "Testing rewind history..." << std::endl;
+    
+    GBDebugger debugger;
+    std::vector<uint8_t> memory(65536, 0);
+    
+    // History off: nothing is captured
+    debugger.UpdateMemory(memory.data(), memory.size());
+    assert(debugger.CaptureHistory() == false);
+    
+    debugger.SetHistoryBudget(4 * 1024 * 1024);
+    for (uint64_t frame = 1; frame <= 10; frame++) {
+        memory[0xC000] = static_cast<uint8_t>(frame);
+        debugger.UpdateCPU(frame * 70224, static_cast<uint16_t>(0x0150 + frame), 0xFFFE, 0, 0, 0, 0, false);
+        debugger.UpdateMemory(memory.data(), memory.size());
+        assert(debugger.CaptureHistory() == true);
+    }
+    assert(debugger.GetHistory().GetStepCount() == 10);
+    
+    assert(debugger.SeekToCycle(3 * 70224) == true);
+    assert(debugger.GetHistory().GetCPU().pc == 0x0153);
+    assert(debugger.GetHistory().GetMemory()[0xC000] == 3);
+    assert(debugger.SeekToCycle(100) == false);
+    
+    // The view shows a recorded step until live state comes back
+    assert(debugger.SeekToCycle(3 * 70224) == true);
+    assert(debugger.CaptureHistory() == false);
+    assert(debugger.GetHistory().GetStepCount() == 10);
+    
+    memory[0xC000] = 11;
+    debugger.UpdateCPU(11 * 70224, 0x015B, 0xFFFE, 0, 0, 0, 0, false);
+    debugger.UpdateMemory(memory.data(), memory.size());
+    assert(debugger.CaptureHistory() == true);
+    assert(debugger.GetHistory().GetNewestCycle() == 11 * 70224);
+    assert(debugger.SeekToCycle(10 * 70224) == true);
+    assert(debugger.GetHistory().GetMemory()[0xC000] == 10);
+    
+    // A host that hands over an older cycle is refused
+    debugger.UpdateCPU(5 * 70224, 0x0155, 0xFFFE, 0, 0, 0, 0, false);
+    assert(debugger.CaptureHistory() == false);
+    
+    std::cout << "  ✓ Rewind history tests passed" << std::endl;
+}
+
+void testScanlines() {
+    std::cout << "Testing scanline register recording..." << std::endl;
+    
+    GBDebugger debugger;
+    assert(!debugger.GetScanlines().HasFrame());
+    
+    // A mid-frame scroll split, shown once the host updates state
+    ScanlineRegisters registers;
+    for (uint8_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+        registers.scx = ly < 100 ? 0 : 64;
+        debugger.RecordScanlineRegisters(ly, registers);
+    }
+    debugger.RecordScanlineRegisters(200, registers);
+    assert(!debugger.GetScanlines().HasFrame());
+    
+    debugger.UpdateCPU(70224, 0x0150, 0xFFFE, 0, 0, 0, 0, false);
+    assert(debugger.GetScanlines().HasFrame());
+    assert(debugger.GetScanlines().GetLine(99).scx == 0);
+    assert(debugger.GetScanlines().GetLine(100).scx == 64);
+    assert(!debugger.GetScanlines().IsUniform());
+    
+    std::cout << "  ✓ Scanline register tests passed" << std::endl;
+}
+
+void testFramebuffer() {
+    std::cout << "Testing framebuffer comparison input..." << std::endl;
+    
+    GBDebugger debugger;
+    std::vector<uint16_t> framebuffer(160 * 144, 0);
+    
+    assert(debugger.UpdateFramebuffer(nullptr, framebuffer.size()) == false);
+    assert(debugger.UpdateFramebuffer(framebuffer.data(), 100) == false);
+    assert(debugger.UpdateFramebuffer(framebuffer.data(), framebuffer.size()) == true);
+    
+    std::cout << "  ✓ Framebuffer input tests passed" << std::endl;
+}
+
 void testRender() {
     std::cout << "Testing Render() method..." << std::endl;
     
@@ -129,6 +476,14 @@ int main() {
     testLifecycleMethods();
     testUpdateCPU();
     testUpdateMemory();
+    testBorrowMemory();
+    testIncrementalMemory();
+    testRenderGovernor();
+    testBreakpoints();
+    testTrace();
+    testHistory();
+    testScanlines();
+    testFramebuffer();
     testRender();
     
     std::cout << std::endl;
@@ -0,0 +1,196 @@
+#include "../include/BreakCondition.h"
+#include "../include/BreakpointManager.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+bool Eval(const char* source, const CPUState& cpu, const uint8_t* memory) {
+    BreakCondition condition;
+    std::string error;
+    bool compiled = condition.Compile(source, error);
+    if (!compiled) {
+        std::cout << "  unexpected error for \"" << source << "\": " << error << std::endl;
+    }
+    assert(compiled);
+    return condition.Evaluate(cpu, memory);
+}
+
+} // namespace
+
+void testEvaluation() {
+    std::cout << "Testing condition evaluation..." << std::endl;
+    
+    std::vector<uint8_t> memory(0x10000, 0);
+    memory[0xC123] = 7;
+    memory[0xFF40] = 0x91;
+    
+    CPUState cpu;
+    cpu.af = 0x3CB0;   // A=$3C, Z and H and C set
+    cpu.bc = 0x1234;
+    cpu.hl = 0xC123;
+    cpu.sp = 0xFFFE;
+    cpu.pc = 0x0150;
+    cpu.cycle = 2000000;
+    
+    assert(Eval("A == 0x3C", cpu, memory.data()));
+    assert(Eval("a == $3c", cpu, memory.data()));
+    assert(Eval("A == 60", cpu, memory.data()));
+    assert(!Eval("A != 0x3C", cpu, memory.data()));
+    assert(Eval("BC == 0x1234 && B == 0x12 && C == 0x34", cpu, memory.data()));
+    assert(Eval("[HL] == 7", cpu, memory.data()));
+    assert(Eval("[HL + 1] == 0", cpu, memory.data()));
+    assert(Eval("[FF40] & 0x80", cpu, memory.data()));
+    assert(Eval("ZF && !NF && CF", cpu, memory.data()));
+    assert(Eval("CYCLE > 1000000", cpu, memory.data()));
+    assert(Eval("A == 0x3C && [HL] > 5 && cycle > 1000000", cpu, memory.data()));
+    assert(Eval("SP - 2 == 0xFFFC", cpu, memory.data()));
+    assert(Eval("~A & 0xFF == 0xC3", cpu, memory.data()));
+    assert(Eval("-1 < 0", cpu, memory.data()));
+    
+    // Null memory reads as zero
+    assert(Eval("[HL] == 0", cpu, nullptr));
+    
+    // Empty condition always holds
+    BreakCondition empty;
+    assert(empty.IsEmpty());
+    assert(empty.Evaluate(cpu, memory.data()));
+    
+    std::cout << "  ✓ Evaluation tests passed" << std::endl;
+}
+
+void testPrecedence() {
+    std::cout << "Testing operator precedence and short-circuit..." << std::endl;
+    
+    CPUState cpu;
+    cpu.af = 0x0100;   // A=1
+    
+    // && binds tighter than ||
+    assert(Eval("1 || 0 && 0", cpu, nullptr));
+    assert(!Eval("(1 || 0) && 0", cpu, nullptr));
+    
+    // Bitwise binds tighter than comparison
+    assert(Eval("0x81 & 0x80 == 0x80", cpu, nullptr));
+    
+    // Logical operators produce 0/1
+    assert(Eval("(2 && 3) == 1", cpu, nullptr));
+    assert(Eval("(0 || 5) == 1", cpu, nullptr));
+    
+    // The right side of a decided && / || is skipped
+    BreakCondition condition;
+    std::string error;
+    assert(condition.Compile("A == 0 && [0] == 0", error));
+    assert(!condition.Evaluate(cpu, nullptr));
+    assert(condition.Compile("A == 1 || [0] == 99", error));
+    assert(condition.Evaluate(cpu, nullptr));
+    
+    std::cout << "  ✓ Precedence tests passed" << std::endl;
+}
+
+void testErrors() {
+    std::cout << "Testing parse errors..." << std::endl;
+    
+    BreakCondition condition;
+    std::string error;
+    
+    assert(condition.Compile("A == 1", error));
+    size_t size = condition.GetCodeSize();
+    
+    const char* invalid[] = {
+        "A = 1", "A ==", "(A == 1", "[HL", "A == 1)", "XYZZY", "A &&& B", "0x", "1 2"
+    };
+    for (const char* source : invalid) {
+        error.clear();
+        assert(!condition.Compile(source, error));
+        assert(!error.empty());
+    }
+    
+    // A failed compile keeps the previous condition
+    assert(condition.GetSource() == "A == 1");
+    assert(condition.GetCodeSize() == size);
+    
+    // Single '=' gets a helpful message
+    condition.Compile("A = 1", error);
+    assert(error.find("==") != std::string::npos);
+    
+    std::cout << "  ✓ Error tests passed" << std::endl;
+}
+
+void testConditionalBreakpoints() {
+    std::cout << "Testing conditional breakpoints..." << std::endl;
+    
+    BreakpointManager breakpoints;
+    std::string error;
+    breakpoints.Add(0x0150);
+    assert(breakpoints.Find(0x0150) == 0);
+    assert(breakpoints.Find(0x0151) == -1);
+    
+    assert(!breakpoints.SetCondition(0, "A ==", error));
+    assert(breakpoints.SetCondition(0, "A == 0x3C", error));
+    
+    CPUState cpu;
+    cpu.pc = 0x0150;
+    cpu.af = 0x0000;
+    assert(breakpoints.Check(0x0150, 0, &cpu, nullptr) == false);
+    assert(breakpoints.Check(0x0150, 0) == false);   // No state: never fires
+    cpu.af = 0x3C00;
+    assert(breakpoints.Check(0x0150, 0, &cpu, nullptr) == true);
+    
+    // Clearing the condition makes it unconditional again
+    assert(breakpoints.SetCondition(0, "", error));
+    assert(breakpoints.Check(0x0150, 0) == true);
+    
+    std::vector<Breakpoint> entries;
+    breakpoints.CopyBreakpoints(entries);
+    assert(entries[0].hitCount == 2);
+    
+    std::cout << "  ✓ Conditional breakpoint tests passed" << std::endl;
+}
+
+void benchmarkEvaluate() {
+    std::cout << "Benchmarking condition evaluation..." << std::endl;
+    
+    std::vector<uint8_t> memory(0x10000, 0);
+    memory[0xC000] = 9;
+    CPUState cpu;
+    cpu.hl = 0xC000;
+    
+    BreakCondition condition;
+    std::string error;
+    assert(condition.Compile("A == 0x3C && [HL] > 5 && CYCLE > 1000000", error));
+    
+    const int iterations = 10000000;
+    int hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        cpu.af = static_cast<uint16_t>((i & 0xFF) << 8);
+        cpu.cycle = static_cast<uint64_t>(i);
+        hits += condition.Evaluate(cpu, memory.data()) ? 1 : 0;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    
+    std::cout << "  " << condition.GetCodeSize() << " instructions, "
+              << ns << " ns per evaluation (" << hits << " hits)" << std::endl;
+}
+
+int main() {
+    std::cout << "Running break condition tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testEvaluation();
+    testPrecedence();
+    testErrors();
+    testConditionalBreakpoints();
+    benchmarkEvaluate();
+    
+    std::cout << std::endl;
+    std::cout << "All break condition tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "../include/BreakpointManager.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace GBDebug;
+
+void testHotPath() {
+    std::cout << "Testing breakpoint hot-path bitmap..." << std::endl;
+    
+    BreakpointManager breakpoints;
+    
+    // Nothing set: every address is rejected by the bitmap
+    for (uint32_t pc = 0; pc < 65536; pc++) {
+        assert(breakpoints.MayBreak(static_cast<uint16_t>(pc)) == false);
+    }
+    
+    assert(breakpoints.Add(0x0150) == true);
+    assert(breakpoints.Add(0x0150) == false);  // Duplicate
+    assert(breakpoints.Add(0xFFFF) == true);
+    
+    assert(breakpoints.MayBreak(0x0150) == true);
+    assert(breakpoints.MayBreak(0xFFFF) == true);
+    assert(breakpoints.MayBreak(0x0151) == false);
+    assert(breakpoints.MayBreak(0x014F) == false);
+    
+    assert(breakpoints.Check(0x0150, 0) == true);
+    assert(breakpoints.Check(0xFFFF, 7) == true);
+    
+    std::cout << "  ✓ Hot-path tests passed" << std::endl;
+}
+
+void testBankedBreakpoints() {
+    std::cout << "Testing bank-aware breakpoints..." << std::endl;
+    
+    BreakpointManager breakpoints;
+    
+    // Bank-specific entry in switchable ROM
+    breakpoints.Add(0x4100, 3);
+    assert(breakpoints.MayBreak(0x4100) == true);
+    assert(breakpoints.Check(0x4100, 3) == true);
+    assert(breakpoints.Check(0x4100, 2) == false);
+    assert(breakpoints.Check(0x4100, 300) == false);
+    
+    // Large bank numbers (MBC5) are supported
+    breakpoints.Add(0x7FFF, 511);
+    assert(breakpoints.Check(0x7FFF, 511) == true);
+    assert(breakpoints.Check(0x7FFF, 510) == false);
+    
+    // Banks beyond the MBC range, or below ANY_BANK, are rejected
+    assert(breakpoints.Add(0x4000, -5) == false);
+    assert(breakpoints.Add(0x4000, 512) == false);
+    assert(breakpoints.Add(0x4000, 100000) == false);
+    assert(breakpoints.Add(0x0150, -2) == false);
+    assert(breakpoints.Find(0x4000, -5) == -1);
+    assert(breakpoints.Remove(0x4000, 512) == false);
+    assert(breakpoints.MayBreak(0x4000) == false);
+    
+    // Banks are ignored outside $4000-$7FFF
+    breakpoints.Add(0xC000, 5);
+    assert(breakpoints.Check(0xC000, 0) == true);
+    assert(breakpoints.Remove(0xC000) == true);
+    assert(breakpoints.MayBreak(0xC000) == false);
+    
+    // Any-bank entry at the same address matches every bank
+    breakpoints.Add(0x4100);
+    assert(breakpoints.Check(0x4100, 2) == true);
+    
+    uint16_t address;
+    int bank;
+    assert(breakpoints.GetLastHit(address, bank) == true);
+    assert(address == 0x4100 && bank == 2);
+    
+    std::cout << "  ✓ Bank-aware tests passed" << std::endl;
+}
+
+void testEditing() {
+    std::cout << "Testing breakpoint editing..." << std::endl;
+    
+    BreakpointManager breakpoints;
+    breakpoints.Add(0x1000);
+    breakpoints.Add(0x2000);
+    
+    std::vector<Breakpoint> entries;
+    breakpoints.CopyBreakpoints(entries);
+    assert(entries.size() == 2);
+    
+    // Disabled entries clear their bit
+    breakpoints.SetEnabled(0, false);
+    assert(breakpoints.MayBreak(0x1000) == false);
+    assert(breakpoints.MayBreak(0x2000) == true);
+    breakpoints.SetEnabled(0, true);
+    assert(breakpoints.MayBreak(0x1000) == true);
+    
+    // Hit counts accumulate
+    breakpoints.Check(0x2000, 0);
+    breakpoints.Check(0x2000, 0);
+    breakpoints.CopyBreakpoints(entries);
+    assert(entries[1].hitCount == 2);
+    
+    breakpoints.RemoveAt(0);
+    assert(breakpoints.MayBreak(0x1000) == false);
+    
+    breakpoints.Clear();
+    breakpoints.CopyBreakpoints(entries);
+    assert(entries.empty());
+    assert(breakpoints.MayBreak(0x2000) == false);
+    
+    std::cout << "  ✓ Editing tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running breakpoint manager tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testHotPath();
+    testBankedBreakpoints();
+    testEditing();
+    
+    std::cout << std::endl;
+    std::cout << "All breakpoint manager tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -97,6 +97,41 @@ void testMemoryRegions() {
     std::cout << "  ✓ MemoryRegion tests passed" << std::endl;
 }
 
+void testIORegisterLookup() {
+    std::cout << "Testing I/O register lookup table..." << std::endl;
+    
+    // Table must agree with a linear scan for every I/O address
+    for (uint16_t addr = 0xFF00; addr <= 0xFF7F; addr++) {
+        const IORegister* expected = nullptr;
+        for (size_t i = 0; i < IO_REGISTERS_COUNT; i++) {
+            if (addr >= IO_REGISTERS[i].start && addr <= IO_REGISTERS[i].end) {
+                expected = &IO_REGISTERS[i];
+                break;
+            }
+        }
+        assert(FindIORegister(addr) == expected);
+    }
+    
+    // Spot checks, including a multi-byte range and an unmapped address
+    assert(std::string(FindIORegister(0xFF40)->name) == "LCDC");
+    assert(FindIORegister(0xFF35) == FindIORegister(0xFF30));
+    assert(FindIORegister(0xFF08) == nullptr);
+    assert(FindIORegister(0xFEFF) == nullptr);
+    assert(FindIORegister(0xFF80) == nullptr);
+    
+    // Category buckets partition the table in address order
+    assert(IO_RANGE_GENERAL.first == 0);
+    assert(IO_RANGE_GENERAL.end == IO_RANGE_SOUND.first);
+    assert(IO_RANGE_SOUND.end == IO_RANGE_PPU.first);
+    assert(IO_RANGE_PPU.end == IO_RANGE_CGB.first);
+    assert(IO_RANGE_CGB.end == IO_REGISTERS_COUNT);
+    assert(IO_RANGE_TIMER.end - IO_RANGE_TIMER.first == 4);
+    assert(IO_REGISTERS[IO_RANGE_TIMER.first].start == 0xFF04);
+    assert(IO_REGISTERS[IO_RANGE_PPU.first].start == 0xFF40);
+    
+    std::cout << "  ✓ I/O register lookup tests passed" << std::endl;
+}
+
 int main() {
     std::cout << "Running data structures tests..." << std::endl;
     std::cout << std::endl;
@@ -104,6 +139,7 @@ int main() {
     testCPUState();
     testMemoryState();
     testMemoryRegions();
+    testIORegisterLookup();
     
     std::cout << std::endl;
     std::cout << "All tests passed! ✓" << std::endl;
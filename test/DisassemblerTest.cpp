@@ -0,0 +1,169 @@
+#include "../include/Disassembler.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+std::string DecodeText(const std::vector<uint8_t>& memory, uint16_t address) {
+    DisassembledInstruction insn;
+    Disassembler::Decode(memory.data(), address, insn);
+    return insn.text;
+}
+
+} // namespace
+
+void testOpcodeTables() {
+    std::cout << "Testing opcode tables..." << std::endl;
+    
+    // Every entry has a format and a sane length
+    for (int op = 0; op < 256; op++) {
+        const OpcodeInfo& info = Disassembler::GetOpcodeInfo(static_cast<uint8_t>(op));
+        assert(info.format != nullptr);
+        assert(info.length >= 1 && info.length <= 3);
+        assert(Disassembler::GetCBOpcodeInfo(static_cast<uint8_t>(op)).length == 2);
+    }
+    
+    assert(Disassembler::GetLength(0x00) == 1);   // NOP
+    assert(Disassembler::GetLength(0x3E) == 2);   // LD A,d8
+    assert(Disassembler::GetLength(0xC3) == 3);   // JP a16
+    assert(Disassembler::GetLength(0xCB) == 2);   // CB prefix
+    assert(Disassembler::GetLength(0x10) == 2);   // STOP
+    
+    std::cout << "  ✓ Opcode table tests passed" << std::endl;
+}
+
+void testDecode() {
+    std::cout << "Testing instruction decoding..." << std::endl;
+    
+    std::vector<uint8_t> memory(0x10000, 0);
+    const uint8_t code[] = {
+        0x00,                   // 0100 NOP
+        0xC3, 0x50, 0x01,       // 0101 JP $0150
+        0x3E, 0x3C,             // 0104 LD A,$3C
+        0x18, 0xFE,             // 0106 JR $0106
+        0xE0, 0x40,             // 0108 LDH ($FF40),A
+        0xCB, 0x7C,             // 010A BIT 7,H
+        0xF8, 0xFE,             // 010C LD HL,SP-2
+        0x36, 0x12,             // 010E LD (HL),$12
+        0xD3,                   // 0110 invalid
+        0x76,                   // 0111 HALT
+    };
+    std::memcpy(&memory[0x100], code, sizeof(code));
+    
+    assert(DecodeText(memory, 0x100) == "NOP");
+    assert(DecodeText(memory, 0x101) == "JP $0150");
+    assert(DecodeText(memory, 0x104) == "LD A,$3C");
+    assert(DecodeText(memory, 0x106) == "JR $0106");
+    assert(DecodeText(memory, 0x108) == "LDH ($FF40),A");
+    assert(DecodeText(memory, 0x10A) == "BIT 7,H");
+    assert(DecodeText(memory, 0x10C) == "LD HL,SP-2");
+    assert(DecodeText(memory, 0x10E) == "LD (HL),$12");
+    assert(DecodeText(memory, 0x110) == "DB $D3");
+    assert(DecodeText(memory, 0x111) == "HALT");
+    
+    // Operands wrap at the end of the address space
+    memory[0xFFFF] = 0x3E;
+    memory[0x0000] = 0x99;
+    assert(DecodeText(memory, 0xFFFF) == "LD A,$99");
+    
+    std::cout << "  ✓ Decode tests passed" << std::endl;
+}
+
+void testDecodeCache() {
+    std::cout << "Testing per-bank decode cache..." << std::endl;
+    
+    std::vector<uint8_t> memory(0x10000, 0);
+    memory[0x4000] = 0x3E;
+    memory[0x4001] = 0x01;
+    
+    Disassembler disassembler;
+    assert(std::string(disassembler.Get(memory.data(), 0x4000, 2).text) == "LD A,$01");
+    assert(disassembler.GetDecodeCount() == 1);
+    
+    // Unchanged bytes hit the cache
+    for (int i = 0; i < 100; i++) {
+        disassembler.Get(memory.data(), 0x4000, 2);
+    }
+    assert(disassembler.GetDecodeCount() == 1);
+    
+    // Another bank is cached separately
+    memory[0x4001] = 0x05;
+    assert(std::string(disassembler.Get(memory.data(), 0x4000, 3).text) == "LD A,$05");
+    assert(disassembler.GetDecodeCount() == 2);
+    
+    // Changed bytes invalidate the entry
+    assert(std::string(disassembler.Get(memory.data(), 0x4000, 2).text) == "LD A,$05");
+    assert(disassembler.GetDecodeCount() == 3);
+    
+    // Bytes after the instruction do not matter
+    memory[0x4002] = 0xFF;
+    disassembler.Get(memory.data(), 0x4000, 2);
+    assert(disassembler.GetDecodeCount() == 3);
+    
+    std::cout << "  ✓ Decode cache tests passed" << std::endl;
+}
+
+void testLines() {
+    std::cout << "Testing region sweep..." << std::endl;
+    
+    std::vector<uint8_t> memory(0x10000, 0);
+    memory[0x0000] = 0xC3;   // JP a16 (3 bytes)
+    memory[0x0003] = 0x3E;   // LD A,d8 (2 bytes)
+    
+    Disassembler disassembler;
+    const std::vector<uint16_t>& lines = disassembler.GetLines(memory.data(), 0x0000, 0);
+    assert(lines[0] == 0x0000);
+    assert(lines[1] == 0x0003);
+    assert(lines[2] == 0x0005);
+    assert(lines.back() == 0x3FFF);
+    assert(disassembler.GetSweepCount() == 1);
+    
+    // Unchanged region: no new sweep
+    for (int i = 0; i < 100; i++) {
+        disassembler.GetLines(memory.data(), 0x0010, 0);
+    }
+    assert(disassembler.GetSweepCount() == 1);
+    
+    // An address inside an instruction becomes a line of its own
+    const std::vector<uint16_t>& synced = disassembler.GetLines(memory.data(), 0x0001, 0);
+    assert(synced[0] == 0x0000);
+    assert(synced[1] == 0x0001);
+    assert(disassembler.GetSweepCount() == 2);
+    
+    // Changing the region's bytes triggers a new sweep
+    memory[0x0005] = 0xC3;
+    const std::vector<uint16_t>& changed = disassembler.GetLines(memory.data(), 0x0000, 0);
+    assert(disassembler.GetSweepCount() == 3);
+    size_t i = 0;
+    while (changed[i] != 0x0005) {
+        i++;
+    }
+    assert(changed[i + 1] == 0x0008);
+    
+    // Banked regions are swept per bank
+    disassembler.GetLines(memory.data(), 0x4000, 1);
+    disassembler.GetLines(memory.data(), 0x4000, 2);
+    assert(disassembler.GetSweepCount() == 5);
+    
+    std::cout << "  ✓ Region sweep tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running disassembler tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testOpcodeTables();
+    testDecode();
+    testDecodeCache();
+    testLines();
+    
+    std::cout << std::endl;
+    std::cout << "All disassembler tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,324 @@
+#include "../include/FrameCompositor.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+const uint16_t LCDC = 0xFF40;
+const uint16_t SCY = 0xFF42;
+const uint16_t SCX = 0xFF43;
+const uint16_t BGP = 0xFF47;
+const uint16_t OBP0 = 0xFF48;
+const uint16_t OBP1 = 0xFF49;
+const uint16_t WY = 0xFF4A;
+const uint16_t WX = 0xFF4B;
+
+/**
+ * Fill every row of a tile with one color index
+ */
+void SetSolidTile(uint8_t* vram, int tile, uint8_t color) {
+    for (int row = 0; row < 8; row++) {
+        vram[tile * 16 + row * 2] = (color & 1) ? 0xFF : 0x00;
+        vram[tile * 16 + row * 2 + 1] = (color & 2) ? 0xFF : 0x00;
+    }
+}
+
+void SetSprite(std::vector<uint8_t>& memory, int index, int x, int y, uint8_t tile, uint8_t attributes) {
+    uint8_t* entry = &memory[0xFE00 + index * 4];
+    entry[0] = static_cast<uint8_t>(y + 16);
+    entry[1] = static_cast<uint8_t>(x + 8);
+    entry[2] = tile;
+    entry[3] = attributes;
+}
+
+/**
+ * DMG memory with an identity BGP/OBP0, tile 1 solid color 3 and tile 0 blank
+ */
+std::vector<uint8_t> MakeDMGMemory() {
+    std::vector<uint8_t> memory(65536, 0);
+    SetSolidTile(&memory[0x8000], 1, 3);
+    memory[LCDC] = 0x91;
+    memory[BGP] = 0xE4;
+    memory[OBP0] = 0xE4;
+    memory[OBP1] = 0x1B;
+    memory[0xFF4B] = 7;
+    // Park every sprite off screen
+    for (int i = 0; i < 40; i++) {
+        SetSprite(memory, i, 0, -16, 0, 0);
+    }
+    return memory;
+}
+
+} // namespace
+
+void testBackground() {
+    std::cout << "Testing background scrolling..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    memory[0x9800] = 1;
+    FrameCompositor compositor;
+
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(0, 0) == 3 && compositor.GetPixel(7, 7) == 3);
+    assert(compositor.GetPixel(8, 0) == 0 && compositor.GetPixel(0, 8) == 0);
+
+    // Fine scroll, and wrapping past the right edge of the map
+    memory[SCX] = 4;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(3, 0) == 3 && compositor.GetPixel(4, 0) == 0);
+    memory[SCX] = 252;
+    memory[SCY] = 250;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(3, 6) == 0 && compositor.GetPixel(4, 6) == 3 && compositor.GetPixel(11, 13) == 3);
+    assert(compositor.GetPixel(4, 5) == 0 && compositor.GetPixel(12, 6) == 0);
+
+    // BGP remaps shades; LCDC bit 0 off blanks the BG on DMG
+    memory[SCX] = 0;
+    memory[SCY] = 0;
+    memory[BGP] = 0x1B;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(0, 0) == 0 && compositor.GetPixel(8, 0) == 3);
+    memory[LCDC] = 0x90;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(8, 0) == 0);
+
+    // LCD off
+    memory[LCDC] = 0x11;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::CGB);
+    assert(compositor.GetPixel(80, 80) == 0x7FFF);
+
+    std::cout << "  ✓ Background tests passed" << std::endl;
+}
+
+void testWindow() {
+    std::cout << "Testing window..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    for (int i = 0; i < 0x400; i++) {
+        memory[0x9C00 + i] = 1;
+    }
+    memory[LCDC] = 0x91 | 0x20 | 0x40;
+    memory[WY] = 100;
+    memory[WX] = 7 + 80;
+
+    FrameCompositor compositor;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(80, 100) == 3 && compositor.GetPixel(159, 143) == 3);
+    assert(compositor.GetPixel(79, 100) == 0 && compositor.GetPixel(80, 99) == 0);
+
+    // The window's rows follow its own counter, not LY
+    memory[0x9C00] = 0;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(80, 100) == 0 && compositor.GetPixel(80, 108) == 3);
+
+    std::cout << "  ✓ Window tests passed" << std::endl;
+}
+
+void testSprites() {
+    std::cout << "Testing sprite selection and priority..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    SetSolidTile(&memory[0x8000], 2, 1);
+    SetSolidTile(&memory[0x8000], 3, 2);
+    memory[LCDC] = 0x93;
+    memory[0x9800] = 1;
+
+    FrameCompositor compositor;
+
+    // OBP0 / OBP1 and BG priority over non-zero BG colors only
+    SetSprite(memory, 0, 20, 10, 2, 0x00);
+    SetSprite(memory, 1, 40, 10, 2, 0x10);
+    SetSprite(memory, 2, 4, 4, 2, 0x80);
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(20, 10) == 1 && compositor.GetPixel(27, 17) == 1);
+    assert(compositor.GetPixel(40, 10) == 2);
+    assert(compositor.GetPixel(7, 7) == 3 && compositor.GetPixel(8, 8) == 1);
+
+    // Overlap: DMG lets the lower X win, CGB the lower OAM index
+    SetSprite(memory, 0, 30, 30, 2, 0x00);
+    SetSprite(memory, 1, 26, 30, 3, 0x00);
+    SetSprite(memory, 2, 0, -16, 0, 0);
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(31, 30) == 2);
+    CGBPalette palettes[8];
+    palettes[0].colors[1] = 0x0011;
+    palettes[0].colors[2] = 0x0022;
+    compositor.Compose(memory.data(), nullptr, palettes, palettes, EmulationMode::CGB);
+    assert(compositor.GetPixel(31, 30) == 0x0011 && compositor.GetPixel(27, 30) == 0x0022);
+
+    // Ten sprites per line, picked in OAM order regardless of X
+    memory = MakeDMGMemory();
+    SetSolidTile(&memory[0x8000], 2, 1);
+    memory[LCDC] = 0x93;
+    for (int i = 0; i < 12; i++) {
+        SetSprite(memory, i, 150 - i * 12, 50, 2, 0x00);
+    }
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetSpriteCount(50) == 10 && compositor.GetSpriteCount(49) == 0);
+    assert(compositor.GetPixel(150 - 9 * 12, 50) == 1);
+    assert(compositor.GetPixel(150 - 10 * 12, 50) == 0 && compositor.GetPixel(150 - 11 * 12, 50) == 0);
+
+    // 8x16 sprites use an even/odd tile pair; Y flip swaps the halves
+    memory = MakeDMGMemory();
+    SetSolidTile(&memory[0x8000], 4, 1);
+    SetSolidTile(&memory[0x8000], 5, 2);
+    memory[LCDC] = 0x97;
+    SetSprite(memory, 0, 60, 60, 5, 0x00);
+    SetSprite(memory, 1, 80, 60, 4, 0x40);
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(60, 60) == 1 && compositor.GetPixel(60, 75) == 2);
+    assert(compositor.GetPixel(80, 60) == 2 && compositor.GetPixel(80, 75) == 1);
+
+    // Horizontal flip
+    memory[0x8000 + 4 * 16] = 0x80;   // Only the leftmost pixel of row 0
+    memory[0x8000 + 4 * 16 + 1] = 0x00;
+    SetSprite(memory, 0, 100, 100, 4, 0x20);
+    SetSprite(memory, 1, 0, -16, 0, 0);
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(107, 100) == 1 && compositor.GetPixel(100, 100) == 0);
+
+    std::cout << "  ✓ Sprite tests passed" << std::endl;
+}
+
+void testCGB() {
+    std::cout << "Testing CGB attributes and priority..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    std::vector<uint8_t> bank1(0x2000, 0);
+    SetSolidTile(&bank1[0], 1, 2);
+    SetSolidTile(&memory[0x8000], 2, 1);
+    memory[LCDC] = 0x93;
+    memory[0x9800] = 1;
+    memory[0x9801] = 1;
+    bank1[0x1800] = 0x02;            // Palette 2, bank 0
+    bank1[0x1801] = 0x08 | 0x80;     // Bank 1 tile data, BG priority
+
+    CGBPalette bg[8];
+    CGBPalette obj[8];
+    bg[2].colors[3] = 0x001F;
+    bg[0].colors[2] = 0x03E0;
+    obj[1].colors[1] = 0x7C00;
+
+    FrameCompositor compositor;
+    compositor.Compose(memory.data(), bank1.data(), bg, obj, EmulationMode::CGB);
+    assert(compositor.IsCGB());
+    assert(compositor.GetPixel(0, 0) == 0x001F);
+    assert(compositor.GetPixel(8, 0) == 0x03E0);
+
+    // Sprite over a plain cell shows; over a priority cell it is hidden
+    SetSprite(memory, 0, 4, 0, 2, 0x01);
+    compositor.Compose(memory.data(), bank1.data(), bg, obj, EmulationMode::CGB);
+    assert(compositor.GetPixel(4, 0) == 0x7C00);
+    assert(compositor.GetPixel(8, 0) == 0x03E0);
+
+    // LCDC bit 0 off on CGB: sprites always win, BG is still drawn
+    memory[LCDC] = 0x92;
+    compositor.Compose(memory.data(), bank1.data(), bg, obj, EmulationMode::CGB);
+    assert(compositor.GetPixel(8, 0) == 0x7C00 && compositor.GetPixel(12, 0) == 0x03E0);
+
+    std::cout << "  ✓ CGB tests passed" << std::endl;
+}
+
+void testScanlineSplit() {
+    std::cout << "Testing per-scanline registers..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    memory[0x9800 + 9 * 32] = 1;      // Map row 9 = screen lines 72-79 unscrolled
+
+    ScanlineTimeline timeline;
+    for (uint8_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+        ScanlineRegisters registers = ScanlineTimeline::ReadRegisters(memory.data());
+        if (ly >= 72) {
+            registers.scx = 8;        // Status bar scrolled by one tile
+        }
+        timeline.Record(ly, registers);
+    }
+    timeline.Latch();
+
+    FrameCompositor compositor;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+    assert(compositor.GetPixel(0, 72) == 3);
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG, &timeline);
+    assert(compositor.GetPixel(0, 72) == 0);
+
+    std::cout << "  ✓ Per-scanline register tests passed" << std::endl;
+}
+
+void testCompare() {
+    std::cout << "Testing framebuffer comparison..." << std::endl;
+
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    memory[0x9800] = 1;
+    FrameCompositor compositor;
+    compositor.Compose(memory.data(), nullptr, nullptr, nullptr, EmulationMode::DMG);
+
+    FrameCompositor::Frame reference = compositor.GetFrame();
+    assert(compositor.Compare(reference.data()) == 0);
+    assert(compositor.GetFirstMismatch() == -1);
+
+    // Bits above the shade are ignored on DMG
+    reference[5] |= 0x100;
+    reference[200] = 2;
+    reference[300 * 2] = 1;
+    assert(compositor.Compare(reference.data()) == 2);
+    assert(compositor.GetFirstMismatch() == 200);
+    assert(compositor.GetMismatches()[600] && !compositor.GetMismatches()[5]);
+
+    std::cout << "  ✓ Comparison tests passed" << std::endl;
+}
+
+void testPerformance() {
+    std::cout << "Testing compose time..." << std::endl;
+
+    // Busy scene: random VRAM, window, 40 8x16 sprites
+    std::vector<uint8_t> memory = MakeDMGMemory();
+    std::vector<uint8_t> bank1(0x2000);
+    std::srand(7);
+    for (int i = 0x8000; i < 0xA000; i++) {
+        memory[i] = static_cast<uint8_t>(std::rand());
+        bank1[i - 0x8000] = static_cast<uint8_t>(std::rand());
+    }
+    for (int i = 0; i < 40; i++) {
+        SetSprite(memory, i, std::rand() % 168 - 8, std::rand() % 160 - 16,
+                  static_cast<uint8_t>(std::rand()), static_cast<uint8_t>(std::rand()));
+    }
+    memory[LCDC] = 0xF7;
+    memory[WY] = 60;
+    memory[WX] = 50;
+    CGBPalette palettes[8];
+
+    FrameCompositor compositor;
+    const int frames = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        memory[SCX] = static_cast<uint8_t>(i);
+        compositor.Compose(memory.data(), bank1.data(), palettes, palettes, EmulationMode::CGB);
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << elapsed / frames << " us per frame" << std::endl;
+
+    std::cout << "  ✓ Compose time tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running frame compositor tests..." << std::endl;
+    std::cout << std::endl;
+
+    testBackground();
+    testWindow();
+    testSprites();
+    testCGB();
+    testScanlineSplit();
+    testCompare();
+    testPerformance();
+
+    std::cout << std::endl;
+    std::cout << "All frame compositor tests passed! ✓" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "../include/MemoryHeatmap.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+using namespace GBDebug;
+
+void testAges() {
+    std::cout << "Testing write ages..." << std::endl;
+    
+    MemoryHeatmap heatmap;
+    std::vector<uint8_t> memory(65536, 0);
+    
+    // The first observation is only a baseline
+    memory[0xC000] = 1;
+    heatmap.Observe(memory.data());
+    assert(heatmap.GetFrame() == 0);
+    assert(heatmap.GetAge(0xC000) == MemoryHeatmap::NEVER_CHANGED);
+    
+    memory[0xC010] = 5;
+    heatmap.Observe(memory.data());
+    assert(heatmap.GetFrame() == 1);
+    assert(heatmap.GetAge(0xC010) == 0);
+    assert(heatmap.GetAge(0xC000) == MemoryHeatmap::NEVER_CHANGED);
+    assert(heatmap.GetPageAge(0xC0) == 0);
+    assert(heatmap.GetPageAge(0xC1) == MemoryHeatmap::NEVER_CHANGED);
+    assert(heatmap.GetChangedPages().count() == 1);
+    
+    // Ages grow without the byte being touched
+    heatmap.Observe(memory.data());
+    heatmap.Observe(memory.data());
+    assert(heatmap.GetAge(0xC010) == 2);
+    assert(heatmap.GetPageAge(0xC0) == 2);
+    assert(heatmap.GetChangedPages().none());
+    
+    // Writing the same value is not a change
+    memory[0xC010] = 5;
+    heatmap.Observe(memory.data());
+    assert(heatmap.GetAge(0xC010) == 3);
+    assert(heatmap.GetChangeCount(0xC010) == 1);
+    
+    heatmap.Reset();
+    assert(heatmap.GetFrame() == 0);
+    assert(heatmap.GetAge(0xC010) == MemoryHeatmap::NEVER_CHANGED);
+    
+    std::cout << "  ✓ Write age tests passed" << std::endl;
+}
+
+void testPageSkipping() {
+    std::cout << "Testing page skipping..." << std::endl;
+    
+    MemoryHeatmap heatmap;
+    std::vector<uint8_t> memory(65536, 0);
+    heatmap.Observe(memory.data());
+    
+    // Every byte of a 16-byte chunk and both edges of the address space
+    for (int i = 0; i < 16; i++) {
+        memory[0x8010 + i] = static_cast<uint8_t>(i + 1);
+    }
+    memory[0x0000] = 1;
+    memory[0xFFFF] = 1;
+    heatmap.Observe(memory.data());
+    assert(heatmap.GetPagesScanned() == 3);
+    for (int i = 0; i < 16; i++) {
+        assert(heatmap.GetAge(static_cast<uint16_t>(0x8010 + i)) == 0);
+    }
+    assert(heatmap.GetAge(0x800F) == MemoryHeatmap::NEVER_CHANGED);
+    assert(heatmap.GetAge(0x8020) == MemoryHeatmap::NEVER_CHANGED);
+    assert(heatmap.GetAge(0x0000) == 0 && heatmap.GetAge(0xFFFF) == 0);
+    
+    // Quiet frames scan nothing
+    for (int frame = 0; frame < 10; frame++) {
+        heatmap.Observe(memory.data());
+    }
+    assert(heatmap.GetPagesScanned() == 3);
+    
+    std::cout << "  ✓ Page skipping tests passed" << std::endl;
+}
+
+void testRegionsAndHottest() {
+    std::cout << "Testing region rates and hottest bytes..." << std::endl;
+    
+    MemoryHeatmap heatmap;
+    std::vector<uint8_t> memory(65536, 0);
+    heatmap.Observe(memory.data());
+    
+    // $D123 every frame, $D200 every other frame, $FF44 (LY, a mixed page) every frame
+    for (int frame = 1; frame <= 10; frame++) {
+        memory[0xD123] = static_cast<uint8_t>(frame);
+        if (frame % 2 == 0) {
+            memory[0xD200] = static_cast<uint8_t>(frame);
+        }
+        memory[0xFF44] = static_cast<uint8_t>(frame);
+        heatmap.Observe(memory.data());
+    }
+    
+    const size_t WRAM_N = 5;
+    const size_t IO = 9;
+    const size_t HRAM = 10;
+    assert(MEMORY_REGIONS[WRAM_N].start == 0xD000);
+    assert(MEMORY_REGIONS[IO].start == 0xFF00);
+    assert(heatmap.GetRegionChanges(WRAM_N) == 2);
+    assert(heatmap.GetRegionRate(WRAM_N) == 1.5);
+    assert(heatmap.GetRegionChanges(IO) == 1);
+    assert(heatmap.GetRegionRate(IO) == 1.0);
+    assert(heatmap.GetRegionRate(HRAM) == 0.0);
+    
+    std::vector<uint16_t> hottest;
+    heatmap.GetHottest(hottest, 2);
+    assert(hottest.size() == 2);
+    assert(hottest[0] == 0xD123 && hottest[1] == 0xFF44);
+    heatmap.GetHottest(hottest, 10);
+    assert(hottest.size() == 3 && hottest[2] == 0xD200);
+    
+    std::cout << "  ✓ Region and hottest byte tests passed" << std::endl;
+}
+
+void benchmarkObserve() {
+    std::cout << "Benchmarking Observe()..." << std::endl;
+    
+    MemoryHeatmap heatmap;
+    std::vector<uint8_t> memory(65536, 0);
+    heatmap.Observe(memory.data());
+    
+    // A step that touches a few bytes, as when single-stepping
+    const int frames = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        memory[0xC000 + (frame & 0xFF)]++;
+        memory[0xFF44] = static_cast<uint8_t>(frame);
+        heatmap.Observe(memory.data());
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+    assert(heatmap.GetFrame() == static_cast<uint32_t>(frames));
+    std::cout << "  " << us / frames << " us per 64KB observation" << std::endl;
+}
+
+int main() {
+    std::cout << "Running memory heatmap tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testAges();
+    testPageSkipping();
+    testRegionsAndHottest();
+    benchmarkObserve();
+    
+    std::cout << std::endl;
+    std::cout << "All memory heatmap tests passed! ✓" << std::endl;
+    
+    return 0;
+}
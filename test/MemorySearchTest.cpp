@@ -0,0 +1,185 @@
+#include "../include/MemorySearch.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace GBDebug;
+
+void testPatterns() {
+    std::cout << "Testing pattern parsing..." << std::endl;
+    
+    MemorySearch search;
+    std::string error;
+    
+    assert(search.SetPattern(SearchMode::Bytes, "3E ?? EA", error));
+    assert(search.GetPatternLength() == 3);
+    assert(search.SetPattern(SearchMode::Bytes, "3e,00", error));
+    assert(search.SetPattern(SearchMode::Value8, "$C8", error));
+    assert(search.SetPattern(SearchMode::Value8, "200", error));
+    assert(search.SetPattern(SearchMode::Value16, "0x1234", error));
+    assert(search.GetPatternLength() == 2);
+    assert(search.SetPattern(SearchMode::Text, "POKEMON", error));
+    assert(search.GetPatternLength() == 7);
+    
+    assert(!search.SetPattern(SearchMode::Bytes, "3E G0", error) && !error.empty());
+    assert(!search.SetPattern(SearchMode::Bytes, "?? ??", error));
+    assert(!search.SetPattern(SearchMode::Bytes, "", error));
+    assert(!search.SetPattern(SearchMode::Value8, "256", error));
+    assert(!search.SetPattern(SearchMode::Value16, "0x10000", error));
+    assert(!search.SetPattern(SearchMode::Value8, "12abc", error));
+    
+    // A failed pattern keeps the previous one
+    assert(search.GetPatternLength() == 7);
+    
+    std::cout << "  ✓ Pattern parsing tests passed" << std::endl;
+}
+
+void testFind() {
+    std::cout << "Testing Find()..." << std::endl;
+    
+    MemorySearch search;
+    std::string error;
+    std::vector<uint8_t> memory(65536, 0);
+    std::vector<uint16_t> results;
+    
+    // LD A,n / LD (nn),A at chunk boundaries and at the very end
+    const uint8_t code[] = {0x3E, 0x05, 0xEA};
+    std::memcpy(&memory[0x0150], code, 3);
+    std::memcpy(&memory[0x400F], code, 3);
+    memory[0x4010] = 0x99;
+    std::memcpy(&memory[0xFFFD], code, 3);
+    
+    assert(search.SetPattern(SearchMode::Bytes, "3E ?? EA", error));
+    search.Find(memory.data(), results);
+    assert(results.size() == 3);
+    assert(results[0] == 0x0150 && results[1] == 0x400F && results[2] == 0xFFFD);
+    
+    // Leading wildcard: the anchor is the second byte
+    assert(search.SetPattern(SearchMode::Bytes, "?? 99 EA", error));
+    search.Find(memory.data(), results);
+    assert(results.size() == 1 && results[0] == 0x400F);
+    
+    // Little-endian word and text
+    memory[0xC100] = 0x34;
+    memory[0xC101] = 0x12;
+    assert(search.SetPattern(SearchMode::Value16, "0x1234", error));
+    search.Find(memory.data(), results);
+    assert(results.size() == 1 && results[0] == 0xC100);
+    
+    std::memcpy(&memory[0x0134], "TETRIS", 6);
+    assert(search.SetPattern(SearchMode::Text, "TETRIS", error));
+    search.Find(memory.data(), results);
+    assert(results.size() == 1 && results[0] == 0x0134);
+    
+    // Overlapping matches and a match at address 0
+    memory[0x0000] = 0xAA;
+    memory[0x0001] = 0xAA;
+    memory[0x0002] = 0xAA;
+    assert(search.SetPattern(SearchMode::Bytes, "AA AA", error));
+    search.Find(memory.data(), results);
+    assert(results.size() == 2 && results[0] == 0x0000 && results[1] == 0x0001);
+    
+    std::cout << "  ✓ Find() tests passed" << std::endl;
+}
+
+void testNarrowing() {
+    std::cout << "Testing cheat narrowing..." << std::endl;
+    
+    MemorySearch search;
+    std::vector<uint8_t> memory(65536, 0);
+    std::vector<uint16_t> candidates;
+    
+    assert(search.Narrow(memory.data(), NarrowMode::Changed) == 0);
+    
+    // Lives at $C0A0 go 3 -> 2 -> 2 -> 1; a timer at $C0A1 keeps counting
+    memory[0xC0A0] = 3;
+    search.StartNarrowing(memory.data());
+    assert(search.GetCandidateCount() == 65536);
+    
+    memory[0xC0A0] = 2;
+    memory[0xC0A1]++;
+    assert(search.Narrow(memory.data(), NarrowMode::Decreased) == 1);
+    
+    search.StartNarrowing(memory.data());
+    memory[0xC0A0] = 2;
+    memory[0xC0A1]++;
+    memory[0xFFFF] = 200;
+    size_t left = search.Narrow(memory.data(), NarrowMode::Changed);
+    assert(left == 2);
+    search.GetCandidates(candidates);
+    assert(candidates.size() == 2 && candidates[0] == 0xC0A1 && candidates[1] == 0xFFFF);
+    
+    search.StartNarrowing(memory.data());
+    assert(search.Narrow(memory.data(), NarrowMode::Unchanged) == 65536);
+    memory[0xC0A0] = 1;
+    memory[0xC0A1]++;
+    assert(search.Narrow(memory.data(), NarrowMode::Decreased) == 1);
+    assert(search.NarrowToValue(memory.data(), 1) == 1);
+    search.GetCandidates(candidates);
+    assert(candidates[0] == 0xC0A0);
+    assert(search.GetSnapshotValue(0xC0A0) == 1);
+    
+    // Unsigned compares: 0x80 -> 0x7F decreased, 0x7F -> 0xFF increased
+    search.StartNarrowing(memory.data());
+    memory[0xD000] = 0x80;
+    memory[0xD001] = 0x7F;
+    search.Narrow(memory.data(), NarrowMode::Changed);
+    memory[0xD000] = 0x7F;
+    memory[0xD001] = 0xFF;
+    assert(search.Narrow(memory.data(), NarrowMode::Increased) == 1);
+    search.GetCandidates(candidates);
+    assert(candidates[0] == 0xD001);
+    
+    search.ResetNarrowing();
+    assert(!search.IsNarrowing() && search.GetCandidateCount() == 0);
+    
+    std::cout << "  ✓ Cheat narrowing tests passed" << std::endl;
+}
+
+void benchmarkSearch() {
+    std::cout << "Benchmarking search and narrowing..." << std::endl;
+    
+    MemorySearch search;
+    std::string error;
+    std::vector<uint8_t> memory(65536);
+    for (size_t i = 0; i < memory.size(); i++) {
+        memory[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+    }
+    std::vector<uint16_t> results;
+    
+    const int iterations = 2000;
+    search.SetPattern(SearchMode::Bytes, "3E ?? EA", error);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        search.Find(memory.data(), results);
+    }
+    double findUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        search.StartNarrowing(memory.data());
+        search.Narrow(memory.data(), NarrowMode::Unchanged);
+    }
+    double narrowUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "  " << findUs / iterations << " us per 64KB pattern search, "
+              << narrowUs / iterations << " us per full narrowing step" << std::endl;
+}
+
+int main() {
+    std::cout << "Running memory search tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testPatterns();
+    testFind();
+    testNarrowing();
+    benchmarkSearch();
+    
+    std::cout << std::endl;
+    std::cout << "All memory search tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "../include/ScanlineTimeline.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+ScanlineRegisters MakeRegisters(uint8_t scx, uint8_t scy) {
+    ScanlineRegisters registers;
+    registers.lcdc = 0x91;
+    registers.bgp = 0xE4;
+    registers.scx = scx;
+    registers.scy = scy;
+    return registers;
+}
+
+} // namespace
+
+void testRecordAndLatch() {
+    std::cout << "Testing record and latch..." << std::endl;
+
+    ScanlineTimeline timeline;
+    assert(!timeline.HasFrame());
+    assert(!timeline.Latch());
+
+    // Nothing is shown until the frame is latched
+    for (uint8_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+        timeline.Record(ly, MakeRegisters(ly < 72 ? 0 : 40, 8));
+    }
+    assert(timeline.HasPending());
+    assert(!timeline.HasFrame());
+    uint64_t generation = timeline.GetGeneration();
+
+    assert(timeline.Latch());
+    assert(!timeline.HasPending());
+    assert(timeline.HasFrame());
+    assert(timeline.GetGeneration() != generation);
+    assert(timeline.GetLine(71).scx == 0);
+    assert(timeline.GetLine(72).scx == 40);
+    assert(timeline.GetLine(153).scy == 8);
+    assert(!timeline.IsUniform());
+
+    // Out-of-range lines are ignored
+    timeline.Record(154, MakeRegisters(99, 99));
+    timeline.Record(255, MakeRegisters(99, 99));
+    assert(!timeline.HasPending());
+
+    // Lines not recorded keep the previous frame's values
+    timeline.Record(10, MakeRegisters(7, 8));
+    assert(timeline.Latch());
+    assert(timeline.GetLine(10).scx == 7);
+    assert(timeline.GetLine(72).scx == 40);
+
+    std::cout << "  ✓ Record and latch tests passed" << std::endl;
+}
+
+void testUniform() {
+    std::cout << "Testing uniform frame detection..." << std::endl;
+
+    ScanlineTimeline::Frame frame;
+    for (size_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+        frame[ly] = MakeRegisters(16, 32);
+        frame[ly].stat = static_cast<uint8_t>(0x80 | (ly & 3));   // STAT does not count
+    }
+
+    // Changes during VBlank do not affect what was drawn
+    frame[150].scx = 0;
+    ScanlineTimeline timeline;
+    timeline.SetFrame(frame);
+    assert(timeline.HasFrame());
+    assert(timeline.IsUniform());
+
+    frame[100].wx = 7;
+    timeline.SetFrame(frame);
+    assert(!timeline.IsUniform());
+
+    timeline.Clear();
+    assert(!timeline.HasFrame());
+    assert(timeline.IsUniform());
+
+    std::cout << "  ✓ Uniform frame tests passed" << std::endl;
+}
+
+void testRegisters() {
+    std::cout << "Testing register access..." << std::endl;
+
+    std::vector<uint8_t> memory(65536, 0);
+    const uint16_t addresses[ScanlineTimeline::REGISTER_COUNT] = {
+        0xFF40, 0xFF41, 0xFF42, 0xFF43, 0xFF47, 0xFF48, 0xFF49, 0xFF4A, 0xFF4B
+    };
+    for (size_t i = 0; i < ScanlineTimeline::REGISTER_COUNT; i++) {
+        memory[addresses[i]] = static_cast<uint8_t>(0x10 + i);
+    }
+
+    ScanlineRegisters registers = ScanlineTimeline::ReadRegisters(memory.data());
+    assert(registers.lcdc == 0x10);
+    assert(registers.scx == 0x13);
+    assert(registers.wx == 0x18);
+    for (size_t i = 0; i < ScanlineTimeline::REGISTER_COUNT; i++) {
+        assert(ScanlineTimeline::GetRegister(registers, i) == 0x10 + i);
+    }
+    assert(std::string(ScanlineTimeline::GetRegisterName(3)) == "SCX");
+    assert(std::string(ScanlineTimeline::GetRegisterName(8)) == "WX");
+
+    std::cout << "  ✓ Register access tests passed" << std::endl;
+}
+
+void testRecordCost() {
+    std::cout << "Testing record cost..." << std::endl;
+
+    ScanlineTimeline timeline;
+    ScanlineRegisters registers = MakeRegisters(0, 0);
+    const int frames = 20000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (uint8_t ly = 0; ly < ScanlineTimeline::LINE_COUNT; ly++) {
+            registers.scx = static_cast<uint8_t>(frame + ly);
+            timeline.Record(ly, registers);
+        }
+        timeline.Latch();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    assert(timeline.GetLine(1).scx == static_cast<uint8_t>(frames - 1 + 1));
+
+    std::cout << "  " << elapsed / (frames * double(ScanlineTimeline::LINE_COUNT))
+              << " ns per recorded line (latch included)" << std::endl;
+    std::cout << "  ✓ Record cost tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running scanline timeline tests..." << std::endl;
+    std::cout << std::endl;
+
+    testRecordAndLatch();
+    testUniform();
+    testRegisters();
+    testRecordCost();
+
+    std::cout << std::endl;
+    std::cout << "All scanline timeline tests passed! ✓" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "../include/SpriteOccupancy.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <array>
+
+using namespace GBDebug;
+
+namespace {
+
+typedef std::array<uint8_t, SpriteOccupancy::OAM_SIZE> OAM;
+
+/**
+ * OAM with every entry hidden above the screen
+ */
+OAM EmptyOAM() {
+    OAM oam;
+    oam.fill(0);
+    return oam;
+}
+
+void SetSprite(OAM& oam, int index, int x, int y) {
+    oam[index * 4] = static_cast<uint8_t>(y + 16);
+    oam[index * 4 + 1] = static_cast<uint8_t>(x + 8);
+}
+
+bool Has(uint64_t mask, int entry) {
+    return ((mask >> entry) & 1) != 0;
+}
+
+} // namespace
+
+void testCoverage() {
+    std::cout << "Testing line coverage..." << std::endl;
+
+    OAM oam = EmptyOAM();
+    SetSprite(oam, 0, 10, 20);
+    SetSprite(oam, 1, 10, -4);      // Clipped at the top
+    SetSprite(oam, 2, 10, 140);     // Clipped at the bottom
+
+    SpriteOccupancy occupancy;
+    assert(occupancy.Analyze(oam.data(), 0x00, false));
+    assert(occupancy.GetSpriteHeight() == 8);
+    assert(!Has(occupancy.GetLine(19).covering, 0));
+    assert(Has(occupancy.GetLine(20).covering, 0));
+    assert(Has(occupancy.GetLine(27).covering, 0));
+    assert(!Has(occupancy.GetLine(28).covering, 0));
+    assert(Has(occupancy.GetLine(0).covering, 1));
+    assert(Has(occupancy.GetLine(3).covering, 1));
+    assert(!Has(occupancy.GetLine(4).covering, 1));
+    assert(Has(occupancy.GetLine(143).covering, 2));
+    assert(occupancy.GetLine(20).coveringCount == 1);
+    assert(occupancy.GetPeakCount() == 1);
+    std::cout << "  ✓ 8x8 coverage passed" << std::endl;
+
+    // LCDC bit 2 doubles the height
+    assert(occupancy.Analyze(oam.data(), 0x04, false));
+    assert(occupancy.GetSpriteHeight() == 16);
+    assert(Has(occupancy.GetLine(35).covering, 0));
+    assert(!Has(occupancy.GetLine(36).covering, 0));
+    assert(Has(occupancy.GetLine(11).covering, 1));
+    std::cout << "  ✓ 8x16 coverage passed" << std::endl;
+
+    // Unchanged input is skipped
+    assert(!occupancy.Analyze(oam.data(), 0x04, false));
+    occupancy.Invalidate();
+    assert(occupancy.Analyze(oam.data(), 0x04, false));
+    std::cout << "  ✓ Change detection passed" << std::endl;
+}
+
+void testSpriteLimit() {
+    std::cout << "Testing the 10-sprite limit..." << std::endl;
+
+    // Twelve sprites on lines 50-57, one more on lines 54-61
+    OAM oam = EmptyOAM();
+    for (int i = 0; i < 12; i++) {
+        SetSprite(oam, i, i * 8, 50);
+    }
+    SetSprite(oam, 12, 100, 54);
+
+    SpriteOccupancy occupancy;
+    occupancy.Analyze(oam.data(), 0x00, false);
+
+    const SpriteLine& line = occupancy.GetLine(50);
+    assert(line.coveringCount == 12);
+    assert(line.drawnCount == 10);
+    assert(Has(line.dropped, 10));
+    assert(Has(line.dropped, 11));
+    assert(!Has(line.dropped, 9));
+
+    const SpriteLine& shared = occupancy.GetLine(55);
+    assert(shared.coveringCount == 13);
+    assert(Has(shared.dropped, 12));
+
+    const SpriteLine& after = occupancy.GetLine(58);
+    assert(after.coveringCount == 1);
+    assert(after.dropped == 0);
+
+    assert(occupancy.GetOverflowLines() == 8);
+    assert(occupancy.GetPeakCount() == 13);
+    assert(Has(occupancy.GetDroppedSprites(), 10));
+    assert(Has(occupancy.GetDroppedSprites(), 12));
+    assert(!Has(occupancy.GetDroppedSprites(), 0));
+    std::cout << "  ✓ Dropped entries passed" << std::endl;
+
+    // Off-screen X still uses up a slot
+    OAM hidden = EmptyOAM();
+    for (int i = 0; i < 10; i++) {
+        SetSprite(hidden, i, -8, 30);
+    }
+    SetSprite(hidden, 10, 40, 30);
+    occupancy.Analyze(hidden.data(), 0x00, false);
+    assert(Has(occupancy.GetLine(30).dropped, 10));
+    std::cout << "  ✓ Off-screen entries passed" << std::endl;
+}
+
+void testPriority() {
+    std::cout << "Testing priority order..." << std::endl;
+
+    OAM oam = EmptyOAM();
+    SetSprite(oam, 0, 60, 10);
+    SetSprite(oam, 1, 20, 10);
+    SetSprite(oam, 2, 60, 10);
+    SetSprite(oam, 3, 5, 10);
+
+    SpriteOccupancy occupancy;
+    occupancy.Analyze(oam.data(), 0x00, false);
+    const SpriteLine& dmg = occupancy.GetLine(10);
+    assert(dmg.drawnCount == 4);
+    assert(dmg.order[0] == 3);
+    assert(dmg.order[1] == 1);
+    assert(dmg.order[2] == 0);      // X tie keeps OAM order
+    assert(dmg.order[3] == 2);
+    std::cout << "  ✓ DMG X priority passed" << std::endl;
+
+    // Mode change alone forces a new analysis
+    assert(occupancy.Analyze(oam.data(), 0x00, true));
+    const SpriteLine& cgb = occupancy.GetLine(10);
+    for (int i = 0; i < 4; i++) {
+        assert(cgb.order[i] == i);
+    }
+    std::cout << "  ✓ CGB OAM priority passed" << std::endl;
+}
+
+void testPerformance() {
+    std::cout << "Testing analysis time..." << std::endl;
+
+    // Every entry on screen, packed into the top half
+    OAM oam = EmptyOAM();
+    for (int i = 0; i < SpriteOccupancy::OAM_ENTRIES; i++) {
+        SetSprite(oam, i, (i * 37) % 168 - 8, (i * 7) % 64);
+    }
+
+    SpriteOccupancy occupancy;
+    const int iterations = 20000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        occupancy.Invalidate();
+        occupancy.Analyze(oam.data(), 0x04, false);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    std::cout << "  Full analysis: " << us << " us" << std::endl;
+    assert(occupancy.GetPeakCount() > SpriteLine::MAX_DRAWN);
+    std::cout << "  ✓ Analysis time tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running sprite occupancy tests..." << std::endl;
+    std::cout << std::endl;
+
+    testCoverage();
+    testSpriteLimit();
+    testPriority();
+    testPerformance();
+
+    std::cout << std::endl;
+    std::cout << "All sprite occupancy tests passed! ✓" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include "../include/StateHistory.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+const size_t FRAME_CYCLES = 70224;
+
+/**
+ * A small emulated machine whose state changes a little every frame
+ */
+struct FakeMachine {
+    std::vector<uint8_t> memory;
+    std::vector<uint8_t> vramBank1;
+    CGBPalette bgPalettes[8];
+    CGBPalette spritePalettes[8];
+    CPUState cpu;
+    uint32_t seed;
+    
+    FakeMachine() : memory(0x10000), vramBank1(0x2000), seed(12345) {
+        for (size_t i = 0; i < 0x8000; i++) {
+            memory[i] = static_cast<uint8_t>(i * 7 + (i >> 8));   // "ROM"
+        }
+    }
+    
+    uint32_t Next() {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+    
+    void RunFrame() {
+        cpu.cycle += FRAME_CYCLES;
+        cpu.pc = static_cast<uint16_t>(0x150 + (Next() & 0xFF));
+        cpu.af = static_cast<uint16_t>(Next());
+        
+        // A few WRAM/HRAM writes, a tile row and an occasional palette change
+        for (int i = 0; i < 40; i++) {
+            memory[0xC000 + (Next() & 0x1FFF)] = static_cast<uint8_t>(Next());
+        }
+        memory[0xFF80 + (Next() & 0x7F)] = static_cast<uint8_t>(Next());
+        uint32_t tile = Next() & 0x3FF;
+        for (int i = 0; i < 16; i++) {
+            memory[0x8000 + tile * 16 + i] = static_cast<uint8_t>(Next());
+        }
+        vramBank1[Next() & 0x1FFF] = static_cast<uint8_t>(Next());
+        if ((Next() & 15) == 0) {
+            bgPalettes[Next() & 7].colors[Next() & 3] = static_cast<uint16_t>(Next() & 0x7FFF);
+        }
+    }
+    
+    bool Capture(StateHistory& history) {
+        return history.Capture(cpu, memory.data(), vramBank1.data(), bgPalettes, spritePalettes);
+    }
+};
+
+struct Snapshot {
+    std::vector<uint8_t> memory;
+    std::vector<uint8_t> vramBank1;
+    CGBPalette bgPalettes[8];
+    uint64_t cycle;
+    uint16_t pc;
+};
+
+Snapshot TakeSnapshot(const FakeMachine& machine) {
+    Snapshot snapshot;
+    snapshot.memory = machine.memory;
+    snapshot.vramBank1 = machine.vramBank1;
+    std::memcpy(snapshot.bgPalettes, machine.bgPalettes, sizeof(snapshot.bgPalettes));
+    snapshot.cycle = machine.cpu.cycle;
+    snapshot.pc = machine.cpu.pc;
+    return snapshot;
+}
+
+void CheckMatches(const StateHistory& history, const Snapshot& snapshot) {
+    assert(history.GetCPU().cycle == snapshot.cycle);
+    assert(history.GetCPU().pc == snapshot.pc);
+    assert(std::memcmp(history.GetMemory(), snapshot.memory.data(), 0x10000) == 0);
+    assert(std::memcmp(history.GetVRAMBank1(), snapshot.vramBank1.data(), 0x2000) == 0);
+    
+    CGBPalette bg[8];
+    CGBPalette sprites[8];
+    history.CopyPalettes(bg, sprites);
+    assert(std::memcmp(bg, snapshot.bgPalettes, sizeof(bg)) == 0);
+}
+
+} // namespace
+
+void testDisabled() {
+    std::cout << "Testing disabled history..." << std::endl;
+    
+    StateHistory history;
+    FakeMachine machine;
+    assert(history.IsEnabled() == false);
+    assert(machine.Capture(history) == false);
+    assert(history.GetStepCount() == 0);
+    assert(history.SeekToCycle(0) == false);
+    
+    std::cout << "  ✓ Disabled history tests passed" << std::endl;
+}
+
+void testSeek() {
+    std::cout << "Testing seek in every direction..." << std::endl;
+    
+    StateHistory history;
+    history.SetBudget(64 * 1024 * 1024);
+    history.SetKeyframeInterval(20);
+    
+    FakeMachine machine;
+    std::vector<Snapshot> snapshots;
+    for (int frame = 0; frame < 100; frame++) {
+        machine.RunFrame();
+        assert(machine.Capture(history) == true);
+        snapshots.push_back(TakeSnapshot(machine));
+    }
+    assert(history.GetStepCount() == 100);
+    assert(history.GetKeyframeCount() == 5);
+    assert(history.GetOldestCycle() == snapshots.front().cycle);
+    assert(history.GetNewestCycle() == snapshots.back().cycle);
+    
+    // Deltas are far smaller than full images
+    assert(history.GetBytesUsed() < 100 * StateHistory::IMAGE_SIZE / 4);
+    
+    // Forward, backward within a keyframe group, across groups, random
+    const size_t order[] = {0, 1, 19, 20, 37, 33, 21, 20, 55, 99, 98, 60, 5, 0, 42, 42};
+    for (size_t step : order) {
+        assert(history.SeekToStep(step) == true);
+        assert(history.GetCursorStep() == step);
+        CheckMatches(history, snapshots[step]);
+    }
+    
+    // Seeking by cycle picks the newest step at or before it
+    assert(history.SeekToCycle(snapshots[10].cycle + 5) == true);
+    CheckMatches(history, snapshots[10]);
+    assert(history.SeekToCycle(snapshots[0].cycle - 1) == false);
+    assert(history.SeekToStep(100) == false);
+    
+    std::cout << "  ✓ Seek tests passed" << std::endl;
+}
+
+void testCaptureAfterSeek() {
+    std::cout << "Testing capture after a seek..." << std::endl;
+    
+    StateHistory history;
+    history.SetBudget(16 * 1024 * 1024);
+    history.SetKeyframeInterval(4);
+    
+    FakeMachine machine;
+    std::vector<Snapshot> snapshots;
+    for (int frame = 0; frame < 10; frame++) {
+        machine.RunFrame();
+        assert(machine.Capture(history) == true);
+        snapshots.push_back(TakeSnapshot(machine));
+    }
+    
+    // Recording the reconstructed state would put an old cycle last
+    assert(history.SeekToStep(3) == true);
+    std::vector<uint8_t> vramBank1(history.GetVRAMBank1(), history.GetVRAMBank1() + 0x2000);
+    assert(history.Capture(history.GetCPU(), history.GetMemory(), vramBank1.data(), nullptr, nullptr) == false);
+    assert(history.GetStepCount() == 10);
+    assert(history.GetNewestCycle() == snapshots.back().cycle);
+    
+    // Live frames carry on, and cycle lookups still land on the right step
+    machine.RunFrame();
+    assert(machine.Capture(history) == true);
+    snapshots.push_back(TakeSnapshot(machine));
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        assert(history.SeekToCycle(snapshots[i].cycle) == true);
+        CheckMatches(history, snapshots[i]);
+    }
+    
+    std::cout << "  ✓ Capture after seek tests passed" << std::endl;
+}
+
+void testEviction() {
+    std::cout << "Testing eviction at the budget..." << std::endl;
+    
+    StateHistory history;
+    history.SetBudget(512 * 1024);
+    history.SetKeyframeInterval(10);
+    
+    FakeMachine machine;
+    std::vector<Snapshot> snapshots;
+    for (int frame = 0; frame < 400; frame++) {
+        machine.RunFrame();
+        assert(machine.Capture(history) == true);
+        snapshots.push_back(TakeSnapshot(machine));
+        assert(history.GetBytesUsed() <= history.GetBudget());
+    }
+    
+    // Old steps were dropped a keyframe group at a time
+    size_t held = history.GetStepCount();
+    assert(held < 400 && held > 10);
+    assert(history.GetNewestCycle() == snapshots.back().cycle);
+    
+    size_t first = snapshots.size() - held;
+    assert(history.GetOldestCycle() == snapshots[first].cycle);
+    for (size_t step = 0; step < held; step += 7) {
+        assert(history.SeekToStep(step) == true);
+        CheckMatches(history, snapshots[first + step]);
+    }
+    
+    // A budget smaller than one keyframe holds nothing
+    StateHistory tiny;
+    tiny.SetBudget(1024);
+    machine.RunFrame();
+    assert(machine.Capture(tiny) == false);
+    assert(tiny.GetStepCount() == 0);
+    
+    std::cout << "  ✓ Eviction tests passed (" << held << " steps held)" << std::endl;
+}
+
+void testAlternatingImage() {
+    std::cout << "Testing worst-case page encoding..." << std::endl;
+    
+    StateHistory history;
+    history.SetBudget(4 * 1024 * 1024);
+    history.SetKeyframeInterval(4);
+    
+    // 01 00 01 00... everywhere: one literal and one run per two bytes
+    FakeMachine machine;
+    std::vector<Snapshot> snapshots;
+    for (int frame = 0; frame < 6; frame++) {
+        uint8_t value = static_cast<uint8_t>(frame + 1);
+        for (size_t i = 0; i < machine.memory.size(); i++) {
+            machine.memory[i] = (i & 1) ? 0 : value;
+        }
+        for (size_t i = 0; i < machine.vramBank1.size(); i++) {
+            machine.vramBank1[i] = (i & 1) ? value : 0;
+        }
+        machine.cpu.cycle += FRAME_CYCLES;
+        assert(machine.Capture(history) == true);
+        snapshots.push_back(TakeSnapshot(machine));
+    }
+    
+    for (size_t step = 0; step < snapshots.size(); step++) {
+        assert(history.SeekToStep(step) == true);
+        CheckMatches(history, snapshots[step]);
+    }
+    
+    std::cout << "  ✓ Worst-case encoding tests passed" << std::endl;
+}
+
+void benchmarkCapture() {
+    std::cout << "Benchmarking Capture()..." << std::endl;
+    
+    StateHistory history;
+    history.SetBudget(64 * 1024 * 1024);
+    FakeMachine machine;
+    
+    const int frames = 3600;
+    double captureNs = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        machine.RunFrame();
+        auto start = std::chrono::steady_clock::now();
+        machine.Capture(history);
+        captureNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    history.SeekToStep(history.GetStepCount() / 2 + 150);
+    double seekUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "  " << captureNs / frames / 1000.0 << " us per capture, "
+              << history.GetBytesUsed() / frames << " bytes per step, "
+              << seekUs << " us worst-case seek" << std::endl;
+}
+
+int main() {
+    std::cout << "Running state history tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testDisabled();
+    testSeek();
+    testCaptureAfterSeek();
+    testEviction();
+    testAlternatingImage();
+    benchmarkCapture();
+    
+    std::cout << std::endl;
+    std::cout << "All state history tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "../include/TileDecoder.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace GBDebug;
+
+void testDecodeTileRowExhaustive() {
+    std::cout << "Testing DecodeTileRow() against DecodePixel()..." << std::endl;
+    
+    TileDecoder decoder;
+    uint8_t tileData[16] = {0};
+    uint8_t row[8];
+    
+    // Every (LSB, MSB) combination must match the per-pixel reference
+    for (int lsb = 0; lsb < 256; lsb++) {
+        for (int msb = 0; msb < 256; msb++) {
+            tileData[0] = static_cast<uint8_t>(lsb);
+            tileData[1] = static_cast<uint8_t>(msb);
+            TileDecoder::DecodeTileRow(tileData[0], tileData[1], row);
+            for (int x = 0; x < 8; x++) {
+                assert(row[x] == decoder.DecodePixel(tileData, x, 0));
+            }
+        }
+    }
+    
+    std::cout << "  ✓ DecodeTileRow() tests passed" << std::endl;
+}
+
+void testDecodeTileMatchesReference() {
+    std::cout << "Testing DecodeTile() against DecodeTileReference()..." << std::endl;
+    
+    TileDecoder decoder;
+    std::vector<uint8_t> vram(8192);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < vram.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        vram[i] = static_cast<uint8_t>(seed >> 24);
+    }
+    
+    for (uint16_t tile = 0; tile < 512; tile++) {
+        auto fast = decoder.DecodeTile(vram.data(), tile);
+        auto reference = decoder.DecodeTileReference(vram.data(), tile);
+        assert(fast == reference);
+    }
+    
+    // Known pattern: LSB=0x3C, MSB=0x7E -> 0 2 3 3 3 3 2 0
+    vram[0] = 0x3C;
+    vram[1] = 0x7E;
+    auto pixels = decoder.DecodeTile(vram.data(), 0);
+    const uint8_t expected[8] = {0, 2, 3, 3, 3, 3, 2, 0};
+    for (int x = 0; x < 8; x++) {
+        assert(pixels[0][x] == expected[x]);
+    }
+    
+    std::cout << "  ✓ DecodeTile() tests passed" << std::endl;
+}
+
+void testDecodeTilesBatch() {
+    std::cout << "Testing DecodeTiles() batch decode..." << std::endl;
+    
+    TileDecoder decoder;
+    std::vector<uint8_t> vram(8192);
+    for (size_t i = 0; i < vram.size(); i++) {
+        vram[i] = static_cast<uint8_t>((i * 37) ^ (i >> 3));
+    }
+    
+    // All 384 tiles of the tile data area in one pass
+    std::vector<uint8_t> out(384 * 64);
+    decoder.DecodeTiles(vram.data(), 0, 384, out.data());
+    for (uint16_t tile = 0; tile < 384; tile++) {
+        auto reference = decoder.DecodeTileReference(vram.data(), tile);
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 8; x++) {
+                assert(out[tile * 64 + y * 8 + x] == reference[y][x]);
+            }
+        }
+    }
+    
+    // Partial run starting at a non-zero tile
+    std::vector<uint8_t> partial(10 * 64);
+    decoder.DecodeTiles(vram.data(), 100, 10, partial.data());
+    for (int i = 0; i < 10 * 64; i++) {
+        assert(partial[i] == out[100 * 64 + i]);
+    }
+    
+    std::cout << "  ✓ DecodeTiles() tests passed" << std::endl;
+}
+
+void testDecodeTileFlipped() {
+    std::cout << "Testing DecodeTileFlipped() against DecodePixel()..." << std::endl;
+    
+    TileDecoder decoder;
+    std::vector<uint8_t> vram(8192);
+    uint32_t seed = 0x9E3779B9;
+    for (size_t i = 0; i < vram.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        vram[i] = static_cast<uint8_t>(seed >> 24);
+    }
+    
+    for (int value = 0; value < 256; value++) {
+        uint8_t reversed = TileDecoder::ReverseBits(static_cast<uint8_t>(value));
+        for (int bit = 0; bit < 8; bit++) {
+            assert(((value >> bit) & 1) == ((reversed >> (7 - bit)) & 1));
+        }
+    }
+    
+    // Every flip combination for every tile
+    for (int flips = 0; flips < 4; flips++) {
+        bool hFlip = (flips & 1) != 0;
+        bool vFlip = (flips & 2) != 0;
+        for (uint16_t tile = 0; tile < 512; tile++) {
+            auto pixels = decoder.DecodeTileFlipped(vram.data(), tile, hFlip, vFlip);
+            const uint8_t* tileData = vram.data() + tile * 16;
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    assert(pixels[y][x] == decoder.DecodePixel(tileData, x, y, hFlip, vFlip));
+                }
+            }
+        }
+    }
+    
+    // No flips is the plain decode
+    assert(decoder.DecodeTileFlipped(vram.data(), 7, false, false) == decoder.DecodeTile(vram.data(), 7));
+    
+    std::cout << "  ✓ DecodeTileFlipped() tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running tile decoder tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testDecodeTileRowExhaustive();
+    testDecodeTileMatchesReference();
+    testDecodeTilesBatch();
+    testDecodeTileFlipped();
+    
+    std::cout << std::endl;
+    std::cout << "All tile decoder tests passed! ✓" << std::endl;
+    
+    return 0;
+}
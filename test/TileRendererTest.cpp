@@ -0,0 +1,211 @@
+#include "../include/TileRenderer.h"
+#include "../include/TileDecoder.h"
+#include "../include/SpriteParser.h"
+#include "../include/SpriteOccupancy.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+using namespace GBDebug;
+
+// ============================================================================
+// Headless GL
+// ============================================================================
+// The renderer's texture entry points, defined here so the test binary runs
+// without a context. Uploads are folded into a checksum so the measured
+// work is observable.
+
+static GLuint g_nextTexture = 1;
+static uint32_t g_uploadChecksum = 0;
+static size_t g_uploadCount = 0;
+
+extern "C" {
+
+void APIENTRY glGenTextures(GLsizei n, GLuint* textures) {
+    for (GLsizei i = 0; i < n; i++) {
+        textures[i] = g_nextTexture++;
+    }
+}
+
+void APIENTRY glDeleteTextures(GLsizei, const GLuint*) {}
+void APIENTRY glBindTexture(GLenum, GLuint) {}
+void APIENTRY glTexParameteri(GLenum, GLenum, GLint) {}
+
+void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint,
+                           GLenum, GLenum, const GLvoid*) {}
+
+void APIENTRY glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height,
+                              GLenum format, GLenum, const GLvoid* pixels) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(pixels);
+    size_t size = static_cast<size_t>(width) * height * (format == GL_RGBA ? 4 : 1);
+    for (size_t i = 0; i < size; i++) {
+        g_uploadChecksum = g_uploadChecksum * 31 + bytes[i];
+    }
+    g_uploadCount++;
+}
+
+} // extern "C"
+
+// Count every heap allocation made by the process
+static size_t g_allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    g_allocationCount++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+static Palette MakeTestPalette() {
+    Palette palette;
+    palette.colors[0] = TileColor(255, 255, 255, 255);
+    palette.colors[1] = TileColor(192, 128, 64, 255);
+    palette.colors[2] = TileColor(96, 32, 16, 200);
+    palette.colors[3] = TileColor(0, 0, 0, 255);
+    return palette;
+}
+
+void testConvertToRGBA() {
+    std::cout << "Testing ConvertToRGBA() output..." << std::endl;
+    
+    Palette palette = MakeTestPalette();
+    std::array<std::array<uint8_t, 8>, 8> pixels;
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 8; x++) {
+            pixels[y][x] = static_cast<uint8_t>((x + y * 3) & 3);
+        }
+    }
+    pixels[7][7] = 9;  // Out of range index clamps to color 3
+    
+    const int scales[] = {1, 2, 3, 4, 8};
+    for (int scale : scales) {
+        int size = 8 * scale;
+        std::vector<uint8_t> rgba(size * size * 4, 0xCD);
+        TileRenderer::ConvertToRGBA(pixels, palette, scale, rgba.data());
+        
+        for (int oy = 0; oy < size; oy++) {
+            for (int ox = 0; ox < size; ox++) {
+                uint8_t index = pixels[oy / scale][ox / scale];
+                if (index > 3) {
+                    index = 3;
+                }
+                const TileColor& expected = palette.colors[index];
+                const uint8_t* px = &rgba[(oy * size + ox) * 4];
+                assert(px[0] == expected.r);
+                assert(px[1] == expected.g);
+                assert(px[2] == expected.b);
+                assert(px[3] == expected.a);
+            }
+        }
+    }
+    
+    std::cout << "  ✓ ConvertToRGBA() tests passed" << std::endl;
+}
+
+void testSteadyStateFrameAllocations() {
+    std::cout << "Testing steady-state frame heap allocations..." << std::endl;
+    
+    // One VRAM viewer frame through the renderer's public entry points: the
+    // tile atlas, the Sprite View (parse, occupancy, 40 flipped 8x16 sprites)
+    // and the inspector
+    TileDecoder decoder;
+    TileRenderer renderer;
+    SpriteParser parser;
+    SpriteParser::SpriteTable sprites;
+    SpriteOccupancy occupancy;
+    Palette palette = MakeTestPalette();
+    
+    std::vector<uint8_t> vram(8192);
+    for (size_t i = 0; i < vram.size(); i++) {
+        vram[i] = static_cast<uint8_t>(i * 7);
+    }
+    std::vector<uint8_t> oam(SpriteParser::OAM_SIZE);
+    for (size_t i = 0; i < oam.size(); i++) {
+        oam[i] = static_cast<uint8_t>(i * 13 + 16);
+    }
+    
+    renderer.InitializeTileAtlas(16, 24);
+    renderer.InitializeSpritePool(40, 4);
+    renderer.InitializeInspectorPool(8);
+    
+    unsigned int textureSum = 0;
+    auto renderFrame = [&]() {
+        for (int tile = 0; tile < 384; tile++) {
+            auto pixels = decoder.DecodeTile(vram.data(), static_cast<uint16_t>(tile));
+            renderer.RenderTileToAtlas(tile, pixels, palette);
+        }
+        textureSum += renderer.UploadTileAtlas();
+        
+        parser.ParseOAM(oam.data(), oam.size(), sprites);
+        occupancy.Invalidate();
+        occupancy.Analyze(oam.data(), 0x04, false);
+        for (int i = 0; i < 40; i++) {
+            const SpriteAttributes& sprite = sprites[i];
+            uint16_t tile = sprite.tileIndex & 0xFE;
+            for (int half = 0; half < 2; half++) {
+                auto pixels = decoder.DecodeTileFlipped(vram.data(), tile + half, sprite.xFlip, sprite.yFlip);
+                textureSum += renderer.RenderSpriteAt(i, pixels, palette, half != 0);
+            }
+        }
+        
+        auto pixels = decoder.DecodeTile(vram.data(), 0);
+        textureSum += renderer.RenderInspectorTile(pixels, palette);
+    };
+    
+    renderFrame();  // Warm-up
+    uint32_t frameChecksum = g_uploadChecksum;
+    size_t frameUploads = g_uploadCount;
+    
+    size_t before = g_allocationCount;
+    for (int frame = 0; frame < 10; frame++) {
+        renderFrame();
+    }
+    size_t allocations = g_allocationCount - before;
+    
+    std::cout << "  Allocations over 10 frames: " << allocations << std::endl;
+    assert(allocations == 0);
+    
+    // Every frame uploaded the atlas, 80 sprite halves and the inspector
+    assert(frameUploads == 1 + 80 + 1);
+    assert(g_uploadCount == frameUploads * 11);
+    assert(frameChecksum != 0 && g_uploadChecksum != frameChecksum);
+    assert(textureSum != 0);
+    
+    std::cout << "  ✓ Zero-allocation frame tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running tile renderer tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testConvertToRGBA();
+    testSteadyStateFrameAllocations();
+    
+    std::cout << std::endl;
+    std::cout << "All tile renderer tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "../include/TilemapComposer.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+const size_t MAP_9800 = 0x1800;
+const size_t MAP_9C00 = 0x1C00;
+
+/**
+ * Fill a tile so that every row is color (lsb, msb) = (row bit pattern)
+ */
+void SetTileRow(std::vector<uint8_t>& vram, int tile, int row, uint8_t lsb, uint8_t msb) {
+    vram[tile * 16 + row * 2] = lsb;
+    vram[tile * 16 + row * 2 + 1] = msb;
+}
+
+} // namespace
+
+void testAddressing() {
+    std::cout << "Testing tile data addressing..." << std::endl;
+    
+    assert(TilemapComposer::ResolveTile(0x00, true) == 0);
+    assert(TilemapComposer::ResolveTile(0xFF, true) == 255);
+    assert(TilemapComposer::ResolveTile(0x00, false) == 256);
+    assert(TilemapComposer::ResolveTile(0x7F, false) == 383);
+    assert(TilemapComposer::ResolveTile(0x80, false) == 128);
+    assert(TilemapComposer::ResolveTile(0xFF, false) == 255);
+    
+    TilemapComposer composer;
+    std::vector<uint8_t> vram(0x2000, 0);
+    vram[MAP_9800 + 5] = 0x10;
+    
+    // First update draws every cell
+    assert(composer.Update(vram.data(), nullptr, 0x91, false) == 1024);
+    assert(composer.GetCell(5).tile == 0x10);
+    composer.ClearDirty();
+    
+    // Switching LCDC bit 4 re-resolves every cell
+    assert(composer.Update(vram.data(), nullptr, 0x81, false) == 1024);
+    assert(composer.GetCell(5).tile == 256 + 0x10);
+    assert(composer.GetCell(0).tile == 256);
+    
+    std::cout << "  ✓ Addressing tests passed" << std::endl;
+}
+
+void testDirtyCells() {
+    std::cout << "Testing dirty cell tracking..." << std::endl;
+    
+    TilemapComposer composer;
+    std::vector<uint8_t> vram(0x2000, 0);
+    vram[MAP_9800 + 0] = 1;
+    vram[MAP_9800 + 40] = 1;
+    vram[MAP_9800 + 100] = 2;
+    composer.Update(vram.data(), nullptr, 0x91, false);
+    composer.ClearDirty();
+    
+    // Nothing changed: nothing to draw
+    assert(composer.Update(vram.data(), nullptr, 0x91, false) == 0);
+    
+    // A tile byte change dirties exactly the cells showing that tile
+    SetTileRow(vram, 1, 3, 0xFF, 0x00);
+    assert(composer.Update(vram.data(), nullptr, 0x91, false) == 2);
+    assert(composer.GetDirtyCells()[0] && composer.GetDirtyCells()[40]);
+    assert(!composer.GetDirtyCells()[100]);
+    composer.ClearDirty();
+    
+    // A map entry change dirties that cell only
+    vram[MAP_9800 + 100] = 1;
+    assert(composer.Update(vram.data(), nullptr, 0x91, false) == 1);
+    assert(composer.GetDirtyCells()[100]);
+    composer.ClearDirty();
+    
+    // Tile data used by no cell and the other map are ignored
+    SetTileRow(vram, 7, 0, 0x01, 0x01);
+    vram[MAP_9C00 + 3] = 9;
+    assert(composer.Update(vram.data(), nullptr, 0x91, false) == 0);
+    
+    // Dirty cells accumulate until cleared
+    SetTileRow(vram, 2, 0, 0x01, 0x01);
+    vram[MAP_9800 + 200] = 2;
+    composer.Update(vram.data(), nullptr, 0x91, false);
+    vram[MAP_9800 + 201] = 2;
+    composer.Update(vram.data(), nullptr, 0x91, false);
+    assert(composer.GetDirtyCells().count() == 2);
+    composer.ClearDirty();
+    
+    // Switching maps and invalidating redraw everything
+    assert(composer.Update(vram.data(), nullptr, 0x91, true) == 1024);
+    assert(composer.GetCell(3).tile == 9);
+    composer.ClearDirty();
+    composer.Invalidate();
+    assert(composer.GetDirtyCells().count() == 1024);
+    
+    std::cout << "  ✓ Dirty cell tests passed" << std::endl;
+}
+
+void testAttributes() {
+    std::cout << "Testing CGB attributes..." << std::endl;
+    
+    TilemapComposer composer;
+    std::vector<uint8_t> vram0(0x2000, 0);
+    std::vector<uint8_t> vram1(0x2000, 0);
+    
+    // Tile 4 in bank 1: row 0 = colors 3,0,0,0,0,0,0,1, other rows 0
+    SetTileRow(vram1, 4, 0, 0x81, 0x80);
+    vram0[MAP_9800 + 10] = 4;
+    vram1[MAP_9800 + 10] = 0x08 | 0x05;   // bank 1, palette 5
+    composer.Update(vram0.data(), vram1.data(), 0x91, false);
+    
+    const TilemapCell& cell = composer.GetCell(10);
+    assert(cell.tile == 4 && cell.bank == 1 && cell.palette == 5);
+    assert(!cell.hFlip && !cell.vFlip && !cell.priority);
+    
+    TilemapComposer::CellPixels pixels;
+    composer.DecodeCell(10, pixels);
+    assert(pixels[0][0] == 3 && pixels[0][7] == 1 && pixels[0][1] == 0 && pixels[7][0] == 0);
+    composer.ClearDirty();
+    
+    // Flips and priority: an attribute change alone dirties the cell
+    vram1[MAP_9800 + 10] = 0x08 | 0x20 | 0x40 | 0x80;
+    assert(composer.Update(vram0.data(), vram1.data(), 0x91, false) == 1);
+    assert(composer.GetCell(10).hFlip && composer.GetCell(10).vFlip && composer.GetCell(10).priority);
+    composer.DecodeCell(10, pixels);
+    assert(pixels[7][7] == 3 && pixels[7][0] == 1 && pixels[0][0] == 0);
+    composer.ClearDirty();
+    
+    // Bank 1 tile data changes reach cells using bank 1, not bank 0 cells
+    vram0[MAP_9800 + 11] = 4;
+    composer.Update(vram0.data(), vram1.data(), 0x91, false);
+    composer.ClearDirty();
+    SetTileRow(vram1, 4, 5, 0xFF, 0xFF);
+    assert(composer.Update(vram0.data(), vram1.data(), 0x91, false) == 1);
+    assert(composer.GetDirtyCells()[10] && !composer.GetDirtyCells()[11]);
+    
+    std::cout << "  ✓ Attribute tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running tilemap composer tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testAddressing();
+    testDirtyCells();
+    testAttributes();
+    
+    std::cout << std::endl;
+    std::cout << "All tilemap composer tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "../include/TraceFile.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GBDebug;
+
+namespace {
+
+const char* const TRACE_PATH = "TraceFileTest.gbtrace";
+
+/**
+ * Deterministic pseudo-program: mostly fall-through, some jumps, sparse
+ * register changes and an IME toggle now and then
+ */
+TraceFileRecord MakeRecord(uint64_t i) {
+    TraceFileRecord record;
+    uint32_t mix = static_cast<uint32_t>(i * 2654435761u);
+    record.opcode = static_cast<uint8_t>(mix >> 24);
+    record.state.cycle = 1000 + i * 4 + (mix & 3);
+    record.state.pc = static_cast<uint16_t>(0x150 + (i % 300) * 2);
+    record.state.af = static_cast<uint16_t>((i / 3) << 4);
+    record.state.bc = static_cast<uint16_t>(i / 7);
+    record.state.de = 0xD000;
+    record.state.hl = static_cast<uint16_t>(0xC000 + (i / 2));
+    record.state.sp = static_cast<uint16_t>(0xFFFE - (i / 1000) * 2);
+    record.state.ime = (i / 5000) % 2 == 1;
+    return record;
+}
+
+bool SameRecord(const TraceFileRecord& a, const TraceFileRecord& b) {
+    return a.opcode == b.opcode && a.state.cycle == b.state.cycle && a.state.pc == b.state.pc &&
+           a.state.sp == b.state.sp && a.state.af == b.state.af && a.state.bc == b.state.bc &&
+           a.state.de == b.state.de && a.state.hl == b.state.hl && a.state.ime == b.state.ime;
+}
+
+} // namespace
+
+void testRoundTrip() {
+    std::cout << "Testing trace file round trip..." << std::endl;
+    
+    // Several full blocks plus a partial one
+    const uint64_t count = TraceFileWriter::BLOCK_RECORDS * 3 + 1234;
+    
+    TraceFileWriter writer;
+    std::string error;
+    assert(writer.Open(TRACE_PATH, error));
+    for (uint64_t i = 0; i < count; i++) {
+        TraceFileRecord record = MakeRecord(i);
+        writer.Append(record.state, record.opcode);
+    }
+    assert(writer.Close());
+    assert(writer.GetRecordsWritten() == count);
+    
+    double bytesPerRecord = static_cast<double>(writer.GetBytesWritten()) / count;
+    std::cout << "  " << bytesPerRecord << " bytes per record" << std::endl;
+    assert(bytesPerRecord < 8.0);
+    
+    TraceFileReader reader;
+    assert(reader.Open(TRACE_PATH, error));
+    assert(reader.GetRecordCount() == count);
+    assert(reader.GetBlockCount() == 4);
+    
+    TraceFileRecord record;
+    for (uint64_t i = 0; i < count; i++) {
+        assert(reader.ReadRecord(i, record));
+        assert(SameRecord(record, MakeRecord(i)));
+    }
+    assert(!reader.ReadRecord(count, record));
+    
+    // Random access goes backwards too
+    assert(reader.ReadRecord(5, record) && SameRecord(record, MakeRecord(5)));
+    
+    std::cout << "  ✓ Round trip tests passed" << std::endl;
+}
+
+void testFindCycle() {
+    std::cout << "Testing lookup by cycle..." << std::endl;
+    
+    TraceFileReader reader;
+    std::string error;
+    assert(reader.Open(TRACE_PATH, error));
+    
+    assert(reader.FindCycle(0) == 0);
+    
+    uint64_t targets[] = {5, 65535, 65536, 100000, 197000};
+    for (uint64_t target : targets) {
+        uint64_t cycle = MakeRecord(target).state.cycle;
+        uint64_t index = reader.FindCycle(cycle);
+        TraceFileRecord record;
+        assert(reader.ReadRecord(index, record));
+        assert(record.state.cycle >= cycle);
+        if (index > 0) {
+            assert(reader.ReadRecord(index - 1, record));
+            assert(record.state.cycle < cycle);
+        }
+    }
+    
+    assert(reader.FindCycle(UINT64_MAX) == reader.GetRecordCount());
+    
+    std::cout << "  ✓ Cycle lookup tests passed" << std::endl;
+}
+
+void testTruncatedFile() {
+    std::cout << "Testing truncated and invalid files..." << std::endl;
+    
+    // Chop the file in the middle of the last block
+    std::FILE* file = std::fopen(TRACE_PATH, "rb");
+    assert(file != nullptr);
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        bytes.insert(bytes.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+    
+    file = std::fopen(TRACE_PATH, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size() - 100, file);
+    std::fclose(file);
+    
+    TraceFileReader reader;
+    std::string error;
+    assert(reader.Open(TRACE_PATH, error));
+    assert(reader.GetBlockCount() == 3);
+    assert(reader.GetRecordCount() == TraceFileWriter::BLOCK_RECORDS * 3);
+    
+    // Not a trace file
+    file = std::fopen(TRACE_PATH, "wb");
+    std::fputs("hello, world", file);
+    std::fclose(file);
+    assert(!reader.Open(TRACE_PATH, error));
+    assert(!error.empty());
+    
+    std::remove(TRACE_PATH);
+    assert(!reader.Open(TRACE_PATH, error));
+    
+    std::cout << "  ✓ Truncated file tests passed" << std::endl;
+}
+
+void testConcurrentClose() {
+    std::cout << "Testing open and close while appending..." << std::endl;
+    
+    TraceFileWriter writer;
+    std::atomic<bool> running(true);
+    
+    // The emulator thread appends through open and closed periods alike
+    std::thread producer([&]() {
+        uint64_t i = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            TraceFileRecord record = MakeRecord(i++);
+            writer.Append(record.state, record.opcode);
+        }
+    });
+    
+    std::string error;
+    for (int round = 0; round < 20; round++) {
+        assert(writer.Open(TRACE_PATH, error));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        assert(writer.Close());
+        assert(!writer.IsOpen());
+        
+        TraceFileReader reader;
+        assert(reader.Open(TRACE_PATH, error));
+        assert(reader.GetRecordCount() == writer.GetRecordsWritten());
+    }
+    
+    running.store(false, std::memory_order_relaxed);
+    producer.join();
+    
+    // Appending while closed is ignored (current_ is null here)
+    TraceFileRecord record = MakeRecord(0);
+    writer.Append(record.state, record.opcode);
+    assert(!writer.IsOpen());
+    
+    std::remove(TRACE_PATH);
+    std::cout << "  ✓ Concurrent close tests passed" << std::endl;
+}
+
+void benchmarkAppend() {
+    std::cout << "Benchmarking Append()..." << std::endl;
+    
+    TraceFileWriter writer;
+    std::string error;
+    assert(writer.Open(TRACE_PATH, error));
+    
+    const uint64_t count = 20000000;
+    TraceFileRecord record = MakeRecord(0);
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; i++) {
+        record.state.cycle += 4;
+        record.state.pc = static_cast<uint16_t>(0x150 + (i & 0xFF));
+        record.state.hl = static_cast<uint16_t>(i >> 3);
+        writer.Append(record.state, 0x00);
+    }
+    assert(writer.Close());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / count;
+    
+    std::cout << "  " << ns << " ns per record including flush, "
+              << static_cast<double>(writer.GetBytesWritten()) / count << " bytes per record" << std::endl;
+    std::remove(TRACE_PATH);
+}
+
+int main() {
+    std::cout << "Running trace file tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testRoundTrip();
+    testFindCycle();
+    testTruncatedFile();
+    testConcurrentClose();
+    benchmarkAppend();
+    
+    std::cout << std::endl;
+    std::cout << "All trace file tests passed! ✓" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "../include/WatchpointManager.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace GBDebug;
+
+Watchpoint MakeWatch(uint16_t start, uint16_t end, WatchType type,
+                     WatchCondition condition = WatchCondition::Always, uint8_t value = 0) {
+    Watchpoint watch;
+    watch.start = start;
+    watch.end = end;
+    watch.type = type;
+    watch.condition = condition;
+    watch.value = value;
+    return watch;
+}
+
+void testPageFilter() {
+    std::cout << "Testing watchpoint page filter..." << std::endl;
+    
+    WatchpointManager watches;
+    
+    // No watches: every access is rejected
+    for (uint32_t addr = 0; addr < 65536; addr += 7) {
+        assert(watches.MayHit(static_cast<uint16_t>(addr), false) == false);
+        assert(watches.MayHit(static_cast<uint16_t>(addr), true) == false);
+    }
+    
+    // A write watch only flags writes in its page
+    watches.Add(MakeWatch(0xC010, 0xC010, WatchType::Write));
+    assert(watches.MayHit(0xC0FF, true) == true);
+    assert(watches.MayHit(0xC0FF, false) == false);
+    assert(watches.MayHit(0xC100, true) == false);
+    
+    // Same page, different address: passes the filter, rejected by Check
+    assert(watches.Check(0xC011, 0x00, true) == false);
+    assert(watches.Check(0xC010, 0x00, true) == true);
+    
+    // Ranges spanning pages flag every page they touch
+    watches.Add(MakeWatch(0x80F0, 0x8210, WatchType::Read));
+    assert(watches.MayHit(0x8000, false) == true);
+    assert(watches.MayHit(0x8100, false) == true);
+    assert(watches.MayHit(0x8200, false) == true);
+    assert(watches.MayHit(0x8300, false) == false);
+    
+    std::cout << "  ✓ Page filter tests passed" << std::endl;
+}
+
+void testConditions() {
+    std::cout << "Testing watchpoint conditions..." << std::endl;
+    
+    WatchpointManager watches;
+    watches.Add(MakeWatch(0xFF40, 0xFF40, WatchType::Access, WatchCondition::ValueEquals, 0x91));
+    assert(watches.Check(0xFF40, 0x80, true) == false);
+    assert(watches.Check(0xFF40, 0x91, true) == true);
+    assert(watches.Check(0xFF40, 0x91, false) == true);
+    
+    // Value changed: the first access only records the value
+    watches.Clear();
+    watches.Add(MakeWatch(0xC000, 0xC0FF, WatchType::Write, WatchCondition::ValueChanged));
+    assert(watches.Check(0xC080, 0x10, true) == false);
+    assert(watches.Check(0xC080, 0x10, true) == false);
+    assert(watches.Check(0xC080, 0x11, true) == true);
+    assert(watches.Check(0xC081, 0x11, true) == false);
+    
+    WatchHit hit;
+    assert(watches.GetLastHit(hit) == watches.GetHitSequence());
+    assert(hit.address == 0xC080 && hit.value == 0x11 && hit.isWrite);
+    
+    // Re-adding after Clear() forgets values seen by the deleted watch
+    watches.Clear();
+    watches.Add(MakeWatch(0xC000, 0xC0FF, WatchType::Write, WatchCondition::ValueChanged));
+    assert(watches.Check(0xC080, 0x22, true) == false);
+    assert(watches.Check(0xC080, 0x22, true) == false);
+    assert(watches.Check(0xC080, 0x23, true) == true);
+    
+    // Seeded from memory: the very first change fires
+    std::vector<uint8_t> memory(65536, 0);
+    memory[0xD000] = 0x40;
+    watches.Clear();
+    watches.Add(MakeWatch(0xD000, 0xD001, WatchType::Write, WatchCondition::ValueChanged), memory.data());
+    assert(watches.Check(0xD000, 0x40, true) == false);
+    assert(watches.Check(0xD000, 0x41, true) == true);
+    assert(watches.Check(0xD001, 0x07, true) == true);
+    
+    std::cout << "  ✓ Condition tests passed" << std::endl;
+}
+
+void testEditing() {
+    std::cout << "Testing watchpoint editing..." << std::endl;
+    
+    WatchpointManager watches;
+    
+    // Reversed ranges are normalized
+    watches.Add(MakeWatch(0xD010, 0xD000, WatchType::Write));
+    std::vector<Watchpoint> entries;
+    watches.CopyWatchpoints(entries);
+    assert(entries.size() == 1);
+    assert(entries[0].start == 0xD000 && entries[0].end == 0xD010);
+    
+    watches.SetEnabled(0, false);
+    assert(watches.MayHit(0xD005, true) == false);
+    watches.SetEnabled(0, true);
+    assert(watches.Check(0xD005, 1, true) == true);
+    
+    watches.CopyWatchpoints(entries);
+    assert(entries[0].hitCount == 1);
+    
+    watches.RemoveAt(0);
+    assert(watches.MayHit(0xD005, true) == false);
+    
+    std::cout << "  ✓ Editing tests passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running watchpoint manager tests..." << std::endl;
+    std::cout << std::endl;
+    
+    testPageFilter();
+    testConditions();
+    testEditing();
+    
+    std::cout << std::endl;
+    std::cout << "All watchpoint manager tests passed! ✓" << std::endl;
+    
+    return 0;
+}